@@ -0,0 +1,96 @@
+#pragma once
+
+#include <grpcpp/support/status_code_enum.h>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Behavior of the fake control plane
+ */
+struct FakeControlPlaneOptions {
+  /**
+   * @brief Latency added to every call
+   */
+  std::chrono::microseconds rpc_latency{0};
+
+  /**
+   * @brief Time between the submission of a task and the completion of its output
+   */
+  std::chrono::microseconds task_duration{0};
+
+  /**
+   * @brief Time between the scheduling of the submitted tasks and the reply of SubmitTasks, during which the shorter
+   * tasks complete before the client knows their ids
+   */
+  std::chrono::microseconds submit_reply_delay{0};
+
+  /**
+   * @brief Size of the output of a task, in bytes
+   */
+  std::size_t output_size = 8;
+
+  /**
+   * @brief Maximum size of the data chunks advertised by the Results service
+   */
+  std::size_t data_chunk_max_size = 84 * 1024;
+
+  /**
+   * @brief Whether the result status updates are streamed by the Events service, otherwise the clients have to poll
+   */
+  bool events = true;
+};
+
+/**
+ * @brief In-process gRPC server standing in for the ArmoniK control plane
+ *
+ * @details
+ * Implements the calls of the Sessions, Results, Tasks and Events services made by the SessionService submission,
+ * wait and cleanup paths, the other calls answer UNIMPLEMENTED. Data is not stored: only the sizes are kept, and
+ * downloads return filler bytes. Each task completes its output task_duration after its submission, regardless of its
+ * dependencies.
+ */
+class FakeControlPlane {
+public:
+  /**
+   * @brief Start the server on a free local port
+   * @param options Behavior of the server
+   */
+  explicit FakeControlPlane(FakeControlPlaneOptions options = {});
+
+  FakeControlPlane(const FakeControlPlane &) = delete;
+  FakeControlPlane &operator=(const FakeControlPlane &) = delete;
+
+  /**
+   * @brief Stop the server
+   */
+  ~FakeControlPlane();
+
+  /**
+   * @brief Endpoint to use as GrpcClient__Endpoint
+   */
+  const std::string &Endpoint() const { return endpoint_; }
+
+  /**
+   * @brief Largest number of tasks submitted by a single SubmitTasks call
+   */
+  std::size_t MaxSubmitBatch() const;
+
+  /**
+   * @brief Largest number of alternative filters of a single ListResults call, which is the number of results listed
+   * by id when waiting
+   */
+  std::size_t MaxListBatch() const;
+
+  /**
+   * @brief Make the ListResults calls fail with the given status code, OK making them succeed again
+   */
+  void FailResultListings(grpc::StatusCode code);
+
+private:
+  class Impl;
+
+  std::unique_ptr<Impl> impl_;
+  std::string endpoint_;
+};
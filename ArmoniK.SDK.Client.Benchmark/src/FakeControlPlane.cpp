@@ -0,0 +1,709 @@
+#include "FakeControlPlane.h"
+
+#include <armonik/client/events_service.grpc.pb.h>
+#include <armonik/client/results_service.grpc.pb.h>
+#include <armonik/client/sessions_service.grpc.pb.h>
+#include <armonik/client/tasks_service.grpc.pb.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace results = armonik::api::grpc::v1::results;
+namespace tasks = armonik::api::grpc::v1::tasks;
+namespace sessions = armonik::api::grpc::v1::sessions;
+namespace events = armonik::api::grpc::v1::events;
+using armonik::api::grpc::v1::result_status::RESULT_STATUS_COMPLETED;
+using armonik::api::grpc::v1::result_status::RESULT_STATUS_CREATED;
+using armonik::api::grpc::v1::result_status::RESULT_STATUS_DELETED;
+using armonik::api::grpc::v1::result_status::ResultStatus;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Current date since the epoch
+ */
+std::chrono::nanoseconds now_date() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch());
+}
+
+void set_date(google::protobuf::Timestamp &timestamp, std::chrono::nanoseconds date) {
+  timestamp.set_seconds(std::chrono::duration_cast<std::chrono::seconds>(date).count());
+  timestamp.set_nanos(static_cast<std::int32_t>((date % std::chrono::seconds(1)).count()));
+}
+
+std::chrono::nanoseconds get_date(const google::protobuf::Timestamp &timestamp) {
+  return std::chrono::seconds(timestamp.seconds()) + std::chrono::nanoseconds(timestamp.nanos());
+}
+
+/**
+ * @brief Stored result, without its data
+ */
+struct Result {
+  std::string session_id;
+  std::string name;
+  std::string owner_task_id;
+  ResultStatus status = RESULT_STATUS_CREATED;
+  std::chrono::nanoseconds created_at{0};
+  std::chrono::nanoseconds completed_at{0};
+  std::size_t size = 0;
+};
+
+using ResultEntry = std::pair<const std::string, Result>;
+
+/**
+ * @brief Stored task, without its options
+ */
+struct Task {
+  std::string session_id;
+  std::string payload_id;
+  std::vector<std::string> data_dependencies;
+  std::vector<std::string> expected_output_ids;
+  std::chrono::nanoseconds created_at{0};
+};
+
+void to_raw(const ResultEntry &entry, results::ResultRaw &raw) {
+  raw.set_result_id(entry.first);
+  raw.set_session_id(entry.second.session_id);
+  raw.set_name(entry.second.name);
+  raw.set_owner_task_id(entry.second.owner_task_id);
+  raw.set_status(entry.second.status);
+  raw.set_size(static_cast<std::int64_t>(entry.second.size));
+  set_date(*raw.mutable_created_at(), entry.second.created_at);
+  if (entry.second.status == RESULT_STATUS_COMPLETED) {
+    set_date(*raw.mutable_completed_at(), entry.second.completed_at);
+  }
+}
+
+bool matches(const std::string &value, const armonik::api::grpc::v1::FilterString &filter) {
+  switch (filter.operator_()) {
+  case armonik::api::grpc::v1::FILTER_STRING_OPERATOR_EQUAL:
+    return value == filter.value();
+  case armonik::api::grpc::v1::FILTER_STRING_OPERATOR_NOT_EQUAL:
+    return value != filter.value();
+  default:
+    throw std::invalid_argument("Unsupported string filter operator");
+  }
+}
+
+bool matches(ResultStatus value, const results::FilterStatus &filter) {
+  switch (filter.operator_()) {
+  case armonik::api::grpc::v1::FILTER_STATUS_OPERATOR_EQUAL:
+    return value == filter.value();
+  case armonik::api::grpc::v1::FILTER_STATUS_OPERATOR_NOT_EQUAL:
+    return value != filter.value();
+  default:
+    throw std::invalid_argument("Unsupported status filter operator");
+  }
+}
+
+bool matches(std::chrono::nanoseconds value, const armonik::api::grpc::v1::FilterDate &filter) {
+  const auto date = get_date(filter.value());
+  switch (filter.operator_()) {
+  case armonik::api::grpc::v1::FILTER_DATE_OPERATOR_EQUAL:
+    return value == date;
+  case armonik::api::grpc::v1::FILTER_DATE_OPERATOR_NOT_EQUAL:
+    return value != date;
+  case armonik::api::grpc::v1::FILTER_DATE_OPERATOR_BEFORE:
+    return value < date;
+  case armonik::api::grpc::v1::FILTER_DATE_OPERATOR_BEFORE_OR_EQUAL:
+    return value <= date;
+  case armonik::api::grpc::v1::FILTER_DATE_OPERATOR_AFTER_OR_EQUAL:
+    return value >= date;
+  case armonik::api::grpc::v1::FILTER_DATE_OPERATOR_AFTER:
+    return value > date;
+  default:
+    throw std::invalid_argument("Unsupported date filter operator");
+  }
+}
+
+bool matches(const ResultEntry &entry, const results::FilterField &filter) {
+  const auto &result = entry.second;
+  switch (filter.field().result_raw_field().field()) {
+  case results::RESULT_RAW_ENUM_FIELD_RESULT_ID:
+    return matches(entry.first, filter.filter_string());
+  case results::RESULT_RAW_ENUM_FIELD_SESSION_ID:
+    return matches(result.session_id, filter.filter_string());
+  case results::RESULT_RAW_ENUM_FIELD_NAME:
+    return matches(result.name, filter.filter_string());
+  case results::RESULT_RAW_ENUM_FIELD_STATUS:
+    return matches(result.status, filter.filter_status());
+  case results::RESULT_RAW_ENUM_FIELD_CREATED_AT:
+    return matches(result.created_at, filter.filter_date());
+  case results::RESULT_RAW_ENUM_FIELD_COMPLETED_AT:
+    // An unset date matches no condition
+    return result.status == RESULT_STATUS_COMPLETED && matches(result.completed_at, filter.filter_date());
+  default:
+    throw std::invalid_argument("Unsupported filter field");
+  }
+}
+
+bool matches(const ResultEntry &entry, const results::Filters &filters) {
+  if (filters.or__size() == 0) {
+    return true;
+  }
+  return std::any_of(filters.or_().begin(), filters.or_().end(), [&](const results::FiltersAnd &conjunction) {
+    return std::all_of(conjunction.and_().begin(), conjunction.and_().end(),
+                       [&](const results::FilterField &filter) { return matches(entry, filter); });
+  });
+}
+
+/**
+ * @brief Find a condition of a conjunction on the given field with the given string or date operator
+ * @return The condition, or null if there is none
+ */
+const results::FilterField *find_condition(const results::FiltersAnd &conjunction, results::ResultRawEnumField field,
+                                           int string_operator, int date_operator = -1) {
+  for (const auto &filter : conjunction.and_()) {
+    if (filter.field().result_raw_field().field() != field) {
+      continue;
+    }
+    if ((filter.has_filter_string() && filter.filter_string().operator_() == string_operator) ||
+        (filter.has_filter_date() && filter.filter_date().operator_() == date_operator)) {
+      return &filter;
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Scheduled completion of a task output
+ */
+struct Completion {
+  Clock::time_point at;
+  std::string result_id;
+
+  bool operator>(const Completion &other) const { return at > other.at; }
+};
+
+/**
+ * @brief Pending result status updates of an events stream
+ */
+struct Subscriber {
+  std::string session_id;
+  std::deque<std::pair<std::string, ResultStatus>> updates;
+};
+} // namespace
+
+class FakeControlPlane::Impl {
+public:
+  explicit Impl(FakeControlPlaneOptions options) : options(options) {
+    completer = std::thread([this]() { RunCompletions(); });
+  }
+
+  ~Impl() {
+    {
+      std::lock_guard<std::mutex> _(mutex);
+      stopped = true;
+    }
+    changed.notify_all();
+    if (server) {
+      server->Shutdown(std::chrono::system_clock::now() + std::chrono::seconds(1));
+    }
+    completer.join();
+  }
+
+  class SessionsService final : public sessions::Sessions::Service {
+  public:
+    explicit SessionsService(Impl &impl) : impl_(impl) {}
+
+    grpc::Status CreateSession(grpc::ServerContext *, const sessions::CreateSessionRequest *,
+                               sessions::CreateSessionReply *response) override {
+      impl_.Latency();
+      std::lock_guard<std::mutex> _(impl_.mutex);
+      response->set_session_id(impl_.NewId("session-"));
+      return grpc::Status::OK;
+    }
+
+  private:
+    Impl &impl_;
+  };
+
+  class TasksService final : public tasks::Tasks::Service {
+  public:
+    explicit TasksService(Impl &impl) : impl_(impl) {}
+
+    grpc::Status SubmitTasks(grpc::ServerContext *, const tasks::SubmitTasksRequest *request,
+                             tasks::SubmitTasksResponse *response) override {
+      impl_.Latency();
+      const auto completion = Clock::now() + impl_.options.task_duration;
+      std::unique_lock<std::mutex> lock(impl_.mutex);
+      impl_.max_submit_batch = std::max<std::size_t>(impl_.max_submit_batch, request->task_creations_size());
+      for (const auto &creation : request->task_creations()) {
+        auto task_id = impl_.NewId("task-");
+        for (const auto &output_id : creation.expected_output_keys()) {
+          auto it = impl_.results.find(output_id);
+          if (it == impl_.results.end()) {
+            return {grpc::StatusCode::NOT_FOUND, "Unknown result " + output_id};
+          }
+          it->second.owner_task_id = task_id;
+          impl_.scheduled.push({completion, output_id});
+        }
+        auto &task = impl_.tasks[task_id];
+        task.session_id = request->session_id();
+        task.payload_id = creation.payload_id();
+        task.data_dependencies.assign(creation.data_dependencies().begin(), creation.data_dependencies().end());
+        task.expected_output_ids.assign(creation.expected_output_keys().begin(), creation.expected_output_keys().end());
+        task.created_at = now_date();
+        auto info = response->add_task_infos();
+        info->set_task_id(std::move(task_id));
+        info->set_payload_id(creation.payload_id());
+        *info->mutable_expected_output_ids() = creation.expected_output_keys();
+        *info->mutable_data_dependencies() = creation.data_dependencies();
+      }
+      impl_.changed.notify_all();
+      lock.unlock();
+      if (impl_.options.submit_reply_delay.count() > 0) {
+        std::this_thread::sleep_for(impl_.options.submit_reply_delay);
+      }
+      return grpc::Status::OK;
+    }
+
+    grpc::Status GetTask(grpc::ServerContext *, const tasks::GetTaskRequest *request,
+                         tasks::GetTaskResponse *response) override {
+      impl_.Latency();
+      std::lock_guard<std::mutex> _(impl_.mutex);
+      auto it = impl_.tasks.find(request->task_id());
+      if (it == impl_.tasks.end()) {
+        return {grpc::StatusCode::NOT_FOUND, "Unknown task " + request->task_id()};
+      }
+      const auto &task = it->second;
+      auto &detailed = *response->mutable_task();
+      detailed.set_id(it->first);
+      detailed.set_session_id(task.session_id);
+      detailed.set_payload_id(task.payload_id);
+      *detailed.mutable_data_dependencies() = {task.data_dependencies.begin(), task.data_dependencies.end()};
+      *detailed.mutable_expected_output_ids() = {task.expected_output_ids.begin(), task.expected_output_ids.end()};
+      set_date(*detailed.mutable_created_at(), task.created_at);
+
+      // A task is completed once all its outputs are
+      const bool completed = std::all_of(task.expected_output_ids.begin(), task.expected_output_ids.end(),
+                                         [&](const std::string &output_id) {
+                                           auto output = impl_.results.find(output_id);
+                                           return output != impl_.results.end() &&
+                                                  output->second.status != RESULT_STATUS_CREATED;
+                                         });
+      detailed.set_status(completed ? armonik::api::grpc::v1::task_status::TASK_STATUS_COMPLETED
+                                    : armonik::api::grpc::v1::task_status::TASK_STATUS_SUBMITTED);
+      detailed.mutable_output()->set_success(completed);
+      return grpc::Status::OK;
+    }
+
+  private:
+    Impl &impl_;
+  };
+
+  class ResultsService final : public results::Results::Service {
+  public:
+    explicit ResultsService(Impl &impl) : impl_(impl) {}
+
+    grpc::Status GetServiceConfiguration(grpc::ServerContext *, const armonik::api::grpc::v1::Empty *,
+                                         results::ResultsServiceConfigurationResponse *response) override {
+      impl_.Latency();
+      response->set_data_chunk_max_size(static_cast<std::int32_t>(impl_.options.data_chunk_max_size));
+      return grpc::Status::OK;
+    }
+
+    grpc::Status CreateResultsMetaData(grpc::ServerContext *, const results::CreateResultsMetaDataRequest *request,
+                                       results::CreateResultsMetaDataResponse *response) override {
+      impl_.Latency();
+      std::lock_guard<std::mutex> _(impl_.mutex);
+      for (const auto &create : request->results()) {
+        to_raw(impl_.NewResult(request->session_id(), create.name()), *response->add_results());
+      }
+      return grpc::Status::OK;
+    }
+
+    grpc::Status CreateResults(grpc::ServerContext *, const results::CreateResultsRequest *request,
+                               results::CreateResultsResponse *response) override {
+      impl_.Latency();
+      std::lock_guard<std::mutex> _(impl_.mutex);
+      for (const auto &create : request->results()) {
+        auto &entry = impl_.NewResult(request->session_id(), create.name());
+        entry.second.size = create.data().size();
+        impl_.Complete(entry);
+        to_raw(entry, *response->add_results());
+      }
+      return grpc::Status::OK;
+    }
+
+    grpc::Status UploadResultData(grpc::ServerContext *, grpc::ServerReader<results::UploadResultDataRequest> *reader,
+                                  results::UploadResultDataResponse *response) override {
+      impl_.Latency();
+      results::UploadResultDataRequest request;
+      if (!reader->Read(&request) || !request.has_id()) {
+        return {grpc::StatusCode::INVALID_ARGUMENT, "The upload must start with the result identifier"};
+      }
+      const auto result_id = request.id().result_id();
+      std::size_t size = 0;
+      while (reader->Read(&request)) {
+        size += request.data_chunk().size();
+      }
+
+      std::lock_guard<std::mutex> _(impl_.mutex);
+      auto it = impl_.results.find(result_id);
+      if (it == impl_.results.end()) {
+        return {grpc::StatusCode::NOT_FOUND, "Unknown result " + result_id};
+      }
+      it->second.size = size;
+      impl_.Complete(*it);
+      to_raw(*it, *response->mutable_result());
+      return grpc::Status::OK;
+    }
+
+    grpc::Status DownloadResultData(grpc::ServerContext *, const results::DownloadResultDataRequest *request,
+                                    grpc::ServerWriter<results::DownloadResultDataResponse> *writer) override {
+      impl_.Latency();
+      std::size_t size = 0;
+      {
+        std::lock_guard<std::mutex> _(impl_.mutex);
+        auto it = impl_.results.find(request->result_id());
+        if (it == impl_.results.end()) {
+          return {grpc::StatusCode::NOT_FOUND, "Unknown result " + request->result_id()};
+        }
+        if (it->second.status != RESULT_STATUS_COMPLETED) {
+          return {grpc::StatusCode::FAILED_PRECONDITION, "Result " + request->result_id() + " is not completed"};
+        }
+        size = it->second.size;
+      }
+
+      results::DownloadResultDataResponse response;
+      response.mutable_data_chunk()->assign(std::min(size, impl_.options.data_chunk_max_size), 'r');
+      while (size > 0) {
+        if (size < response.data_chunk().size()) {
+          response.mutable_data_chunk()->resize(size);
+        }
+        size -= response.data_chunk().size();
+        if (!writer->Write(response)) {
+          break;
+        }
+      }
+      return grpc::Status::OK;
+    }
+
+    grpc::Status DeleteResultsData(grpc::ServerContext *, const results::DeleteResultsDataRequest *request,
+                                   results::DeleteResultsDataResponse *response) override {
+      impl_.Latency();
+      std::lock_guard<std::mutex> _(impl_.mutex);
+      for (const auto &result_id : request->result_id()) {
+        auto it = impl_.results.find(result_id);
+        if (it == impl_.results.end() || it->second.session_id != request->session_id()) {
+          return {grpc::StatusCode::NOT_FOUND, "Unknown result " + result_id};
+        }
+      }
+      // Only the data is deleted, the result is still listed
+      for (const auto &result_id : request->result_id()) {
+        auto &result = impl_.results[result_id];
+        result.status = RESULT_STATUS_DELETED;
+        result.size = 0;
+      }
+      response->set_session_id(request->session_id());
+      *response->mutable_result_id() = request->result_id();
+      return grpc::Status::OK;
+    }
+
+    grpc::Status ListResults(grpc::ServerContext *, const results::ListResultsRequest *request,
+                             results::ListResultsResponse *response) override {
+      impl_.Latency();
+      std::lock_guard<std::mutex> _(impl_.mutex);
+      if (impl_.list_results_error != grpc::StatusCode::OK) {
+        return {impl_.list_results_error, "Listing failure requested by the test"};
+      }
+      impl_.max_list_batch = std::max<std::size_t>(impl_.max_list_batch, request->filters().or__size());
+      std::vector<const ResultEntry *> listed;
+      try {
+        for (const auto *entry : impl_.Candidates(request->filters())) {
+          if (matches(*entry, request->filters())) {
+            listed.push_back(entry);
+          }
+        }
+      } catch (const std::invalid_argument &e) {
+        return {grpc::StatusCode::INVALID_ARGUMENT, e.what()};
+      }
+
+      Sort(listed, request->sort());
+
+      const auto page_size = static_cast<std::size_t>(std::max(request->page_size(), 0));
+      const auto begin = std::min(static_cast<std::size_t>(std::max(request->page(), 0)) * page_size, listed.size());
+      const auto end = std::min(begin + page_size, listed.size());
+      for (auto i = begin; i < end; ++i) {
+        to_raw(*listed[i], *response->add_results());
+      }
+      response->set_page(request->page());
+      response->set_page_size(request->page_size());
+      response->set_total(static_cast<std::int32_t>(listed.size()));
+      return grpc::Status::OK;
+    }
+
+  private:
+    static void Sort(std::vector<const ResultEntry *> &listed, const results::ListResultsRequest::Sort &sort) {
+      const bool descending = sort.direction() == armonik::api::grpc::v1::sort_direction::SORT_DIRECTION_DESC;
+      auto by = [&](auto key) {
+        std::stable_sort(listed.begin(), listed.end(), [&](const ResultEntry *a, const ResultEntry *b) {
+          return descending ? key(*b) < key(*a) : key(*a) < key(*b);
+        });
+      };
+      switch (sort.field().result_raw_field().field()) {
+      case results::RESULT_RAW_ENUM_FIELD_RESULT_ID:
+        by([](const ResultEntry &entry) { return entry.first; });
+        break;
+      case results::RESULT_RAW_ENUM_FIELD_CREATED_AT:
+        by([](const ResultEntry &entry) { return entry.second.created_at; });
+        break;
+      case results::RESULT_RAW_ENUM_FIELD_COMPLETED_AT:
+        by([](const ResultEntry &entry) { return entry.second.completed_at; });
+        break;
+      default:
+        break;
+      }
+    }
+
+    Impl &impl_;
+  };
+
+  class EventsService final : public events::Events::Service {
+  public:
+    explicit EventsService(Impl &impl) : impl_(impl) {}
+
+    grpc::Status GetEvents(grpc::ServerContext *context, const events::EventSubscriptionRequest *request,
+                           grpc::ServerWriter<events::EventSubscriptionResponse> *writer) override {
+      if (!impl_.options.events) {
+        return {grpc::StatusCode::UNIMPLEMENTED, "Events are disabled"};
+      }
+      impl_.Latency();
+
+      Subscriber subscriber{request->session_id(), {}};
+      {
+        std::lock_guard<std::mutex> _(impl_.mutex);
+        impl_.subscribers.push_back(&subscriber);
+      }
+      // Acknowledge the subscription, the updates being recorded from now on
+      writer->SendInitialMetadata();
+      bool connected = true;
+      std::unique_lock<std::mutex> lock(impl_.mutex);
+      while (connected && !impl_.stopped && !context->IsCancelled()) {
+        if (subscriber.updates.empty()) {
+          // Bounded wait to notice the cancellation of the stream
+          impl_.changed.wait_for(lock, std::chrono::milliseconds(50));
+          continue;
+        }
+        std::deque<std::pair<std::string, ResultStatus>> updates;
+        updates.swap(subscriber.updates);
+        lock.unlock();
+        events::EventSubscriptionResponse response;
+        response.set_session_id(subscriber.session_id);
+        for (auto &update : updates) {
+          response.mutable_result_status_update()->set_result_id(std::move(update.first));
+          response.mutable_result_status_update()->set_status(update.second);
+          if (!writer->Write(response)) {
+            connected = false;
+            break;
+          }
+        }
+        lock.lock();
+      }
+      impl_.subscribers.erase(std::find(impl_.subscribers.begin(), impl_.subscribers.end(), &subscriber));
+      return grpc::Status::OK;
+    }
+
+  private:
+    Impl &impl_;
+  };
+
+  /**
+   * @brief Simulate the latency of a call
+   */
+  void Latency() const {
+    if (options.rpc_latency.count() > 0) {
+      std::this_thread::sleep_for(options.rpc_latency);
+    }
+  }
+
+  /**
+   * @brief Generate a new id, with the mutex held
+   */
+  std::string NewId(const char *prefix) { return prefix + std::to_string(++last_id); }
+
+  /**
+   * @brief Create a result, with the mutex held
+   */
+  ResultEntry &NewResult(const std::string &session_id, const std::string &name) {
+    Result result;
+    result.session_id = session_id;
+    result.name = name;
+    result.created_at = now_date();
+    return *results.emplace(NewId("result-"), std::move(result)).first;
+  }
+
+  /**
+   * @brief Complete a result, with the mutex held
+   */
+  void Complete(ResultEntry &entry) {
+    auto &result = entry.second;
+    result.status = RESULT_STATUS_COMPLETED;
+    result.completed_at = now_date();
+    completions[result.session_id].emplace_back(result.completed_at, entry.first);
+    for (auto *subscriber : subscribers) {
+      if (subscriber->session_id == result.session_id) {
+        subscriber->updates.emplace_back(entry.first, RESULT_STATUS_COMPLETED);
+      }
+    }
+    changed.notify_all();
+  }
+
+  /**
+   * @brief Results which may match the filters, with the mutex held
+   *
+   * @details
+   * Avoids scanning all the results for the queries of the client: lookups by result ids, and the results of a session
+   * completed from a given date.
+   */
+  std::vector<const ResultEntry *> Candidates(const results::Filters &filters) {
+    std::vector<const ResultEntry *> candidates;
+    const auto &conjunctions = filters.or_();
+    const bool by_id = !conjunctions.empty() && std::all_of(conjunctions.begin(), conjunctions.end(), [](auto &c) {
+      return find_condition(c, results::RESULT_RAW_ENUM_FIELD_RESULT_ID,
+                            armonik::api::grpc::v1::FILTER_STRING_OPERATOR_EQUAL) != nullptr;
+    });
+    if (by_id) {
+      for (const auto &conjunction : conjunctions) {
+        auto it = results.find(find_condition(conjunction, results::RESULT_RAW_ENUM_FIELD_RESULT_ID,
+                                              armonik::api::grpc::v1::FILTER_STRING_OPERATOR_EQUAL)
+                                   ->filter_string()
+                                   .value());
+        if (it != results.end()) {
+          candidates.push_back(&*it);
+        }
+      }
+      // Ids listed several times are returned once
+      std::sort(candidates.begin(), candidates.end());
+      candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+      return candidates;
+    }
+
+    if (conjunctions.size() == 1) {
+      auto session = find_condition(conjunctions[0], results::RESULT_RAW_ENUM_FIELD_SESSION_ID,
+                                    armonik::api::grpc::v1::FILTER_STRING_OPERATOR_EQUAL);
+      auto since = find_condition(conjunctions[0], results::RESULT_RAW_ENUM_FIELD_COMPLETED_AT, -1,
+                                  armonik::api::grpc::v1::FILTER_DATE_OPERATOR_AFTER_OR_EQUAL);
+      if (session != nullptr && since != nullptr) {
+        const auto &log = completions[session->filter_string().value()];
+        const auto date = get_date(since->filter_date().value());
+        auto it = std::lower_bound(log.begin(), log.end(), date,
+                                   [](const auto &completion, auto value) { return completion.first < value; });
+        for (; it != log.end(); ++it) {
+          candidates.push_back(&*results.find(it->second));
+        }
+        return candidates;
+      }
+    }
+
+    candidates.reserve(results.size());
+    for (const auto &entry : results) {
+      candidates.push_back(&entry);
+    }
+    return candidates;
+  }
+
+  /**
+   * @brief Complete the task outputs when they are due
+   */
+  void RunCompletions() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopped) {
+      if (scheduled.empty()) {
+        changed.wait(lock);
+        continue;
+      }
+      const auto at = scheduled.top().at;
+      if (Clock::now() < at) {
+        changed.wait_until(lock, at);
+        continue;
+      }
+      auto it = results.find(scheduled.top().result_id);
+      scheduled.pop();
+      if (it != results.end() && it->second.status == RESULT_STATUS_CREATED) {
+        it->second.size = options.output_size;
+        Complete(*it);
+      }
+    }
+  }
+
+  const FakeControlPlaneOptions options;
+
+  /**
+   * @brief Mutex protecting the state below
+   */
+  std::mutex mutex;
+
+  /**
+   * @brief Notified when results are completed or scheduled
+   */
+  std::condition_variable changed;
+  bool stopped = false;
+  std::uint64_t last_id = 0;
+  std::unordered_map<std::string, Result> results;
+  std::unordered_map<std::string, Task> tasks;
+  std::size_t max_submit_batch = 0;
+  std::size_t max_list_batch = 0;
+  grpc::StatusCode list_results_error = grpc::StatusCode::OK;
+
+  /**
+   * @brief Completed results of each session in completion order, which is also the completion date order as the
+   * dates are taken with the mutex held
+   */
+  std::unordered_map<std::string, std::vector<std::pair<std::chrono::nanoseconds, std::string>>> completions;
+  std::priority_queue<Completion, std::vector<Completion>, std::greater<Completion>> scheduled;
+  std::vector<Subscriber *> subscribers;
+  std::thread completer;
+
+  SessionsService sessions_service{*this};
+  TasksService tasks_service{*this};
+  ResultsService results_service{*this};
+  EventsService events_service{*this};
+  std::unique_ptr<grpc::Server> server;
+};
+
+FakeControlPlane::FakeControlPlane(FakeControlPlaneOptions options) : impl_(new Impl(options)) {
+  int port = 0;
+  grpc::ServerBuilder builder;
+  builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &port);
+  builder.RegisterService(&impl_->sessions_service);
+  builder.RegisterService(&impl_->tasks_service);
+  builder.RegisterService(&impl_->results_service);
+  builder.RegisterService(&impl_->events_service);
+  impl_->server = builder.BuildAndStart();
+  if (!impl_->server || port == 0) {
+    throw std::runtime_error("Unable to start the fake control plane");
+  }
+  endpoint_ = "http://127.0.0.1:" + std::to_string(port);
+}
+
+FakeControlPlane::~FakeControlPlane() = default;
+
+std::size_t FakeControlPlane::MaxSubmitBatch() const {
+  std::lock_guard<std::mutex> _(impl_->mutex);
+  return impl_->max_submit_batch;
+}
+
+std::size_t FakeControlPlane::MaxListBatch() const {
+  std::lock_guard<std::mutex> _(impl_->mutex);
+  return impl_->max_list_batch;
+}
+
+void FakeControlPlane::FailResultListings(grpc::StatusCode code) {
+  std::lock_guard<std::mutex> _(impl_->mutex);
+  impl_->list_results_error = code;
+}
@@ -0,0 +1,217 @@
+#include <benchmark/benchmark.h>
+
+#include "FakeControlPlane.h"
+#include <armonik/common/logger/formatter.h>
+#include <armonik/common/logger/logger.h>
+#include <armonik/common/logger/writer.h>
+#include <armonik/sdk/client/IServiceInvocationHandler.h>
+#include <armonik/sdk/client/SessionService.h>
+#include <armonik/sdk/common/BlobDefinition.h>
+#include <armonik/sdk/common/Configuration.h>
+#include <armonik/sdk/common/Properties.h>
+#include <armonik/sdk/common/TaskDefinition.h>
+#include <armonik/sdk/common/TaskOptions.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Number of tasks submitted by each iteration
+ */
+constexpr int TasksPerIteration = 1000;
+
+int get_int(const ArmoniK::Sdk::Common::Configuration &config, const std::string &key, int default_value) {
+  auto value = config.get(key);
+  return value.empty() ? default_value : std::stoi(value);
+}
+
+/**
+ * @brief Behavior of the fake control plane, configured with the Benchmark__RpcLatencyUs and
+ * Benchmark__TaskDurationUs keys of the environment
+ */
+FakeControlPlaneOptions control_plane_options(std::size_t output_size, bool events) {
+  ArmoniK::Sdk::Common::Configuration config;
+  config.add_env_configuration();
+  FakeControlPlaneOptions options;
+  options.rpc_latency = std::chrono::microseconds(get_int(config, "Benchmark__RpcLatencyUs", 200));
+  options.task_duration = std::chrono::microseconds(get_int(config, "Benchmark__TaskDurationUs", 0));
+  options.output_size = output_size;
+  options.events = events;
+  return options;
+}
+
+/**
+ * @brief Client session on its own fake control plane
+ */
+struct BenchmarkSession {
+  BenchmarkSession(const FakeControlPlaneOptions &options, const std::map<std::string, std::string> &settings)
+      : control_plane(options),
+        logger(armonik::api::common::logger::writer_console(), armonik::api::common::logger::formatter_plain(true),
+               armonik::api::common::logger::Level::Warning),
+        service(properties(control_plane, settings), logger) {}
+
+  static ArmoniK::Sdk::Common::Properties properties(const FakeControlPlane &control_plane,
+                                                    const std::map<std::string, std::string> &settings) {
+    ArmoniK::Sdk::Common::Configuration config;
+    config.add_env_configuration();
+    config.set("GrpcClient__Endpoint", control_plane.Endpoint());
+    // The batch sizes given by the arguments are used as is, which the benchmarks check on the control plane side
+    config.set("GrpcClient__BatchTargetLatencyMs", "0");
+    for (const auto &setting : settings) {
+      config.set(setting.first, setting.second);
+    }
+    return {config, ArmoniK::Sdk::Common::TaskOptions("libArmoniK.SDK.Benchmark.so", "", "Benchmark", "Benchmark")};
+  }
+
+  FakeControlPlane control_plane;
+  armonik::api::common::logger::Logger logger;
+  ArmoniK::Sdk::Client::SessionService service;
+};
+
+/**
+ * @brief Records the time elapsed between the start of an iteration and the reception of each result
+ */
+class LatencyHandler final : public ArmoniK::Sdk::Client::IServiceInvocationHandler {
+public:
+  void Start() {
+    std::lock_guard<std::mutex> _(mutex_);
+    start_ = Clock::now();
+  }
+
+  void HandleResponse(const std::string &, const std::string &, const std::string &) override { Record(); }
+
+  void HandleError(const std::exception &, const std::string &) override {
+    std::lock_guard<std::mutex> _(mutex_);
+    ++errors_;
+  }
+
+  std::vector<double> &Latencies() { return latencies_; }
+  int Errors() const { return errors_; }
+
+private:
+  void Record() {
+    std::lock_guard<std::mutex> _(mutex_);
+    latencies_.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start_).count());
+  }
+
+  std::mutex mutex_;
+  Clock::time_point start_;
+  std::vector<double> latencies_;
+  int errors_ = 0;
+};
+
+std::vector<ArmoniK::Sdk::Common::TaskDefinition> make_tasks(std::size_t payload_size) {
+  std::vector<ArmoniK::Sdk::Common::TaskDefinition> tasks;
+  tasks.reserve(TasksPerIteration);
+  for (int i = 0; i < TasksPerIteration; ++i) {
+    tasks.emplace_back("Benchmark", std::map<std::string, ArmoniK::Sdk::Common::BlobDefinition>{
+                                        {"payload", ArmoniK::Sdk::Common::BlobDefinition::FromData(
+                                                        std::string(payload_size, 'p'))}});
+  }
+  return tasks;
+}
+
+/**
+ * @brief Report the median and the 99th percentile of the latencies, in milliseconds
+ */
+void report_latencies(benchmark::State &state, std::vector<double> &latencies) {
+  if (latencies.empty()) {
+    return;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&](double p) { return latencies[static_cast<std::size_t>(p * (latencies.size() - 1))]; };
+  state.counters["p50_ms"] = percentile(0.5);
+  state.counters["p99_ms"] = percentile(0.99);
+}
+} // namespace
+
+/**
+ * @brief Submission throughput and latency of the Submit calls
+ * @details Arguments: SubmitBatchSize, ThreadPoolSize, payload size in bytes
+ */
+static void BM_Submit(benchmark::State &state) {
+  BenchmarkSession session(control_plane_options(8, true),
+                           {{"GrpcClient__SubmitBatchSize", std::to_string(state.range(0))},
+                            {"GrpcClient__ThreadPoolSize", std::to_string(state.range(1))}});
+  const auto tasks = make_tasks(static_cast<std::size_t>(state.range(2)));
+  auto handler = std::make_shared<LatencyHandler>();
+
+  std::vector<double> latencies;
+  for (auto _ : state) {
+    const auto start = Clock::now();
+    session.service.Submit(tasks, handler);
+    latencies.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+    // Drain the results so that the submissions do not pile up
+    state.PauseTiming();
+    session.service.WaitResults();
+    state.ResumeTiming();
+  }
+
+  // Every batch but the last is full
+  const auto submit_batch = session.control_plane.MaxSubmitBatch();
+  state.counters["max_submit_batch"] = static_cast<double>(submit_batch);
+  if (submit_batch != static_cast<std::size_t>(std::min<std::int64_t>(state.range(0), TasksPerIteration))) {
+    state.SkipWithError("The submit batch size is not the one given");
+    return;
+  }
+  state.SetItemsProcessed(state.iterations() * TasksPerIteration);
+  state.SetBytesProcessed(state.iterations() * TasksPerIteration * state.range(2));
+  report_latencies(state, latencies);
+}
+BENCHMARK(BM_Submit)
+    ->ArgNames({"submit_batch", "threads", "payload"})
+    ->ArgsProduct({{50, 200, 1000}, {1, 4, 16}, {64, 16 << 10, 128 << 10}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/**
+ * @brief End to end throughput of Submit followed by WaitResults, and latency of each task from its submission to the
+ * call of its handler
+ * @details Arguments: WaitBatchSize, ThreadPoolSize, output size in bytes, whether events are used instead of polling
+ */
+static void BM_SubmitAndWait(benchmark::State &state) {
+  const bool events = state.range(3) != 0;
+  BenchmarkSession session(control_plane_options(static_cast<std::size_t>(state.range(2)), events),
+                           {{"GrpcClient__WaitBatchSize", std::to_string(state.range(0))},
+                            {"GrpcClient__ThreadPoolSize", std::to_string(state.range(1))}});
+  const auto tasks = make_tasks(64);
+  auto handler = std::make_shared<LatencyHandler>();
+  ArmoniK::Sdk::Client::WaitOptions options;
+  options.polling_ms = 10;
+  options.use_events = events;
+
+  for (auto _ : state) {
+    handler->Start();
+    session.service.Submit(tasks, handler);
+    session.service.WaitResults({}, ArmoniK::Sdk::Client::All, options);
+  }
+
+  if (handler->Errors() > 0) {
+    state.SkipWithError("Some results could not be handled");
+    return;
+  }
+  // The waited results are listed by id in batches which may be partial, but never above the given size
+  const auto wait_batch = session.control_plane.MaxListBatch();
+  state.counters["max_wait_batch"] = static_cast<double>(wait_batch);
+  if (wait_batch > static_cast<std::size_t>(state.range(0))) {
+    state.SkipWithError("The wait batch size is above the one given");
+    return;
+  }
+  state.SetItemsProcessed(state.iterations() * TasksPerIteration);
+  state.SetBytesProcessed(state.iterations() * TasksPerIteration * state.range(2));
+  report_latencies(state, handler->Latencies());
+}
+BENCHMARK(BM_SubmitAndWait)
+    ->ArgNames({"wait_batch", "threads", "output", "events"})
+    ->ArgsProduct({{50, 200, 1000}, {1, 4, 16}, {64, 256 << 10}, {0, 1}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,212 @@
+#include <benchmark/benchmark.h>
+
+#include "ThreadPool.h"
+#include <armonik/common/logger/formatter.h>
+#include <armonik/common/logger/logger.h>
+#include <armonik/common/logger/writer.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using ArmoniK::Sdk::Client::Internal::Function;
+using ArmoniK::Sdk::Client::Internal::FunctionDefaultCapacity;
+using ArmoniK::Sdk::Client::Internal::ThreadPool;
+
+namespace {
+/**
+ * @brief Number of batch jobs spawned by each iteration
+ */
+constexpr int Batches = 200;
+
+/**
+ * @brief Number of small jobs spawned by each batch job
+ */
+constexpr int JobsPerBatch = 50;
+
+armonik::api::common::logger::Logger &logger() {
+  static armonik::api::common::logger::Logger logger(armonik::api::common::logger::writer_console(),
+                                                     armonik::api::common::logger::formatter_plain(true),
+                                                     armonik::api::common::logger::Level::Warning);
+  return logger;
+}
+
+/**
+ * @brief Work-stealing ThreadPool, its jobs being awaited through a join set
+ */
+class WorkStealingPool {
+public:
+  explicit WorkStealingPool(std::size_t threads) : pool_(static_cast<int>(threads), logger()), join_set_(pool_) {}
+  void Spawn(Function<void()> &&f) { join_set_.Spawn(std::move(f)); }
+  void Wait() { join_set_.Wait(); }
+
+private:
+  ThreadPool pool_;
+  ThreadPool::JoinSet join_set_;
+};
+
+/**
+ * @brief Reference pool with a single queue protected by a single mutex, as the ThreadPool used to be
+ */
+class SingleQueuePool {
+public:
+  explicit SingleQueuePool(std::size_t threads) {
+    for (std::size_t i = 0; i < threads; ++i) {
+      threads_.emplace_back([this]() { Run(); });
+    }
+  }
+  ~SingleQueuePool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    condition_.notify_all();
+    for (auto &thread : threads_) {
+      thread.join();
+    }
+  }
+  void Spawn(Function<void()> &&f) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++unfinished_;
+      tasks_.push(std::move(f));
+    }
+    condition_.notify_one();
+  }
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this]() { return unfinished_ == 0; });
+  }
+
+private:
+  void Run() {
+    while (true) {
+      Function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+        if (tasks_.empty()) {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop();
+      }
+      task();
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--unfinished_ == 0) {
+        done_.notify_all();
+      }
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::condition_variable done_;
+  std::queue<Function<void()>> tasks_;
+  std::vector<std::thread> threads_;
+  std::size_t unfinished_ = 0;
+  bool stop_ = false;
+};
+} // namespace
+
+/**
+ * @brief Batch jobs spawning small jobs, as the metadata batches spawning uploads in Submit
+ * @details Arguments: number of threads of the pool
+ */
+template <class Pool> static void BM_NestedSpawns(benchmark::State &state) {
+  std::atomic<long long> count(0);
+  for (auto _ : state) {
+    Pool pool(static_cast<std::size_t>(state.range(0)));
+    for (int i = 0; i < Batches; ++i) {
+      pool.Spawn([&]() {
+        for (int j = 0; j < JobsPerBatch; ++j) {
+          pool.Spawn([&]() { count.fetch_add(1, std::memory_order_relaxed); });
+        }
+      });
+    }
+    pool.Wait();
+  }
+
+  if (count.load() != state.iterations() * Batches * JobsPerBatch) {
+    state.SkipWithError("Some jobs were not executed");
+    return;
+  }
+  state.SetItemsProcessed(state.iterations() * Batches * JobsPerBatch);
+}
+BENCHMARK_TEMPLATE(BM_NestedSpawns, WorkStealingPool)
+    ->ArgName("threads")
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_NestedSpawns, SingleQueuePool)
+    ->ArgName("threads")
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/**
+ * @brief Small jobs spawned from outside the pool, as the batches of Submit and WaitResults
+ * @details Arguments: number of threads of the pool
+ */
+template <class Pool> static void BM_ExternalSpawns(benchmark::State &state) {
+  std::atomic<long long> count(0);
+  for (auto _ : state) {
+    Pool pool(static_cast<std::size_t>(state.range(0)));
+    for (int i = 0; i < Batches * JobsPerBatch; ++i) {
+      pool.Spawn([&]() { count.fetch_add(1, std::memory_order_relaxed); });
+    }
+    pool.Wait();
+  }
+
+  if (count.load() != state.iterations() * Batches * JobsPerBatch) {
+    state.SkipWithError("Some jobs were not executed");
+    return;
+  }
+  state.SetItemsProcessed(state.iterations() * Batches * JobsPerBatch);
+}
+BENCHMARK_TEMPLATE(BM_ExternalSpawns, WorkStealingPool)
+    ->ArgName("threads")
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ExternalSpawns, SingleQueuePool)
+    ->ArgName("threads")
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/**
+ * @brief Creation, move and call of a small job, as spawned on the pool
+ * @details Template argument: inline storage capacity of the Function, 1 forcing a heap allocation
+ */
+template <std::size_t Capacity> static void BM_SmallFunction(benchmark::State &state) {
+  std::vector<int> batch(16, 1);
+  long long sum = 0;
+  int i = 0;
+  for (auto _ : state) {
+    Function<void(), Capacity> f([&sum, &batch, i]() { sum += batch[i % batch.size()]; });
+    Function<void(), Capacity> moved(std::move(f));
+    moved();
+    ++i;
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_SmallFunction, FunctionDefaultCapacity);
+BENCHMARK_TEMPLATE(BM_SmallFunction, 1);
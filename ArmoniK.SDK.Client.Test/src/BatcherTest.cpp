@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include "Batcher.h"
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+using namespace ArmoniK::Sdk::Client::Internal;
+
+namespace {
+constexpr std::chrono::milliseconds Fast{1};
+constexpr std::chrono::milliseconds Slow{200};
+} // namespace
+
+// Full batches within the target latency raise the limit, failed or slow ones halve it
+TEST(BatchSizeController, AdditiveIncreaseMultiplicativeDecrease) {
+  BatchSizeController controller(100, 10, 420, std::chrono::milliseconds(100));
+  EXPECT_EQ(controller.Limit(), 100u);
+
+  controller.Record(100, true, Fast);
+  EXPECT_EQ(controller.Limit(), 113u);
+
+  // A partial batch does not raise the limit
+  controller.Record(50, true, Fast);
+  EXPECT_EQ(controller.Limit(), 113u);
+
+  controller.Record(113, true, Slow);
+  EXPECT_EQ(controller.Limit(), 56u);
+
+  // Batches sent before the decrease are not counted again
+  controller.Record(113, false, Fast);
+  EXPECT_EQ(controller.Limit(), 56u);
+  controller.Record(56, false, Fast);
+  EXPECT_EQ(controller.Limit(), 28u);
+
+  for (int i = 0; i < 10; ++i) {
+    controller.Record(1, false, Fast);
+  }
+  EXPECT_EQ(controller.Limit(), 10u);
+
+  for (int i = 0; i < 100; ++i) {
+    controller.Record(controller.Limit(), true, Fast);
+  }
+  EXPECT_EQ(controller.Limit(), 420u);
+}
+
+TEST(BatchSizeController, NullTargetKeepsTheInitialLimit) {
+  BatchSizeController controller(200, 10, 1000, std::chrono::milliseconds(0));
+  controller.Record(200, false, Slow);
+  controller.Record(200, true, Fast);
+  EXPECT_EQ(controller.Limit(), 200u);
+}
+
+// A batch is processed before a request would make it reach the maximum number of bytes
+TEST(Batcher, BoundsBatchesByCountAndBytes) {
+  BatchSizeController controller(3, 3, 3, std::chrono::milliseconds(0));
+  std::vector<std::vector<int>> batches;
+  Batcher<int> batcher(controller, [&](std::vector<int> &&batch) { batches.push_back(std::move(batch)); }, 100);
+
+  batcher.Add(0, 10);
+  batcher.Add(1, 10);
+  batcher.Add(2, 10);
+  batcher.Add(3, 60);
+  batcher.Add(4, 40);
+  batcher.Add(5, 150);
+  batcher.Add(6, 1);
+  batcher.ProcessBatch();
+
+  std::vector<std::vector<int>> expected{{0, 1, 2}, {3}, {4}, {5}, {6}};
+  EXPECT_EQ(batches, expected);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "BlobSource.h"
+#include <armonik/sdk/common/ArmoniKSdkException.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace ArmoniK::Sdk::Client::Internal;
+
+namespace {
+std::string ReadAll(const BlobSource &source, std::size_t chunk_size) {
+  std::string content, buffer;
+  for (std::size_t offset = 0; offset < source.Size(); offset += chunk_size) {
+    auto chunk = source.Read(offset, std::min(chunk_size, source.Size() - offset), buffer);
+    content.append(chunk.data(), chunk.size());
+  }
+  return content;
+}
+} // namespace
+
+TEST(BlobSource, ViewsData) {
+  const std::string data = "some blob content";
+  auto source = BlobSource::FromData(data);
+  EXPECT_EQ(source.Size(), data.size());
+  std::string buffer;
+  EXPECT_EQ(source.Read(5, 4, buffer).data(), data.data() + 5);
+  EXPECT_EQ(ReadAll(source, 3), data);
+}
+
+// A file can be read again from the start, as a retried upload does
+TEST(BlobSource, ReadsFileByChunks) {
+  const std::string path = "/tmp/blob-source-test";
+  std::string data(1000, '\0');
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<char>(i * 7);
+  }
+  std::ofstream(path, std::ios::binary) << data;
+
+  auto source = BlobSource::FromFile(path);
+  EXPECT_EQ(source.Size(), data.size());
+  EXPECT_EQ(ReadAll(source, 64), data);
+  EXPECT_EQ(ReadAll(source, 999), data);
+  std::remove(path.c_str());
+}
+
+TEST(BlobSource, EmptyFile) {
+  const std::string path = "/tmp/blob-source-empty";
+  std::ofstream(path, std::ios::binary).close();
+  auto source = BlobSource::FromFile(path);
+  std::string buffer;
+  EXPECT_EQ(source.Size(), 0u);
+  EXPECT_TRUE(source.Read(0, 0, buffer).empty());
+  std::remove(path.c_str());
+}
+
+TEST(BlobSource, ResizedFileThrows) {
+  const std::string path = "/tmp/blob-source-resized";
+  std::ofstream(path, std::ios::binary) << "content";
+  auto source = BlobSource::FromFile(path);
+  std::ofstream(path, std::ios::binary | std::ios::app) << "appended";
+  std::string buffer;
+  EXPECT_THROW(source.Read(0, source.Size(), buffer), ArmoniK::Sdk::Common::ArmoniKSdkException);
+  std::remove(path.c_str());
+}
+
+// Reading the next part of a truncated mapped file would raise SIGBUS
+TEST(BlobSource, FileTruncatedBetweenPartsThrows) {
+  const std::string path = "/tmp/blob-source-truncated";
+  std::ofstream(path, std::ios::binary) << std::string(100000, 'x');
+  auto source = BlobSource::FromFile(path);
+  std::string buffer;
+  EXPECT_EQ(source.Read(0, 10, buffer), std::string(10, 'x'));
+  std::ofstream(path, std::ios::binary).close();
+  EXPECT_THROW(source.Read(90000, 10000, buffer), ArmoniK::Sdk::Common::ArmoniKSdkException);
+  std::remove(path.c_str());
+}
+
+TEST(BlobSource, MissingFileThrows) {
+  EXPECT_THROW(BlobSource::FromFile("/tmp/blob-source-missing"), ArmoniK::Sdk::Common::ArmoniKSdkException);
+}
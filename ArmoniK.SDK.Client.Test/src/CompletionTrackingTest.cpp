@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+
+#include "FakeControlPlane.h"
+#include <armonik/common/logger/formatter.h>
+#include <armonik/common/logger/logger.h>
+#include <armonik/common/logger/writer.h>
+#include <armonik/sdk/client/IStreamingServiceInvocationHandler.h>
+#include <armonik/sdk/client/SessionService.h>
+#include <armonik/sdk/common/ArmoniKSdkException.h>
+#include <armonik/sdk/common/BlobDefinition.h>
+#include <armonik/sdk/common/Configuration.h>
+#include <armonik/sdk/common/Properties.h>
+#include <armonik/sdk/common/TaskDefinition.h>
+#include <armonik/sdk/common/TaskOptions.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+/**
+ * @brief Client session on its own fake control plane
+ */
+struct FakeSession {
+  explicit FakeSession(const FakeControlPlaneOptions &options, const std::map<std::string, std::string> &settings = {})
+      : control_plane(options),
+        logger(armonik::api::common::logger::writer_console(), armonik::api::common::logger::formatter_plain(true),
+               armonik::api::common::logger::Level::Warning),
+        service(properties(control_plane, settings), logger) {}
+
+  /**
+   * @brief Give gRPC the time to finish the callbacks of the last calls before their channels are destroyed
+   * @note gRPC 1.51 may abort when a channel is destroyed while its callback completion queue is still releasing a call
+   */
+  ~FakeSession() { std::this_thread::sleep_for(std::chrono::milliseconds(100)); }
+
+  FakeSession(const FakeSession &) = delete;
+  FakeSession &operator=(const FakeSession &) = delete;
+
+  static ArmoniK::Sdk::Common::Properties properties(const FakeControlPlane &control_plane,
+                                                    const std::map<std::string, std::string> &settings) {
+    ArmoniK::Sdk::Common::Configuration config;
+    config.set("GrpcClient__Endpoint", control_plane.Endpoint());
+    for (const auto &setting : settings) {
+      config.set(setting.first, setting.second);
+    }
+    return {config, ArmoniK::Sdk::Common::TaskOptions("libArmoniK.SDK.Test.so", "", "Test", "Test")};
+  }
+
+  FakeControlPlane control_plane;
+  armonik::api::common::logger::Logger logger;
+  ArmoniK::Sdk::Client::SessionService service;
+};
+
+std::vector<ArmoniK::Sdk::Common::TaskDefinition> make_tasks(int count) {
+  std::vector<ArmoniK::Sdk::Common::TaskDefinition> tasks;
+  for (int i = 0; i < count; ++i) {
+    tasks.emplace_back("Test", std::map<std::string, ArmoniK::Sdk::Common::BlobDefinition>{
+                                   {"payload", ArmoniK::Sdk::Common::BlobDefinition::FromData(std::to_string(i))}});
+  }
+  return tasks;
+}
+
+/**
+ * @brief Streaming handler recording the largest number of results streamed at the same time
+ */
+class ConcurrencyHandler final : public ArmoniK::Sdk::Client::IStreamingServiceInvocationHandler {
+public:
+  void HandleResponseBegin(const std::string &, const std::string &) override {
+    auto active = ++active_;
+    auto max = max_active_.load();
+    while (active > max && !max_active_.compare_exchange_weak(max, active)) {
+    }
+  }
+
+  void HandleResponseChunk(absl::string_view, const std::string &, const std::string &) override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+
+  void HandleResponseEnd(const std::string &, const std::string &) override {
+    --active_;
+    ++handled_;
+  }
+
+  void HandleError(const std::exception &, const std::string &) override { ++errors_; }
+
+  int MaxActive() const { return max_active_; }
+  int Handled() const { return handled_; }
+  int Errors() const { return errors_; }
+
+private:
+  std::atomic<int> active_{0};
+  std::atomic<int> max_active_{0};
+  std::atomic<int> handled_{0};
+  std::atomic<int> errors_{0};
+};
+
+/**
+ * @brief Expect the futures to fail before the deadline
+ */
+void expect_failed(std::vector<ArmoniK::Sdk::Client::TaskFuture> &futures,
+                   std::chrono::steady_clock::time_point deadline) {
+  for (auto &future : futures) {
+    ASSERT_EQ(future.result.wait_until(deadline), std::future_status::ready) << future.task_id;
+    EXPECT_THROW(future.result.get(), ArmoniK::Sdk::Common::ArmoniKSdkException);
+  }
+}
+} // namespace
+
+TEST(CompletionTracking, DeliversTheTasksCompletedBeforeTheirRegistration) {
+  // The tasks complete as soon as they are submitted, while their ids are only returned after the reply delay
+  FakeControlPlaneOptions options;
+  options.submit_reply_delay = std::chrono::milliseconds(400);
+  FakeSession session(options);
+
+  // The futures of the first submission are tracked while the tasks of the second one complete before being
+  // registered, the completion cursor moving past their results
+  std::vector<ArmoniK::Sdk::Client::TaskFuture> second;
+  std::thread submitter([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    second = session.service.SubmitWithFutures(make_tasks(10));
+  });
+  auto first = session.service.SubmitWithFutures(make_tasks(10));
+  submitter.join();
+
+  // The results are received long before the periodic reconciliation of the waited results
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+  for (auto *futures : {&first, &second}) {
+    for (auto &future : *futures) {
+      ASSERT_EQ(future.result.wait_until(deadline), std::future_status::ready) << future.task_id;
+      EXPECT_NO_THROW(future.result.get());
+    }
+  }
+}
+
+TEST(CompletionTracking, NonRetryableErrorsFailTheFutures) {
+  FakeControlPlaneOptions options;
+  options.task_duration = std::chrono::hours(1);
+  FakeSession session(options);
+  session.control_plane.FailResultListings(grpc::StatusCode::PERMISSION_DENIED);
+
+  auto futures = session.service.SubmitWithFutures(make_tasks(5));
+  expect_failed(futures, std::chrono::steady_clock::now() + std::chrono::seconds(2));
+}
+
+TEST(CompletionTracking, RepeatedErrorsFailTheFutures) {
+  FakeControlPlaneOptions options;
+  options.task_duration = std::chrono::hours(1);
+  FakeSession session(options);
+  session.control_plane.FailResultListings(grpc::StatusCode::UNAVAILABLE);
+
+  // Transient errors are retried, once per polling period, before giving up
+  auto futures = session.service.SubmitWithFutures(make_tasks(5));
+  EXPECT_EQ(futures[0].result.wait_for(std::chrono::seconds(1)), std::future_status::timeout);
+  expect_failed(futures, std::chrono::steady_clock::now() + std::chrono::seconds(10));
+}
+
+TEST(CompletionTracking, DestroyingTheServiceFailsTheFutures) {
+  FakeControlPlaneOptions options;
+  options.task_duration = std::chrono::hours(1);
+  auto session = std::make_unique<FakeSession>(options);
+
+  auto futures = session->service.SubmitWithFutures(make_tasks(5));
+  session.reset();
+  expect_failed(futures, std::chrono::steady_clock::now());
+}
+
+TEST(CompletionTracking, StreamedResultsTakeADownloadSlot) {
+  FakeSession session({}, {{"GrpcClient__MaxConcurrentDownloads", "2"}, {"GrpcClient__HandlerThreadPoolSize", "8"}});
+  auto handler = std::make_shared<ConcurrencyHandler>();
+
+  session.service.Submit(make_tasks(16), handler);
+  session.service.WaitResults();
+  EXPECT_EQ(handler->Handled(), 16);
+  EXPECT_EQ(handler->Errors(), 0);
+  EXPECT_EQ(handler->MaxActive(), 2);
+}
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include <armonik/sdk/common/Configuration.h>
+
+using ArmoniK::Sdk::Common::Configuration;
+
+TEST(Configuration, ZeroDisablesTheAdaptiveBatching) {
+  Configuration config;
+  EXPECT_EQ(config.get_control_plane().getBatchTargetLatencyMs(), 1000);
+
+  config.set("GrpcClient__BatchTargetLatencyMs", "0");
+  EXPECT_EQ(config.get_control_plane().getBatchTargetLatencyMs(), 0);
+}
+
+TEST(Configuration, ZeroDisablesTheTimeBasedFlush) {
+  Configuration config;
+  EXPECT_EQ(config.get_control_plane().getBatchFlushDelayMs(), 50);
+
+  config.set("GrpcClient__BatchFlushDelayMs", "0");
+  EXPECT_EQ(config.get_control_plane().getBatchFlushDelayMs(), 0);
+}
+
+TEST(Configuration, InvalidDelaysKeepTheDefaults) {
+  Configuration config;
+  config.set("GrpcClient__BatchTargetLatencyMs", "-1");
+  config.set("GrpcClient__BatchFlushDelayMs", "soon");
+  EXPECT_EQ(config.get_control_plane().getBatchTargetLatencyMs(), 1000);
+  EXPECT_EQ(config.get_control_plane().getBatchFlushDelayMs(), 50);
+
+  config.set("GrpcClient__BatchTargetLatencyMs", "250");
+  EXPECT_EQ(config.get_control_plane().getBatchTargetLatencyMs(), 250);
+}
+
+TEST(Configuration, ZeroInputCacheSizeKeepsNoInput) {
+  Configuration config;
+  EXPECT_EQ(config.get_control_plane().getInputCacheMaxSize(), 64 << 20);
+
+  config.set("GrpcClient__InputCacheMaxSize", "0");
+  EXPECT_EQ(config.get_control_plane().getInputCacheMaxSize(), 0);
+}
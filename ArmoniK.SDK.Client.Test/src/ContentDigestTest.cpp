@@ -0,0 +1,30 @@
+#include <gtest/gtest.h>
+
+#include "ContentDigest.h"
+#include <string>
+#include <unordered_map>
+
+using namespace ArmoniK::Sdk::Client::Internal;
+
+TEST(ContentDigest, EqualContentsHaveEqualDigests) {
+  const std::string content(1000, 'a');
+  EXPECT_EQ(ContentDigest::Of(content), ContentDigest::Of(std::string(1000, 'a')));
+  EXPECT_EQ(ContentDigest::Of(""), ContentDigest::Of(std::string()));
+}
+
+TEST(ContentDigest, DifferentContentsHaveDifferentDigests) {
+  std::string content(1000, 'a');
+  const auto digest = ContentDigest::Of(content);
+  content[999] = 'b';
+  EXPECT_FALSE(digest == ContentDigest::Of(content));
+  EXPECT_FALSE(ContentDigest::Of("a") == ContentDigest::Of(std::string("a\0", 2)));
+}
+
+TEST(ContentDigest, UsableAsKey) {
+  std::unordered_map<ContentDigest, int, ContentDigest::Hash> ids;
+  ids[ContentDigest::Of("first")] = 1;
+  ids[ContentDigest::Of("second")] = 2;
+  ids[ContentDigest::Of("first")] = 3;
+  ASSERT_EQ(ids.size(), 2u);
+  EXPECT_EQ(ids.at(ContentDigest::Of("first")), 3);
+}
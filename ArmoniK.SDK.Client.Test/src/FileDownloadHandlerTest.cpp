@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <armonik/sdk/client/FileDownloadHandler.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ArmoniK::Sdk::Client;
+
+namespace {
+struct RecordingFileHandler : FileDownloadHandler {
+  using FileDownloadHandler::FileDownloadHandler;
+
+  void HandleFile(const std::string &path, const std::string &, const std::string &) override { files.push_back(path); }
+  void HandleFileError(const std::exception &e, const std::string &) override { errors.emplace_back(e.what()); }
+
+  std::vector<std::string> files;
+  std::vector<std::string> errors;
+};
+
+bool Exists(const std::string &path) { return std::ifstream(path).good(); }
+
+std::string ReadAll(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  std::stringstream ss;
+  ss << file.rdbuf();
+  return ss.str();
+}
+} // namespace
+
+// Chunks are appended in order and the file only appears under its final name once complete.
+TEST(FileDownloadHandler, WritesChunksToFile) {
+  RecordingFileHandler handler("/tmp");
+  handler.HandleResponseBegin("task", "fdh-result-1");
+  handler.HandleResponseChunk("hello ", "task", "fdh-result-1");
+  EXPECT_FALSE(Exists("/tmp/fdh-result-1"));
+  handler.HandleResponseChunk("world", "task", "fdh-result-1");
+  handler.HandleResponseEnd("task", "fdh-result-1");
+
+  ASSERT_EQ(handler.files.size(), 1u);
+  EXPECT_EQ(handler.files[0], "/tmp/fdh-result-1");
+  EXPECT_EQ(ReadAll(handler.files[0]), "hello world");
+  EXPECT_FALSE(Exists("/tmp/fdh-result-1.part"));
+  std::remove(handler.files[0].c_str());
+}
+
+// A download interrupted by an error leaves no file behind.
+TEST(FileDownloadHandler, RemovesPartialFileOnError) {
+  RecordingFileHandler handler("/tmp");
+  handler.HandleResponseBegin("task", "fdh-result-2");
+  handler.HandleResponseChunk("partial", "task", "fdh-result-2");
+  handler.HandleError(std::runtime_error("stream broken"), "task");
+
+  EXPECT_TRUE(handler.files.empty());
+  ASSERT_EQ(handler.errors.size(), 1u);
+  EXPECT_EQ(handler.errors[0], "stream broken");
+  EXPECT_FALSE(Exists("/tmp/fdh-result-2.part"));
+  EXPECT_FALSE(Exists("/tmp/fdh-result-2"));
+}
+
+// Non-streaming delivery goes through the same path as a single chunk.
+TEST(FileDownloadHandler, WholePayloadIsSingleChunk) {
+  RecordingFileHandler handler("/tmp");
+  handler.HandleResponse("payload", "task", "fdh-result-3");
+
+  ASSERT_EQ(handler.files.size(), 1u);
+  EXPECT_EQ(ReadAll(handler.files[0]), "payload");
+  std::remove(handler.files[0].c_str());
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include "FutureHandler.h"
+#include <armonik/sdk/common/ArmoniKSdkException.h>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+using namespace ArmoniK::Sdk::Client;
+using namespace ArmoniK::Sdk::Client::Internal;
+
+namespace {
+struct CustomError : std::runtime_error {
+  using std::runtime_error::runtime_error;
+};
+} // namespace
+
+// The future can be requested before or after the result is handled
+TEST(FutureHandler, ResultBeforeOrAfterFuture) {
+  FutureHandler handler;
+  EXPECT_FALSE(handler.HasPending());
+  auto early = handler.Future("task-1");
+  EXPECT_EQ(early.wait_for(std::chrono::seconds(0)), std::future_status::timeout);
+  EXPECT_TRUE(handler.HasPending());
+  handler.HandleResponse("payload-1", "task-1", "result-1");
+  EXPECT_FALSE(handler.HasPending());
+  auto result = early.get();
+  EXPECT_EQ(result.task_id, "task-1");
+  EXPECT_EQ(result.result_id, "result-1");
+  EXPECT_EQ(result.payload, "payload-1");
+
+  handler.HandleResponse("payload-2", "task-2", "result-2");
+  EXPECT_EQ(handler.Future("task-2").get().payload, "payload-2");
+  EXPECT_FALSE(handler.HasPending());
+}
+
+// Errors handled while being thrown keep their type
+TEST(FutureHandler, ErrorsAreRethrown) {
+  FutureHandler handler;
+  auto future = handler.Future("task");
+  try {
+    throw CustomError("aborted");
+  } catch (const std::exception &e) {
+    handler.HandleError(e, "task");
+  }
+  EXPECT_THROW(future.get(), CustomError);
+
+  auto other = handler.Future("other");
+  handler.HandleError(std::runtime_error("failed"), "other");
+  EXPECT_THROW(other.get(), std::runtime_error);
+}
+
+TEST(FutureHandler, DiscardedTasksFail) {
+  FutureHandler handler;
+  auto first = handler.Future("first");
+  auto second = handler.Future("second");
+  handler.HandleResponse("done", "second", "result");
+  handler.Discard("first", "cleaned up");
+  auto third = handler.Future("third");
+  EXPECT_TRUE(handler.HasPending());
+  handler.DiscardAll("dropped");
+  EXPECT_FALSE(handler.HasPending());
+  EXPECT_THROW(first.get(), ArmoniK::Sdk::Common::ArmoniKSdkException);
+  EXPECT_EQ(second.get().payload, "done");
+  EXPECT_THROW(third.get(), ArmoniK::Sdk::Common::ArmoniKSdkException);
+}
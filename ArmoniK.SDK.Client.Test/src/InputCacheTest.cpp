@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include "InputCache.h"
+#include <memory>
+#include <string>
+
+using namespace ArmoniK::Sdk::Client::Internal;
+
+namespace {
+/**
+ * @brief Insert a content in the cache, with its computed digest
+ */
+void Insert(InputCache &cache, const std::string &data, const std::string &result_id) {
+  cache.Insert(ContentDigest::Of(data), std::make_shared<const std::string>(data), result_id);
+}
+
+std::string Find(InputCache &cache, const std::string &data) { return cache.Find(ContentDigest::Of(data), data); }
+} // namespace
+
+TEST(InputCache, FindsEqualContents) {
+  InputCache cache(1000);
+  Insert(cache, "first", "result-1");
+  Insert(cache, "second", "result-2");
+
+  EXPECT_EQ(Find(cache, std::string("first")), "result-1");
+  EXPECT_EQ(Find(cache, "second"), "result-2");
+  EXPECT_EQ(Find(cache, "third"), "");
+  EXPECT_EQ(cache.Size(), 11u);
+}
+
+TEST(InputCache, ComparesTheBytesOfCollidingDigests) {
+  InputCache cache(1000);
+  // Two different contents given the same digest, as a collision would
+  const auto digest = ContentDigest::Of("first");
+  cache.Insert(digest, std::make_shared<const std::string>("first"), "result-1");
+
+  EXPECT_EQ(cache.Find(digest, "forged"), "");
+  cache.Insert(digest, std::make_shared<const std::string>("forged"), "result-2");
+  EXPECT_EQ(cache.Find(digest, "first"), "result-1");
+  EXPECT_EQ(cache.Find(digest, "forged"), "result-2");
+}
+
+TEST(InputCache, EvictsTheLeastRecentlyUsedContents) {
+  InputCache cache(30);
+  Insert(cache, std::string(10, 'a'), "a");
+  Insert(cache, std::string(10, 'b'), "b");
+  Insert(cache, std::string(10, 'c'), "c");
+  // Using "a" makes "b" the least recently used
+  EXPECT_EQ(Find(cache, std::string(10, 'a')), "a");
+
+  Insert(cache, std::string(10, 'd'), "d");
+  EXPECT_EQ(Find(cache, std::string(10, 'b')), "");
+  EXPECT_EQ(Find(cache, std::string(10, 'a')), "a");
+  EXPECT_EQ(Find(cache, std::string(10, 'c')), "c");
+  EXPECT_EQ(Find(cache, std::string(10, 'd')), "d");
+  EXPECT_EQ(cache.Size(), 30u);
+}
+
+TEST(InputCache, SkipsContentsAboveTheLimit) {
+  InputCache cache(30);
+  Insert(cache, std::string(10, 'a'), "a");
+  Insert(cache, std::string(31, 'b'), "b");
+
+  EXPECT_EQ(Find(cache, std::string(31, 'b')), "");
+  EXPECT_EQ(Find(cache, std::string(10, 'a')), "a");
+
+  InputCache disabled(0);
+  Insert(disabled, "", "empty");
+  EXPECT_EQ(Find(disabled, ""), "");
+}
+
+TEST(InputCache, ClearRemovesAllContents) {
+  InputCache cache(1000);
+  Insert(cache, "first", "result-1");
+  cache.Clear();
+
+  EXPECT_EQ(Find(cache, "first"), "");
+  EXPECT_EQ(cache.Size(), 0u);
+}
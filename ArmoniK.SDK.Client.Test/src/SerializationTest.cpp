@@ -5,6 +5,8 @@
 #include <armonik/sdk/common/DynamicLibrary.h>
 #include <armonik/sdk/common/TaskDefinition.h>
 #include <armonik/sdk/common/TaskOptions.h>
+#include <armonik/sdk/common/TaskPayload.h>
+#include <armonik/sdk/common/internal/ConventionPayload.h>
 
 using namespace ArmoniK::Sdk::Common;
 
@@ -115,6 +117,18 @@ TEST(TaskOptionsConventionVersion, ReturnsVersionWhenSet) {
   EXPECT_EQ(opts.GetConventionVersion(), DynamicLibrary::ConventionVersion);
 }
 
+// The binary encoding is opted into through the DynamicLibrary and must survive the task options round trip.
+TEST(TaskOptionsConventionVersion, BinaryVersionRoundTrip) {
+  TaskOptions opts("app", "1.0", "ns", "svc", "part");
+  DynamicLibrary lib;
+  lib.library_path = "/data/lib.so";
+  lib.convention_version = DynamicLibrary::ConventionVersionBinary;
+  opts.SetDynamicLibrary(lib);
+
+  EXPECT_EQ(opts.GetConventionVersion(), DynamicLibrary::ConventionVersionBinary);
+  EXPECT_EQ(opts.GetDynamicLibrary().convention_version, DynamicLibrary::ConventionVersionBinary);
+}
+
 // Tasks that were submitted without the convention (e.g. legacy path) will not have
 // ConventionVersion in their options; GetConventionVersion must throw so the caller
 // can distinguish them from convention tasks.
@@ -160,6 +174,25 @@ TEST(BlobDefinition, FromBlobIdEmptyString) {
   EXPECT_EQ(b.GetBlobId(), "");
 }
 
+TEST(BlobDefinition, FromFileIsFile) {
+  auto b = BlobDefinition::FromFile("/data/input.bin");
+  EXPECT_FALSE(b.IsRawData());
+  EXPECT_TRUE(b.IsFile());
+  EXPECT_FALSE(b.IsBlobId());
+  EXPECT_EQ(b.GetPath(), "/data/input.bin");
+}
+
+// Copies and definitions built from the same buffer share the data instead of copying it
+TEST(BlobDefinition, FromSharedDataSharesTheBuffer) {
+  auto data = std::make_shared<const std::string>("shared");
+  auto b = BlobDefinition::FromSharedData(data);
+  auto copy = b;
+  EXPECT_TRUE(b.IsRawData());
+  EXPECT_EQ(&b.GetData(), data.get());
+  EXPECT_EQ(&copy.GetData(), data.get());
+  EXPECT_EQ(&BlobDefinition::FromSharedData(data).GetData(), data.get());
+}
+
 // ---------------------------------------------------------------------------
 // TaskDefinition
 // ---------------------------------------------------------------------------
@@ -198,3 +231,149 @@ TEST(TaskDefinition, WithInputOverwritesExisting) {
   // std::map::emplace does not overwrite — first insertion wins
   EXPECT_EQ(td.inputs.at("k").GetData(), "v1");
 }
+
+// ---------------------------------------------------------------------------
+// ConventionPayload
+// ---------------------------------------------------------------------------
+
+static ConventionPayload make_convention_payload() {
+  ConventionPayload payload;
+  payload.method_name = "multiply";
+  payload.inputs["a"] = "blob-a";
+  payload.inputs["b"] = std::string("bin\0ary\xff", 8);
+  payload.outputs["result"] = "blob-result";
+  return payload;
+}
+
+TEST(ConventionPayload, JsonRoundTrip) {
+  auto payload = make_convention_payload();
+  payload.inputs["b"] = "text";
+  auto serialized = payload.Serialize();
+  EXPECT_FALSE(ConventionPayload::IsBinary(serialized));
+
+  auto restored = ConventionPayload::Deserialize(serialized);
+  EXPECT_EQ(restored.method_name, payload.method_name);
+  EXPECT_EQ(restored.inputs, payload.inputs);
+  EXPECT_EQ(restored.outputs, payload.outputs);
+}
+
+TEST(ConventionPayload, BinaryRoundTrip) {
+  auto payload = make_convention_payload();
+  auto serialized = payload.Serialize(ConventionPayload::Encoding::Binary);
+  EXPECT_TRUE(ConventionPayload::IsBinary(serialized));
+
+  auto restored = ConventionPayload::Deserialize(serialized);
+  EXPECT_EQ(restored.method_name, payload.method_name);
+  EXPECT_EQ(restored.inputs, payload.inputs);
+  EXPECT_EQ(restored.outputs, payload.outputs);
+}
+
+// The view points into the serialized buffer, and every name is followed by a null byte.
+TEST(ConventionPayload, BinaryViewDoesNotCopy) {
+  auto payload = make_convention_payload();
+  auto serialized = payload.Serialize(ConventionPayload::Encoding::Binary);
+  auto view = ConventionPayloadView::Parse(serialized);
+
+  EXPECT_EQ(view.method_name, "multiply");
+  ASSERT_EQ(view.inputs.size(), 2u);
+  ASSERT_EQ(view.outputs.size(), 1u);
+
+  auto it = payload.inputs.begin();
+  for (auto &&entry : view.inputs) {
+    EXPECT_EQ(entry.first, it->first);
+    EXPECT_EQ(entry.second, it->second);
+    EXPECT_EQ(entry.first.data()[entry.first.size()], '\0');
+    EXPECT_GE(entry.second.data(), serialized.data());
+    EXPECT_LE(entry.second.data() + entry.second.size(), serialized.data() + serialized.size());
+    ++it;
+  }
+  EXPECT_EQ(view.outputs.begin()->first, "result");
+  EXPECT_EQ(view.outputs.begin()->second, "blob-result");
+}
+
+TEST(ConventionPayload, BinaryEmpty) {
+  ConventionPayload payload;
+  auto view = ConventionPayloadView::Parse(payload.Serialize(ConventionPayload::Encoding::Binary));
+  EXPECT_TRUE(view.method_name.empty());
+  EXPECT_TRUE(view.inputs.empty());
+  EXPECT_TRUE(view.outputs.empty());
+  EXPECT_EQ(view.inputs.begin(), view.inputs.end());
+}
+
+TEST(ConventionPayload, BinaryTruncatedThrows) {
+  auto serialized = make_convention_payload().Serialize(ConventionPayload::Encoding::Binary);
+  for (std::size_t size = 0; size < serialized.size(); size += 3) {
+    EXPECT_THROW(ConventionPayload::Deserialize(serialized.substr(0, size)), ArmoniKSdkException) << size;
+  }
+  EXPECT_THROW(ConventionPayloadView::Parse(serialized + "x"), ArmoniKSdkException);
+}
+
+TEST(ConventionPayload, EncodingFromVersion) {
+  EXPECT_EQ(ConventionPayload::EncodingFromVersion(DynamicLibrary::ConventionVersion),
+            ConventionPayload::Encoding::Json);
+  EXPECT_EQ(ConventionPayload::EncodingFromVersion(DynamicLibrary::ConventionVersionBinary),
+            ConventionPayload::Encoding::Binary);
+  EXPECT_THROW(ConventionPayload::EncodingFromVersion("v0"), ArmoniKSdkException);
+}
+
+// ---------------------------------------------------------------------------
+// TaskPayload (legacy path)
+// ---------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+
+// The hex encoding must stay byte-for-byte identical to what older SDKs and non C++ workers expect.
+TEST(TaskPayload, HexEncodingIsUnchanged) {
+  TaskPayload payload("add", std::string("\x01\x02", 2), {"dd1"});
+  EXPECT_EQ(payload.Serialize(), std::string("00000003add00000002\x01\x02" "00000003dd1", 32));
+  EXPECT_FALSE(TaskPayloadView::IsBinary(payload.Serialize()));
+}
+
+// Payloads produced by older clients, with uppercase hexadecimal digits, must still be decoded.
+TEST(TaskPayload, HexDecodesOldPayload) {
+  auto restored = TaskPayload::Deserialize("0000000Amethod_abc00000004args00000002d100000002d2");
+  EXPECT_EQ(restored.method_name, "method_abc");
+  EXPECT_EQ(restored.arguments, "args");
+  EXPECT_EQ(restored.data_dependencies, (std::vector<std::string>{"d1", "d2"}));
+}
+
+TEST(TaskPayload, HexInvalidSizeThrows) {
+  EXPECT_THROW(TaskPayload::Deserialize("0000000Xmethod"), std::runtime_error);
+  EXPECT_THROW(TaskPayload::Deserialize("0000"), std::runtime_error);
+}
+
+TEST(TaskPayload, BinaryRoundTrip) {
+  TaskPayload payload("method", std::string("bin\0ary", 7), {"dd1", "", "dd3"});
+  auto serialized = payload.Serialize(TaskPayload::Encoding::Binary);
+  EXPECT_TRUE(TaskPayloadView::IsBinary(serialized));
+
+  auto restored = TaskPayload::Deserialize(serialized);
+  EXPECT_EQ(restored.method_name, payload.method_name);
+  EXPECT_EQ(restored.arguments, payload.arguments);
+  EXPECT_EQ(restored.data_dependencies, payload.data_dependencies);
+}
+
+TEST(TaskPayload, BinaryTruncatedThrows) {
+  auto serialized = TaskPayload("method", "arguments", {"dd"}).Serialize(TaskPayload::Encoding::Binary);
+  for (std::size_t size = 5; size < serialized.size(); ++size) {
+    EXPECT_THROW(TaskPayload::Deserialize(serialized.substr(0, size)), ArmoniKSdkException) << size;
+  }
+}
+
+// The view must not copy: its fields point into the serialized buffer, whatever the encoding.
+TEST(TaskPayload, ViewPointsIntoBuffer) {
+  TaskPayload payload("method", "arguments", {"dd"});
+  for (auto encoding : {TaskPayload::Encoding::Hex, TaskPayload::Encoding::Binary}) {
+    auto serialized = payload.Serialize(encoding);
+    auto view = TaskPayloadView::Parse(serialized);
+    EXPECT_EQ(view.method_name, "method");
+    EXPECT_EQ(view.arguments, "arguments");
+    ASSERT_EQ(view.data_dependencies.size(), 1u);
+    EXPECT_EQ(view.data_dependencies[0], "dd");
+    EXPECT_GE(view.arguments.data(), serialized.data());
+    EXPECT_LT(view.arguments.data(), serialized.data() + serialized.size());
+  }
+}
+
+#pragma GCC diagnostic pop
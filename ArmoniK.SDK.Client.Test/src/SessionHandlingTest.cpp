@@ -1,6 +1,7 @@
 #include <grpcpp/create_channel.h>
 #include <gtest/gtest.h>
 #include <iostream>
+#include <set>
 
 #include <armonik/common/logger/formatter.h>
 #include <armonik/common/logger/logger.h>
@@ -327,6 +328,30 @@ TEST(WaitOption, timeout_test) {
   service.CloseSession();
 }
 
+TEST(WaitOption, events_test) {
+  auto p = init();
+  auto properties = std::move(std::get<0>(p));
+  auto logger = std::move(std::get<1>(p));
+
+  ArmoniK::Sdk::Client::SessionService service(properties, logger);
+  ASSERT_FALSE(service.getSession().empty());
+
+  auto handler = std::make_shared<CountServiceHandler>(logger);
+  auto task_ids = service.Submit(generate_payloads(20), handler);
+  ASSERT_EQ(task_ids.size(), 20);
+
+  // Completions are notified through the events stream, resynchronization should not be needed
+  ArmoniK::Sdk::Client::WaitOptions waitOptions;
+  waitOptions.use_events = true;
+  waitOptions.timeout = 60000;
+  service.WaitResults({}, ArmoniK::Sdk::Client::All, waitOptions);
+
+  EXPECT_EQ(handler->success, 20);
+  EXPECT_EQ(handler->failure, 0);
+
+  service.CloseSession();
+}
+
 // ---------------------------------------------------------------------------
 // TaskDefinition end-to-end tests
 //
@@ -438,3 +463,40 @@ TEST(SessionService, task_definition_submit_no_inputs) {
 
   service.CloseSession();
 }
+
+// Push tasks one at a time through a streaming submitter with a small in-flight window,
+// forcing the producer to block on backpressure while earlier batches are submitted.
+TEST(SessionService, task_submitter_push) {
+  auto p = init_convention();
+  auto &properties = std::get<0>(p);
+  auto &logger = std::get<1>(p);
+
+  ArmoniK::Sdk::Client::SessionService service(properties, logger);
+
+  auto handler = std::make_shared<CountServiceHandler>(logger);
+
+  const int n = 30;
+  std::vector<std::future<std::string>> futures;
+  {
+    auto submitter = service.CreateSubmitter(handler, 10);
+    for (int i = 0; i < n; ++i) {
+      futures.push_back(submitter.Push(ArmoniK::Sdk::Common::TaskDefinition(
+          "echo_convention",
+          std::map<std::string, ArmoniK::Sdk::Common::BlobDefinition>{
+              {"value", ArmoniK::Sdk::Common::BlobDefinition::FromData("payload-" + std::to_string(i))}})));
+    }
+    submitter.Close();
+  }
+
+  std::set<std::string> task_ids;
+  for (auto &future : futures) {
+    task_ids.insert(future.get());
+  }
+  ASSERT_EQ(task_ids.size(), static_cast<std::size_t>(n));
+
+  service.WaitResults();
+  EXPECT_EQ(handler->success, n);
+  EXPECT_EQ(handler->failure, 0);
+
+  service.CloseSession();
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include "TaskRegistry.h"
+#include <armonik/sdk/client/IServiceInvocationHandler.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ArmoniK::Sdk::Client;
+using namespace ArmoniK::Sdk::Client::Internal;
+
+namespace {
+struct NullHandler : IServiceInvocationHandler {
+  void HandleResponse(const std::string &, const std::string &, const std::string &) override {}
+  void HandleError(const std::exception &, const std::string &) override {}
+};
+
+std::vector<std::string> Ids(const std::string &prefix, std::size_t n) {
+  std::vector<std::string> ids;
+  ids.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    ids.push_back(prefix + std::to_string(i));
+  }
+  return ids;
+}
+} // namespace
+
+TEST(TaskRegistry, LookupByEitherKey) {
+  TaskRegistry registry;
+  auto handler = std::make_shared<NullHandler>();
+  registry.Add(Ids("task-", 1000), Ids("result-", 1000), handler);
+  EXPECT_EQ(registry.Size(), 1000u);
+  EXPECT_EQ(registry.ResultIds().size(), 1000u);
+
+  std::string result_id;
+  ASSERT_TRUE(registry.FindResult("task-42", result_id));
+  EXPECT_EQ(result_id, "result-42");
+  EXPECT_FALSE(registry.FindResult("task-1000", result_id));
+
+  TaskRegistry::Record record;
+  ASSERT_TRUE(registry.TakeByResult("result-42", record));
+  EXPECT_EQ(record.task_id, "task-42");
+  EXPECT_EQ(record.result_id, "result-42");
+  EXPECT_EQ(record.handler, handler);
+  EXPECT_FALSE(registry.TakeByResult("result-42", record));
+  EXPECT_FALSE(registry.FindResult("task-42", result_id));
+
+  EXPECT_TRUE(registry.RemoveByTask("task-7"));
+  EXPECT_FALSE(registry.RemoveByTask("task-7"));
+  EXPECT_FALSE(registry.TakeByResult("result-7", record));
+  EXPECT_EQ(registry.Size(), 998u);
+}
+
+// Removed slots are reused without a stale task entry matching the new record
+TEST(TaskRegistry, ReusedSlotsAreNotFoundByOldTask) {
+  TaskRegistry registry;
+  auto handler = std::make_shared<NullHandler>();
+  registry.Add(Ids("old-", 100), Ids("result-", 100), handler);
+  for (const auto &task_id : Ids("old-", 100)) {
+    ASSERT_TRUE(registry.RemoveByTask(task_id));
+  }
+  registry.Add(Ids("new-", 100), Ids("other-", 100), handler);
+
+  std::string result_id;
+  EXPECT_FALSE(registry.FindResult("old-3", result_id));
+  ASSERT_TRUE(registry.FindResult("new-3", result_id));
+  EXPECT_EQ(result_id, "other-3");
+  EXPECT_EQ(registry.Size(), 100u);
+}
+
+// The registry only keeps handlers alive while tasks use them
+TEST(TaskRegistry, HandlersAreReleasedWithTheirLastTask) {
+  TaskRegistry registry;
+  auto handler = std::make_shared<NullHandler>();
+  std::weak_ptr<NullHandler> weak = handler;
+  registry.Add(Ids("task-", 3), Ids("result-", 3), handler);
+  handler.reset();
+
+  TaskRegistry::Record record;
+  ASSERT_TRUE(registry.TakeByResult("result-0", record));
+  record = {};
+  ASSERT_TRUE(registry.RemoveByTask("task-1"));
+  EXPECT_FALSE(weak.expired());
+  registry.Clear();
+  EXPECT_TRUE(weak.expired());
+  EXPECT_EQ(registry.Size(), 0u);
+}
+
+// Tasks registered before a given registration can be waited for without the later ones
+TEST(TaskRegistry, SequencesSeparateRegistrations) {
+  TaskRegistry registry;
+  auto handler = std::make_shared<NullHandler>();
+  EXPECT_EQ(registry.LastSequence(), 0u);
+  auto first = registry.Add({"task-a"}, {"result-a"}, handler);
+  auto second = registry.Add({"task-b"}, {"result-b"}, handler);
+  EXPECT_LT(first, second);
+  EXPECT_EQ(registry.LastSequence(), second);
+  EXPECT_EQ(registry.ResultIds(first), std::vector<std::string>{"result-a"});
+
+  TaskRegistry::Record record;
+  EXPECT_FALSE(registry.TakeByResult("result-b", record, first));
+  EXPECT_TRUE(registry.HasResult("result-b"));
+  EXPECT_TRUE(registry.HasPending(first));
+  ASSERT_TRUE(registry.TakeByResult("result-a", record, first));
+  EXPECT_EQ(record.sequence, first);
+  EXPECT_FALSE(registry.HasResult("result-a"));
+  EXPECT_FALSE(registry.HasPending(first));
+  EXPECT_TRUE(registry.HasPending(second));
+}
+
+// The tasks of a handler can be waited for without the ones of the other handlers
+TEST(TaskRegistry, HandlersSeparateTasks) {
+  TaskRegistry registry;
+  auto futures = std::make_shared<NullHandler>();
+  auto other = std::make_shared<NullHandler>();
+  registry.Add({"task-a"}, {"result-a"}, futures);
+  registry.Add({"task-b"}, {"result-b"}, other);
+  EXPECT_EQ(registry.ResultIds(UINT64_MAX, futures.get()), std::vector<std::string>{"result-a"});
+
+  TaskRegistry::Record record;
+  EXPECT_FALSE(registry.TakeByResult("result-b", record, UINT64_MAX, futures.get()));
+  EXPECT_TRUE(registry.HasResult("result-b"));
+  ASSERT_TRUE(registry.TakeByResult("result-a", record, UINT64_MAX, futures.get()));
+  EXPECT_EQ(record.handler, futures);
+  EXPECT_TRUE(registry.ResultIds(UINT64_MAX, futures.get()).empty());
+}
+
+TEST(TaskRegistry, ConcurrentCompletions) {
+  TaskRegistry registry;
+  const std::size_t n = 20000;
+  registry.Add(Ids("task-", n), Ids("result-", n), std::make_shared<NullHandler>());
+
+  std::atomic<std::size_t> taken(0);
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t]() {
+      TaskRegistry::Record record;
+      std::string result_id;
+      for (std::size_t i = t; i < n; i += 4) {
+        auto id = std::to_string(i);
+        if (i % 2 == 0) {
+          taken += registry.TakeByResult("result-" + id, record);
+        } else {
+          taken += registry.FindResult("task-" + id, result_id) && registry.RemoveByTask("task-" + id);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(taken.load(), n);
+  EXPECT_EQ(registry.Size(), 0u);
+}
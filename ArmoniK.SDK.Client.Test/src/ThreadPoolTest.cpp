@@ -1,11 +1,12 @@
 #include <gtest/gtest.h>
 
 #include "ThreadPool.h"
+#include <array>
 #include <atomic>
 #include <chrono>
-#include <condition_variable>
+#include <cstdint>
 #include <future>
-#include <mutex>
+#include <memory>
 #include <thread>
 #include <vector>
 
@@ -285,3 +286,160 @@ TEST_F(ThreadPoolTest, ConcurrentTaskExecution) {
   ASSERT_GT(max_concurrent, 1);
   WITH_TIMEOUT(TIMEOUT, delete pool);
 }
+
+TEST_F(ThreadPoolTest, NestedSpawnsAreJoined) {
+  ThreadPool *pool = new ThreadPool(4, *logger_);
+  auto count = std::make_shared<std::atomic<int>>();
+
+  ThreadPool::JoinSet *join_set = new ThreadPool::JoinSet(*pool);
+  for (int i = 0; i < 10; ++i) {
+    join_set->Spawn([join_set, count]() mutable {
+      for (int j = 0; j < 10; ++j) {
+        join_set->Spawn([count]() mutable { count->fetch_add(1); });
+      }
+    });
+  }
+  WITH_TIMEOUT(TIMEOUT, join_set->Wait());
+  EXPECT_EQ(count->load(), 100);
+
+  WITH_TIMEOUT(TIMEOUT, delete join_set);
+  WITH_TIMEOUT(TIMEOUT, delete pool);
+}
+
+// Operations completed from outside the pool, as asynchronous RPCs are, keep the join set busy until their
+// continuation has run.
+TEST_F(ThreadPoolTest, PendingOperationsAreJoined) {
+  ThreadPool *pool = new ThreadPool(2, *logger_);
+  auto count = std::make_shared<std::atomic<int>>();
+
+  ThreadPool::JoinSet *join_set = new ThreadPool::JoinSet(*pool);
+  std::vector<std::thread> completions;
+  for (int i = 0; i < 10; ++i) {
+    completions.emplace_back([pending = join_set->Track(), count]() mutable {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      pending.Then([count]() { count->fetch_add(1); });
+    });
+  }
+  WITH_TIMEOUT(TIMEOUT, join_set->Wait());
+  EXPECT_EQ(count->load(), 10);
+
+  for (auto &thread : completions) {
+    thread.join();
+  }
+  WITH_TIMEOUT(TIMEOUT, delete join_set);
+  WITH_TIMEOUT(TIMEOUT, delete pool);
+}
+
+TEST_F(ThreadPoolTest, PendingOperationFailureIsRethrown) {
+  ThreadPool *pool = new ThreadPool(2, *logger_);
+
+  ThreadPool::JoinSet *join_set = new ThreadPool::JoinSet(*pool);
+  std::thread completion([pending = join_set->Track()]() mutable {
+    pending.Fail(std::make_exception_ptr(std::runtime_error("expected")));
+  });
+  // A pending operation dropped without continuation is simply done
+  { auto dropped = join_set->Track(); }
+
+  EXPECT_THROW(WITH_TIMEOUT(TIMEOUT, join_set->Wait()), std::runtime_error);
+
+  completion.join();
+  WITH_TIMEOUT(TIMEOUT, join_set->Wait());
+  WITH_TIMEOUT(TIMEOUT, delete join_set);
+  WITH_TIMEOUT(TIMEOUT, delete pool);
+}
+
+// ---------------------------------------------------------------------------
+// Function: small buffer optimization
+// ---------------------------------------------------------------------------
+
+namespace {
+/**
+ * @brief Counts the live instances, to check that the callables are destroyed exactly once
+ */
+struct InstanceCounter {
+  std::shared_ptr<std::atomic<int>> live;
+  explicit InstanceCounter(std::shared_ptr<std::atomic<int>> live) : live(std::move(live)) { ++*this->live; }
+  InstanceCounter(const InstanceCounter &other) : live(other.live) { ++*live; }
+  InstanceCounter(InstanceCounter &&other) noexcept : live(other.live) { ++*live; }
+  ~InstanceCounter() { --*live; }
+};
+
+template <class Fn> void CheckMoveSemantics() {
+  auto live = std::make_shared<std::atomic<int>>(0);
+  {
+    auto value = std::make_unique<int>(42);
+    Fn f([counter = InstanceCounter(live), value = std::move(value)]() { return *value; });
+    EXPECT_EQ(f(), 42);
+
+    Fn moved(std::move(f));
+    EXPECT_EQ(moved(), 42);
+
+    Fn assigned;
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned(), 42);
+
+    assigned = Fn([]() { return 7; });
+    EXPECT_EQ(assigned(), 7);
+    EXPECT_EQ(live->load(), 0);
+  }
+  EXPECT_EQ(live->load(), 0);
+}
+} // namespace
+
+TEST(FunctionTest, InlineCallableMoveSemantics) { CheckMoveSemantics<Function<int()>>(); }
+
+TEST(FunctionTest, HeapCallableMoveSemantics) { CheckMoveSemantics<Function<int(), 1>>(); }
+
+TEST(FunctionTest, LargeCallableFallsBackToHeap) {
+  std::array<char, 256> large{};
+  large[255] = 'x';
+  Function<char()> f([large]() { return large[255]; });
+  Function<char()> moved(std::move(f));
+  EXPECT_EQ(moved(), 'x');
+}
+
+namespace {
+/**
+ * @brief Callable recording its own address when called
+ */
+template <std::size_t Size> struct AddressProbe {
+  const void **address;
+  std::array<char, Size> padding{};
+  void operator()() { *address = this; }
+};
+
+/**
+ * @brief Calls a Function whose callable records its address, and checks whether the callable lies in the Function
+ * itself, in which case it was not allocated
+ */
+template <class Fn> bool StoredInline(Fn &f, const void *&address) {
+  f();
+  const auto begin = reinterpret_cast<std::uintptr_t>(&f);
+  const auto callable = reinterpret_cast<std::uintptr_t>(address);
+  return callable >= begin && callable < begin + sizeof(f);
+}
+} // namespace
+
+TEST(FunctionTest, SmallCallableIsStoredInline) {
+  const void *address = nullptr;
+  Function<void()> f(AddressProbe<8>{&address});
+  EXPECT_TRUE(StoredInline(f, address));
+  Function<void()> moved(std::move(f));
+  EXPECT_TRUE(StoredInline(moved, address));
+
+  // The jobs spawned by the SDK capture a batch vector and a few references
+  int first = 0, second = 0;
+  Function<void()> job([&address, &first, &second, batch = std::vector<int>(16)]() mutable {
+    address = &batch;
+    first += second;
+  });
+  EXPECT_TRUE(StoredInline(job, address));
+}
+
+TEST(FunctionTest, LargeCallableIsAllocated) {
+  const void *address = nullptr;
+  Function<void()> f(AddressProbe<256>{&address});
+  EXPECT_FALSE(StoredInline(f, address));
+  Function<void(), 1> small_capacity(AddressProbe<8>{&address});
+  EXPECT_FALSE(StoredInline(small_capacity, address));
+}
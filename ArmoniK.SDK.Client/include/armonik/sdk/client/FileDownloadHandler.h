@@ -0,0 +1,92 @@
+#pragma once
+
+#include "armonik/sdk/client/IStreamingServiceInvocationHandler.h"
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace ArmoniK {
+namespace Sdk {
+namespace Client {
+
+/**
+ * @brief Task result handler downloading the results straight to files
+ *
+ * @details
+ * Each result is written to <directory>/<result id>.part as it is received, then renamed to <directory>/<result id>
+ * once complete and given to HandleFile. The file can then be read or memory mapped without ever holding the whole
+ * result in memory. Partial files are removed when a download fails.
+ */
+class FileDownloadHandler : public IStreamingServiceInvocationHandler {
+public:
+  /**
+   * @brief Creates a file download handler
+   * @param directory Directory in which the results are written, must exist
+   */
+  explicit FileDownloadHandler(std::string directory);
+
+  /**
+   * @brief Callback function called when a result has been completely written
+   * @param path Path to the result file, owned by the callee
+   * @param taskId Task Id
+   * @param result_id Blob ID of the result in ArmoniK storage
+   * @note Called concurrently for multiple tasks; implementation must be thread-safe.
+   */
+  virtual void HandleFile(const std::string &path, const std::string &taskId, const std::string &result_id) = 0;
+
+  /**
+   * @brief Callback function called when a task or the download of its result fails
+   * @param e Risen error
+   * @param taskId Task Id
+   * @note Called concurrently for multiple tasks; implementation must be thread-safe.
+   */
+  virtual void HandleFileError(const std::exception &e, const std::string &taskId) = 0;
+
+  void HandleResponseBegin(const std::string &taskId, const std::string &result_id) override;
+  void HandleResponseChunk(absl::string_view chunk, const std::string &taskId, const std::string &result_id) override;
+  void HandleResponseEnd(const std::string &taskId, const std::string &result_id) override;
+
+  /**
+   * @brief Removes the partial files of the task, then calls HandleFileError
+   * @param e Risen error
+   * @param taskId Task Id
+   */
+  void HandleError(const std::exception &e, const std::string &taskId) override;
+
+private:
+  /**
+   * @brief Download in progress
+   */
+  struct Download {
+    std::string task_id;
+    std::string path;
+    std::ofstream file;
+  };
+
+  /**
+   * @brief Gets the download in progress of a result
+   * @param result_id Result id
+   * @return Download
+   * @throws ArmoniKSdkException if the download of the result has not begun
+   */
+  Download &GetDownload(const std::string &result_id);
+
+  /**
+   * @brief Directory in which the results are written
+   */
+  std::string directory;
+
+  /**
+   * @brief Mutex protecting the downloads in progress
+   */
+  std::mutex mutex;
+
+  /**
+   * @brief Downloads in progress, by result id
+   */
+  std::map<std::string, Download> downloads;
+};
+} // namespace Client
+} // namespace Sdk
+} // namespace ArmoniK
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "armonik/sdk/client/IServiceInvocationHandler.h"
+#include <absl/strings/string_view.h>
+#include <string>
+
+namespace ArmoniK {
+namespace Sdk {
+namespace Client {
+
+/**
+ * @brief Task result handler receiving the result data incrementally
+ *
+ * @details
+ * When a handler implementing this interface is given to Submit, its results are not downloaded into memory: the
+ * chunks are delivered as they are received, so that results of any size can be processed with bounded memory.
+ * For a given result, HandleResponseBegin, HandleResponseChunk and HandleResponseEnd are called in this order from the
+ * same thread. Different results are handled concurrently, each one taking one of the download slots bounded by
+ * GrpcClient__MaxConcurrentDownloads until its last chunk has been handled.
+ *
+ * If the download fails after some chunks have been delivered, HandleError is called instead of HandleResponseEnd.
+ */
+class IStreamingServiceInvocationHandler : public IServiceInvocationHandler {
+public:
+  /**
+   * @brief Called before the first chunk of a result
+   * @param taskId Task Id
+   * @param result_id Blob ID of the result in ArmoniK storage
+   */
+  virtual void HandleResponseBegin(const std::string &taskId, const std::string &result_id) {
+    (void)taskId;
+    (void)result_id;
+  }
+
+  /**
+   * @brief Called for each chunk of a result, in order
+   * @param chunk Chunk of the result, only valid during the call
+   * @param taskId Task Id
+   * @param result_id Blob ID of the result in ArmoniK storage
+   */
+  virtual void HandleResponseChunk(absl::string_view chunk, const std::string &taskId,
+                                   const std::string &result_id) = 0;
+
+  /**
+   * @brief Called once all the chunks of a result have been delivered
+   * @param taskId Task Id
+   * @param result_id Blob ID of the result in ArmoniK storage
+   */
+  virtual void HandleResponseEnd(const std::string &taskId, const std::string &result_id) = 0;
+
+  /**
+   * @brief Delivers a whole result as a single chunk
+   * @param result_payload Task result
+   * @param taskId Task Id
+   * @param result_id Blob ID of the result in ArmoniK storage
+   */
+  void HandleResponse(const std::string &result_payload, const std::string &taskId,
+                      const std::string &result_id) override {
+    HandleResponseBegin(taskId, result_id);
+    HandleResponseChunk(result_payload, taskId, result_id);
+    HandleResponseEnd(taskId, result_id);
+  }
+};
+} // namespace Client
+} // namespace Sdk
+} // namespace ArmoniK
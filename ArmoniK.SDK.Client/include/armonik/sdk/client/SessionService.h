@@ -1,5 +1,7 @@
 #pragma once
 
+#include "TaskFuture.h"
+#include "TaskSubmitter.h"
 #include "WaitBehavior.h"
 #include <armonik/common/logger/formatter.h>
 #include <armonik/common/logger/logger.h>
@@ -16,6 +18,7 @@ struct TaskOptions;
 struct Properties;
 struct TaskPayload;
 struct TaskDefinition;
+struct BlobDefinition;
 struct DynamicLibrary;
 } // namespace Common
 } // namespace Sdk
@@ -84,7 +87,8 @@ public:
 
   /**
    * @brief Submits the given list of task definitions using the session's task options.
-   * Raw input data in each TaskDefinition is uploaded automatically before task submission.
+   * Raw input data in each TaskDefinition is uploaded automatically before task submission, identical contents being
+   * uploaded once per call (or once per session when GrpcClient__InputCache is enabled).
    * Callers do not need to pre-allocate result IDs or upload blobs manually.
    * @param requests List of task definitions
    * @param handler Result handler for this batch of requests
@@ -106,6 +110,51 @@ public:
   std::vector<std::string> Submit(const std::vector<Common::TaskDefinition> &requests,
                                   std::shared_ptr<IServiceInvocationHandler> handler);
 
+  /**
+   * @brief Submits the given list of task definitions and returns the future result of each task.
+   * Raw input data in each TaskDefinition is uploaded automatically before task submission.
+   * @param requests List of task definitions
+   * @param task_options Task options to use for this batch of requests
+   * @return Future results, in the order of the task definitions
+   * @note The results are waited for in the background: each future is ready as soon as its result is received,
+   * without calling WaitResults. The futures fail with an ArmoniKSdkException if the results cannot be waited for,
+   * after repeated or non-transient errors of the control plane, or once the session service is destroyed.
+   */
+  std::vector<TaskFuture> SubmitWithFutures(const std::vector<Common::TaskDefinition> &requests,
+                                            const ArmoniK::Sdk::Common::TaskOptions &task_options);
+
+  /**
+   * @brief Submits the given list of task definitions using the session's task options and returns the future result
+   * of each task.
+   * Raw input data in each TaskDefinition is uploaded automatically before task submission.
+   * @param requests List of task definitions
+   * @return Future results, in the order of the task definitions
+   * @note The results are waited for in the background: each future is ready as soon as its result is received,
+   * without calling WaitResults. The futures fail with an ArmoniKSdkException if the results cannot be waited for,
+   * after repeated or non-transient errors of the control plane, or once the session service is destroyed.
+   */
+  std::vector<TaskFuture> SubmitWithFutures(const std::vector<Common::TaskDefinition> &requests);
+
+  /**
+   * @brief Creates a streaming submitter: tasks are pushed one at a time and submitted in batches in the background
+   * @param handler Result handler of the submitted tasks
+   * @param task_options Task options of the submitted tasks
+   * @param max_in_flight Maximum number of tasks pushed but not yet submitted, 0 for a default of 4 batches
+   * @return Task submitter
+   * @note This SessionService must outlive the returned submitter
+   */
+  TaskSubmitter CreateSubmitter(std::shared_ptr<IServiceInvocationHandler> handler,
+                                const ArmoniK::Sdk::Common::TaskOptions &task_options, std::size_t max_in_flight = 0);
+
+  /**
+   * @brief Creates a streaming submitter using the session's task options
+   * @param handler Result handler of the submitted tasks
+   * @param max_in_flight Maximum number of tasks pushed but not yet submitted, 0 for a default of 4 batches
+   * @return Task submitter
+   * @note This SessionService must outlive the returned submitter
+   */
+  TaskSubmitter CreateSubmitter(std::shared_ptr<IServiceInvocationHandler> handler, std::size_t max_in_flight = 0);
+
   /**
    * @brief Uploads a shared library (.so) to ArmoniK blob storage and stores the resulting
    * blob ID in @p lib. After this call, @p lib is ready to be passed to
@@ -120,6 +169,51 @@ public:
    */
   void UploadLibrary(const std::string &library_path, Common::DynamicLibrary &lib);
 
+  /**
+   * @brief Uploads the given data as a blob of the session, to be referenced by any number of tasks
+   * @param data Content of the blob
+   * @return Definition referencing the uploaded blob, to be used as input of the submitted task definitions
+   */
+  Common::BlobDefinition UploadBlob(const std::string &data);
+
+  /**
+   * @brief Uploads the given data as blobs of the session, to be referenced by any number of tasks.
+   * Small blobs are created in batches, the others are streamed in parallel.
+   * @param data Contents of the blobs
+   * @return Definitions referencing the uploaded blobs, in the order of the contents
+   */
+  std::vector<Common::BlobDefinition> UploadBlobs(const std::vector<std::string> &data);
+
+  /**
+   * @brief Uploads the content of the given file as a blob of the session, to be referenced by any number of tasks.
+   * The file is read as it is uploaded, without being loaded as a whole.
+   * @param path Path of the file
+   * @return Definition referencing the uploaded blob, to be used as input of the submitted task definitions
+   */
+  Common::BlobDefinition UploadBlobFromFile(const std::string &path);
+
+  /**
+   * @brief Uploads the contents of the given files as blobs of the session, to be referenced by any number of tasks.
+   * Small blobs are created in batches, the others are streamed in parallel.
+   * @param paths Paths of the files
+   * @return Definitions referencing the uploaded blobs, in the order of the paths
+   */
+  std::vector<Common::BlobDefinition> UploadBlobsFromFiles(const std::vector<std::string> &paths);
+
+  /**
+   * @brief Deletes the data of the given uploaded blobs
+   * @param blobs Definitions returned by the UploadBlob functions
+   * @warning The data of these blobs will not be recoverable. Tasks which depend on these data will fail.
+   */
+  void CleanupBlobs(const std::vector<Common::BlobDefinition> &blobs);
+
+  /**
+   * @brief Deletes the data of all the blobs uploaded by this service and not cleaned up yet
+   * @warning The data of these blobs will not be recoverable. Tasks which depend on these data will fail.
+   * @note DropSession() deletes the data of the whole session, including the uploaded blobs
+   */
+  void CleanupBlobs();
+
   /**
    * @brief Waits for the completion of the given tasks
    * @param task_ids Task ids to wait on. If left empty, will wait for submitted tasks in
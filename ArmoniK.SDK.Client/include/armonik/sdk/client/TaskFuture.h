@@ -0,0 +1,49 @@
+#pragma once
+
+#include <future>
+#include <string>
+
+namespace ArmoniK {
+namespace Sdk {
+namespace Client {
+
+/**
+ * @brief Result of a successful task
+ */
+struct TaskResult {
+  /**
+   * @brief Task Id
+   */
+  std::string task_id;
+
+  /**
+   * @brief Blob ID of the result in ArmoniK storage; pass to BlobDefinition::FromBlobId to use this result as an input
+   * for a subsequent task without re-uploading
+   */
+  std::string result_id;
+
+  /**
+   * @brief Task result
+   */
+  std::string payload;
+};
+
+/**
+ * @brief Future result of a submitted task
+ */
+struct TaskFuture {
+  /**
+   * @brief Task Id
+   */
+  std::string task_id;
+
+  /**
+   * @brief Result of the task, ready as soon as the result is received
+   * @note get() rethrows the error of the task if it failed, such as an ArmoniKTaskError for an aborted task
+   */
+  std::future<TaskResult> result;
+};
+
+} // namespace Client
+} // namespace Sdk
+} // namespace ArmoniK
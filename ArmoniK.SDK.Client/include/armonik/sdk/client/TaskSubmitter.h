@@ -0,0 +1,85 @@
+#pragma once
+
+#include <future>
+#include <memory>
+#include <string>
+
+namespace ArmoniK {
+namespace Sdk {
+namespace Common {
+struct TaskDefinition;
+} // namespace Common
+} // namespace Sdk
+} // namespace ArmoniK
+
+namespace ArmoniK {
+namespace Sdk {
+namespace Client {
+namespace Internal {
+class TaskSubmitterImpl;
+}
+
+/**
+ * @brief Producer-style submitter, sending tasks in batches as soon as they are pushed
+ *
+ * @details
+ * Tasks are accumulated until a batch is full, and each full batch is submitted in the background while the producer
+ * keeps pushing new tasks. A partial batch is also submitted once its first task has waited for
+ * `GrpcClient__BatchFlushDelayMs`. The number of tasks pushed but not yet submitted is bounded: Push() blocks when
+ * this limit is reached.
+ *
+ * Created with SessionService::CreateSubmitter(). The SessionService must outlive its submitters.
+ */
+class TaskSubmitter {
+private:
+  std::unique_ptr<Internal::TaskSubmitterImpl> impl;
+  void ensure_valid() const;
+
+public:
+  /**
+   * @brief Creates a submitter from its implementation
+   * @param impl Implementation
+   */
+  explicit TaskSubmitter(std::unique_ptr<Internal::TaskSubmitterImpl> impl);
+  TaskSubmitter(const TaskSubmitter &) = delete;
+  TaskSubmitter &operator=(const TaskSubmitter &) = delete;
+  /**
+   * @brief Move constructor
+   * @param other Other submitter
+   */
+  TaskSubmitter(TaskSubmitter &&other) noexcept;
+  /**
+   * @brief Move assignment operator
+   * @param other Other submitter
+   * @return this
+   */
+  TaskSubmitter &operator=(TaskSubmitter &&other) noexcept;
+
+  /**
+   * @brief Closes the submitter, waiting for all pushed tasks to be submitted
+   */
+  ~TaskSubmitter();
+
+  /**
+   * @brief Pushes a task to be submitted
+   * @param task Task definition
+   * @return Future holding the task id once the task has been submitted
+   * @note Blocks while the maximum number of in-flight tasks is reached
+   * @throw std::runtime_error if the submitter is closed
+   */
+  std::future<std::string> Push(Common::TaskDefinition task);
+
+  /**
+   * @brief Submits the pending partial batch without waiting for it to be full
+   */
+  void Flush();
+
+  /**
+   * @brief Submits the pending tasks and waits for all pushed tasks to be submitted
+   * @note No task can be pushed after this call
+   */
+  void Close();
+};
+} // namespace Client
+} // namespace Sdk
+} // namespace ArmoniK
@@ -17,6 +17,25 @@ struct WaitOptions {
    * @brief Timeout before returning in milliseconds
    */
   unsigned int timeout = UINT_MAX;
+
+  /**
+   * @brief Subscribe to the ArmoniK events stream to be notified of result completion instead of polling
+   * @note Polling is still used if the events stream is unavailable or fails
+   */
+  bool use_events = false;
+
+  /**
+   * @brief Time in milliseconds between full status resynchronizations when using events
+   * @note Catches the results that completed before the subscription was established
+   */
+  unsigned int events_resync_ms = 30000;
+
+  /**
+   * @brief Time in milliseconds between full status checks of the waited results
+   * @note Between them, only the results completed since the last check are listed. The results aborted without
+   * completion date are found by these checks or by the events stream.
+   */
+  unsigned int reconcile_ms = 10000;
 };
 
 enum WaitBehavior {
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "ChannelPool.h"
+#include "ThreadPool.h"
+#include <armonik/common/exceptions/ArmoniKApiException.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/support/status.h>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace ArmoniK {
+namespace Sdk {
+namespace Client {
+namespace Internal {
+
+/**
+ * @brief Error of a failed RPC, keeping its status code
+ */
+class RpcError : public armonik::api::common::exceptions::ArmoniKApiException {
+public:
+  /**
+   * @brief Creates the error of a call
+   * @param description Description of the call
+   * @param status Status of the call
+   */
+  RpcError(const std::string &description, const grpc::Status &status)
+      : ArmoniKApiException(description + ": " + status.error_message()), code_(status.error_code()) {}
+
+  /**
+   * @brief Status code of the call
+   */
+  grpc::StatusCode Code() const { return code_; }
+
+  /**
+   * @brief Whether the same call may succeed later, the failure being transient such as an unavailable server
+   */
+  bool IsRetryable() const {
+    switch (code_) {
+    case grpc::StatusCode::UNKNOWN:
+    case grpc::StatusCode::DEADLINE_EXCEEDED:
+    case grpc::StatusCode::RESOURCE_EXHAUSTED:
+    case grpc::StatusCode::ABORTED:
+    case grpc::StatusCode::INTERNAL:
+    case grpc::StatusCode::UNAVAILABLE:
+      return true;
+    default:
+      return false;
+    }
+  }
+
+private:
+  grpc::StatusCode code_;
+};
+
+/**
+ * @brief State of an unary RPC in flight, kept alive until its continuation has run
+ *
+ * @tparam Request The request type
+ * @tparam Response The response type
+ * @tparam Continuation The function called with the response
+ */
+template <class Request, class Response, class Continuation> struct AsyncUnaryCall {
+  /**
+   * @brief The operation in the join set, declared first to be completed after everything else is destroyed
+   */
+  ThreadPool::JoinSet::Pending pending;
+
+  /**
+   * @brief The connection whose stub is used by the call
+   */
+  std::shared_ptr<ChannelPool::Connection> connection;
+
+  /**
+   * @brief The context of the call
+   */
+  grpc::ClientContext context;
+
+  /**
+   * @brief The request
+   */
+  Request request;
+
+  /**
+   * @brief The response, filled by gRPC
+   */
+  Response response;
+
+  /**
+   * @brief The function called with the response
+   */
+  Continuation continuation;
+
+  /**
+   * @brief Description of the call for the error messages
+   */
+  std::string description;
+
+  /**
+   * @brief Function called with the outcome of the call, if any
+   */
+  std::function<void(bool, std::chrono::nanoseconds)> observer;
+
+  /**
+   * @brief Start time of the call
+   */
+  std::chrono::steady_clock::time_point start;
+
+  /**
+   * @brief Creates the state of a call
+   */
+  AsyncUnaryCall(ThreadPool::JoinSet::Pending &&pending, Request &&request, Continuation &&continuation,
+                 std::string &&description, std::function<void(bool, std::chrono::nanoseconds)> &&observer)
+      : pending(std::move(pending)), request(std::move(request)), continuation(std::move(continuation)),
+        description(std::move(description)), observer(std::move(observer)) {}
+};
+
+/**
+ * @brief Start an unary RPC without blocking the calling thread
+ *
+ * @details
+ * The call is started with the gRPC callback API on a connection of the pool, which is released to the pool as soon
+ * as the call has started: the call keeps the connection alive, and concurrent calls are multiplexed on its channel.
+ * Once the response is received, the continuation is spawned on the join set. The join set waits for the call as for
+ * any of its tasks, and a failed call is reported by JoinSet::Wait(), but no thread of the pool is blocked while the
+ * call is in flight, so that the number of concurrent calls is not bounded by the size of the pool.
+ *
+ * @tparam Response The response type
+ * @param pool The channel pool
+ * @param join_set The join set on which the continuation is spawned
+ * @param request The request
+ * @param start Function starting the call, given the connection, the context, the request, the response and the
+ * completion callback, as in start(connection, &context, &request, &response, std::move(on_done))
+ * @param continuation Function called on the pool with the response, as continuation(std::move(response))
+ * @param description Description of the call for the error messages
+ * @param observer Function called on the gRPC thread with whether the call succeeded and its latency, before the
+ * continuation is spawned, as observer(ok, latency)
+ */
+template <class Response, class Request, class Start, class Continuation>
+void AsyncUnary(ChannelPool &pool, ThreadPool::JoinSet &join_set, Request request, Start &&start,
+                Continuation continuation, std::string description,
+                std::function<void(bool, std::chrono::nanoseconds)> observer = nullptr) {
+  using Call = AsyncUnaryCall<Request, Response, Continuation>;
+  auto call = std::make_shared<Call>(join_set.Track(), std::move(request), std::move(continuation),
+                                     std::move(description), std::move(observer));
+  auto guard = pool.GetChannel();
+  call->connection = guard.connection;
+
+  call->start = std::chrono::steady_clock::now();
+  start(*call->connection, &call->context, &call->request, &call->response, [call](grpc::Status status) {
+    // Runs on a gRPC thread: only hand the response over to the pool
+    if (call->observer) {
+      call->observer(status.ok(), std::chrono::steady_clock::now() - call->start);
+    }
+    if (!status.ok()) {
+      call->pending.Fail(std::make_exception_ptr(RpcError(call->description, status)));
+      return;
+    }
+    call->pending.Then([call]() { call->continuation(std::move(call->response)); });
+  });
+}
+
+} // namespace Internal
+} // namespace Client
+} // namespace Sdk
+} // namespace ArmoniK
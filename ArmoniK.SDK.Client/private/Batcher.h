@@ -1,13 +1,111 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <vector>
+
 namespace ArmoniK {
 namespace Sdk {
 namespace Client {
 namespace Internal {
 
+/**
+ * @brief Adaptive limit of the number of requests per batch
+ *
+ * @details
+ * The limit follows an additive increase / multiplicative decrease rule fed with the outcome of the batched calls: a
+ * full batch completed within the target latency raises the limit by a step, while a failed batch, or a batch slower
+ * than the target, halves it. The batches larger than the current limit were sent before a decrease and are not
+ * counted again. The limit stays between the minimum and the maximum.
+ */
+class BatchSizeController {
+public:
+  /**
+   * @brief Observer of a batched call, called with whether the call succeeded and its latency
+   */
+  using Observer = std::function<void(bool, std::chrono::nanoseconds)>;
+
+  /**
+   * @brief Creates a controller
+   * @param initial Initial limit
+   * @param min Minimum limit
+   * @param max Maximum limit
+   * @param target_latency Latency above which the limit is decreased, 0 to keep the initial limit
+   */
+  BatchSizeController(std::size_t initial, std::size_t min, std::size_t max, std::chrono::milliseconds target_latency)
+      : min_(std::max<std::size_t>(std::min(min, initial), 1)), max_(std::max(max, initial)),
+        step_((max_ - min_) / 32 + 1), target_latency_(target_latency),
+        limit_(std::max<std::size_t>(initial, 1)) {}
+
+  /**
+   * @brief Copy constructor, copying the current limit
+   */
+  BatchSizeController(const BatchSizeController &other)
+      : min_(other.min_), max_(other.max_), step_(other.step_), target_latency_(other.target_latency_),
+        limit_(other.Limit()) {}
+  BatchSizeController &operator=(const BatchSizeController &) = delete;
+
+  /**
+   * @brief Current limit
+   */
+  std::size_t Limit() const { return limit_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Adjust the limit with the outcome of a batched call
+   * @param items Number of requests of the batch
+   * @param ok Whether the call succeeded
+   * @param latency Latency of the call
+   */
+  void Record(std::size_t items, bool ok, std::chrono::nanoseconds latency) {
+    if (target_latency_.count() == 0) {
+      return;
+    }
+    auto limit = limit_.load(std::memory_order_relaxed);
+    std::size_t next;
+    do {
+      if (!ok || latency > target_latency_) {
+        if (items > limit) {
+          return;
+        }
+        next = std::max(limit / 2, min_);
+      } else if (items >= limit) {
+        next = std::min(limit + step_, max_);
+      } else {
+        // A partial batch tells nothing about larger ones
+        return;
+      }
+    } while (next != limit && !limit_.compare_exchange_weak(limit, next, std::memory_order_relaxed));
+  }
+
+  /**
+   * @brief Observer recording the outcome of a batched call
+   * @param items Number of requests of the batch
+   */
+  Observer Observe(std::size_t items) {
+    return [this, items](bool ok, std::chrono::nanoseconds latency) { Record(items, ok, latency); };
+  }
+
+private:
+  std::size_t min_;
+  std::size_t max_;
+
+  /**
+   * @brief Additive increase, reaching the maximum from the minimum in about 32 batches
+   */
+  std::size_t step_;
+  std::chrono::nanoseconds target_latency_;
+  std::atomic<std::size_t> limit_;
+};
+
 /**
  * @brief A helper class to batch requests
  *
+ * @details
+ * A batch is processed once it holds the number of requests allowed by the batch size, or a controller when given.
+ * When a maximum number of bytes is given, a batch is also processed before a request would make it reach that size.
+ *
  * @tparam Request The request type
  */
 template <class Request> class Batcher {
@@ -16,6 +114,21 @@ private:
    * @brief The batch size
    */
   std::size_t batch_size_;
+
+  /**
+   * @brief The controller giving the batch size, if any
+   */
+  BatchSizeController *controller_ = nullptr;
+
+  /**
+   * @brief The maximum number of bytes of a batch, 0 for no limit
+   */
+  std::size_t max_bytes_ = 0;
+
+  /**
+   * @brief The number of bytes of the current requests
+   */
+  std::size_t bytes_ = 0;
   /**
    * @brief The current requests
    */
@@ -37,6 +150,18 @@ public:
     requests_.reserve(batch_size_);
   }
 
+  /**
+   * @brief Construct a new Batcher object whose batch size is given by a controller
+   *
+   * @param controller The controller of the batch size, which must outlive the batcher
+   * @param f The function to process a batch
+   * @param max_bytes The maximum number of bytes of a batch, 0 for no limit
+   */
+  Batcher(BatchSizeController &controller, std::function<void(std::vector<Request> &&)> f, std::size_t max_bytes = 0)
+      : batch_size_(controller.Limit()), controller_(&controller), max_bytes_(max_bytes), f_(std::move(f)) {
+    requests_.reserve(batch_size_);
+  }
+
   /**
    * @brief Copy constructor
    */
@@ -70,14 +195,24 @@ public:
    * @brief Add a request to the batcher, processing the batch if full
    *
    * @param request The request to add
+   * @param bytes The size of the request, counted against the maximum number of bytes
    */
-  void Add(Request request) {
+  void Add(Request request, std::size_t bytes = 0) {
+    if (max_bytes_ > 0 && bytes_ + bytes >= max_bytes_) {
+      ProcessBatch();
+    }
     requests_.push_back(static_cast<Request &&>(request));
-    if (requests_.size() >= batch_size_) {
+    bytes_ += bytes;
+    if (requests_.size() >= BatchSize()) {
       ProcessBatch();
     }
   }
 
+  /**
+   * @brief The current batch size
+   */
+  std::size_t BatchSize() const { return controller_ ? controller_->Limit() : batch_size_; }
+
   /**
    * @brief Process all the pending requests
    */
@@ -88,7 +223,8 @@ public:
 
     f_(std::move(requests_));
     requests_.clear();
-    requests_.reserve(batch_size_);
+    requests_.reserve(BatchSize());
+    bytes_ = 0;
   }
 };
 
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <absl/strings/string_view.h>
+#include <cstddef>
+#ifdef _WIN32
+#include <fstream>
+#endif
+#include <memory>
+#include <string>
+
+namespace ArmoniK {
+namespace Sdk {
+namespace Client {
+namespace Internal {
+
+/**
+ * @brief Content of a blob to upload, read part by part
+ *
+ * @details
+ * A source either views data held in memory, or reads a file as it is uploaded so that the file is never copied as a
+ * whole into the process memory. The file is mapped in memory on POSIX systems, and read through a file stream on
+ * Windows. Copies of a source share the same mapping or stream: a source must not be read by several threads at once.
+ *
+ * @warning Reading a mapped page past the end of a file raises SIGBUS, which kills the process. The size of the file
+ * is checked before each part is read, which detects a file truncated between two parts but not during the read of a
+ * part: the files must not be modified until their upload completes.
+ */
+class BlobSource {
+public:
+  /**
+   * @brief Create a source viewing data in memory
+   * @param data Content of the blob, which must outlive the source
+   * @return The source
+   */
+  static BlobSource FromData(absl::string_view data);
+
+  /**
+   * @brief Create a source reading a file
+   * @param path Path of the file, whose size is read immediately
+   * @return The source
+   * @throws ArmoniKSdkException if the file cannot be opened
+   */
+  static BlobSource FromFile(std::string path);
+
+  /**
+   * @brief Size of the content in bytes
+   */
+  [[nodiscard]] std::size_t Size() const { return size_; }
+
+  /**
+   * @brief Read a part of the content
+   * @param offset Offset of the part
+   * @param length Length of the part, offset + length must not exceed Size()
+   * @param buffer Buffer which may be used to hold the part
+   * @return View of the part, valid until the buffer is modified or the next read
+   * @throws ArmoniKSdkException if the file cannot be mapped or read, or if its size has changed
+   * @note The file is opened by the first read and closed by the read of its last part, which is copied into the
+   * buffer
+   */
+  absl::string_view Read(std::size_t offset, std::size_t length, std::string &buffer) const;
+
+private:
+  BlobSource() = default;
+
+  absl::string_view data_;
+  std::string path_;
+  std::size_t size_ = 0;
+#ifdef _WIN32
+  mutable std::shared_ptr<std::ifstream> file_;
+#else
+  struct Mapping;
+  mutable std::shared_ptr<const Mapping> mapping_;
+#endif
+};
+
+} // namespace Internal
+} // namespace Client
+} // namespace Sdk
+} // namespace ArmoniK
@@ -1,12 +1,18 @@
 #pragma once
 
+#include <armonik/client/channel/ChannelFactory.h>
+#include <armonik/client/results_service.grpc.pb.h>
+#include <armonik/client/sessions_service.grpc.pb.h>
+#include <armonik/client/tasks_service.grpc.pb.h>
 #include <armonik/common/logger/formatter.h>
 #include <armonik/common/logger/logger.h>
 #include <armonik/common/logger/writer.h>
 #include <armonik/sdk/common/Properties.h>
+#include <condition_variable>
 #include <grpcpp/channel.h>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <vector>
 
 namespace ArmoniK {
 namespace Sdk {
@@ -14,9 +20,85 @@ namespace Client {
 namespace Internal {
 /**
  * @brief A pool for Grpc channels
+ *
+ * @details
+ * Each pooled channel comes with the stubs of the ArmoniK services, built once when the channel is created, so that
+ * the calls do not create a stub each.
+ *
+ * A channel is one HTTP/2 connection which multiplexes its streams, so it is shared by up to max_streams_per_channel
+ * acquirers: the least used healthy channel is given out, and a new channel is only opened when all of them are full.
+ * Once max_channels channels are open, acquirers wait for a stream to be released. Channels in failure are dropped as
+ * soon as they are no longer used.
  */
 class ChannelPool {
 public:
+  /**
+   * @brief A channel and the stubs of the services using it
+   * @note Stubs are thread-safe: a connection may still be used by asynchronous calls once released to the pool
+   */
+  struct Connection {
+    /**
+     * @brief Creates the stubs for the given channel
+     * @param channel The gRPC channel
+     */
+    explicit Connection(std::shared_ptr<grpc::Channel> channel);
+
+    /**
+     * @brief The gRPC channel
+     */
+    std::shared_ptr<grpc::Channel> channel;
+
+    /**
+     * @brief Stub of the Results service
+     */
+    std::unique_ptr<armonik::api::grpc::v1::results::Results::Stub> results;
+
+    /**
+     * @brief Stub of the Tasks service
+     */
+    std::unique_ptr<armonik::api::grpc::v1::tasks::Tasks::Stub> tasks;
+
+    /**
+     * @brief Stub of the Sessions service
+     */
+    std::unique_ptr<armonik::api::grpc::v1::sessions::Sessions::Stub> sessions;
+
+    /**
+     * @brief Number of acquirers currently using the connection, protected by the mutex of the pool
+     */
+    std::size_t leases = 0;
+  };
+
+  /**
+   * @brief Occupancy of the pool
+   */
+  struct Stats {
+    /**
+     * @brief Number of open channels
+     */
+    std::size_t channels;
+
+    /**
+     * @brief Number of channels being opened
+     */
+    std::size_t connecting;
+
+    /**
+     * @brief Number of streams currently acquired over all the channels
+     */
+    std::size_t leases;
+
+    /**
+     * @brief Number of acquirers waiting for a free stream
+     */
+    std::size_t waiting;
+
+    /**
+     * @brief Number of channels opened since the creation of the pool
+     */
+    std::size_t created;
+  };
+
   /**
    * @brief Creates a channel pool from the given properties
    * @param properties Properties
@@ -38,26 +120,32 @@ public:
   ChannelPool &operator=(const ChannelPool &) = delete;
 
   /**
-   * @brief Move constructor
+   * @brief Destroy the Channel Pool object
    *
-   * @param other Other channel pool
    */
-  ChannelPool(ChannelPool &&other) noexcept = default;
+  ~ChannelPool();
+
+  /**
+   * @brief Opens the minimum number of channels and starts connecting them, without waiting for the connections
+   */
+  void Prewarm();
+
   /**
-   * @brief Move assignment constructor
+   * @brief Acquires a connection from the pool, opening a new one if all are full, or waiting if none can be opened
    *
-   * @param other Other channel pool
+   * @return The connection
    */
-  ChannelPool &operator=(ChannelPool &&other) noexcept = default;
+  std::shared_ptr<Connection> AcquireConnection();
 
   /**
-   * @brief Destroy the Channel Pool object
+   * @brief Releases a connection to the pool
    *
+   * @param connection The connection
    */
-  ~ChannelPool();
+  void ReleaseConnection(std::shared_ptr<Connection> connection);
 
   /**
-   * @brief
+   * @brief Acquires a channel from the pool
    *
    * @return std::shared_ptr<grpc::Channel>
    */
@@ -79,6 +167,13 @@ public:
    */
   static bool ShutdownOnFailure(std::shared_ptr<grpc::Channel> channel);
 
+  /**
+   * @brief Get the occupancy of the pool
+   *
+   * @return Stats
+   */
+  Stats GetStats();
+
   /**
    * Calls the function with an acquired channel
    * The function must take a std::shared_ptr<::grpc::Channel> as a first argument
@@ -94,6 +189,41 @@ public:
     return f(guard.channel, static_cast<Args &&>(args)...);
   }
 
+  /**
+   * @brief Calls the function with the Results stub of an acquired channel
+   * @tparam F function type, taking an armonik::api::grpc::v1::results::Results::Stub &
+   * @param f function to call
+   * @return what the function returns
+   */
+  template <typename F>
+  typename std::result_of<F(armonik::api::grpc::v1::results::Results::Stub &)>::type WithResults(F f) {
+    auto guard = GetChannel();
+    return f(*guard.connection->results);
+  }
+
+  /**
+   * @brief Calls the function with the Tasks stub of an acquired channel
+   * @tparam F function type, taking an armonik::api::grpc::v1::tasks::Tasks::Stub &
+   * @param f function to call
+   * @return what the function returns
+   */
+  template <typename F> typename std::result_of<F(armonik::api::grpc::v1::tasks::Tasks::Stub &)>::type WithTasks(F f) {
+    auto guard = GetChannel();
+    return f(*guard.connection->tasks);
+  }
+
+  /**
+   * @brief Calls the function with the Sessions stub of an acquired channel
+   * @tparam F function type, taking an armonik::api::grpc::v1::sessions::Sessions::Stub &
+   * @param f function to call
+   * @return what the function returns
+   */
+  template <typename F>
+  typename std::result_of<F(armonik::api::grpc::v1::sessions::Sessions::Stub &)>::type WithSessions(F f) {
+    auto guard = GetChannel();
+    return f(*guard.connection->sessions);
+  }
+
   /**
    * @brief Helper class that acquires a channel from a pool when constructed, and releases it when disposed
    *
@@ -106,6 +236,12 @@ public:
      */
     std::shared_ptr<grpc::Channel> channel;
 
+    /**
+     * @brief Acquired connection, holding the channel and its stubs
+     *
+     */
+    std::shared_ptr<Connection> connection;
+
     /**
      * @brief Construct a new Channel Guard object
      *
@@ -114,7 +250,24 @@ public:
     ChannelGuard(Internal::ChannelPool *pool);
 
     /**
-     * @brief Destroy the Channel Guard object
+     * @brief Copy constructor (deleted), the connection being released once
+     */
+    ChannelGuard(const ChannelGuard &) = delete;
+
+    /**
+     * @brief Copy assignment operator (deleted)
+     */
+    ChannelGuard &operator=(const ChannelGuard &) = delete;
+
+    /**
+     * @brief Move constructor, the moved guard no longer releasing the connection
+     *
+     * @param other the guard to take the connection from
+     */
+    ChannelGuard(ChannelGuard &&other) noexcept;
+
+    /**
+     * @brief Destroy the Channel Guard object, releasing its connection to the pool
      *
      */
     ~ChannelGuard();
@@ -138,10 +291,26 @@ public:
   ChannelGuard GetChannel();
 
 private:
+  /**
+   * @brief Opens a new channel, counted as connecting until it is added to the pool
+   * @param lock Lock on the mutex of the pool, released while the channel is created
+   * @return The connection, already added to the pool
+   */
+  std::shared_ptr<Connection> OpenConnection(std::unique_lock<std::mutex> &lock);
+
   ArmoniK::Sdk::Common::Properties properties_;
-  std::queue<std::shared_ptr<grpc::Channel>> channel_pool_;
-  std::mutex channel_mutex_;
   armonik::api::common::logger::LocalLogger logger_;
+  armonik::api::client::ChannelFactory channel_factory_;
+  std::mutex factory_mutex_;
+  std::size_t min_channels_;
+  std::size_t max_channels_;
+  std::size_t max_streams_per_channel_;
+  std::vector<std::shared_ptr<Connection>> channel_pool_;
+  std::size_t connecting_ = 0;
+  std::size_t waiting_ = 0;
+  std::size_t created_ = 0;
+  std::mutex channel_mutex_;
+  std::condition_variable channel_released_;
 };
 
 } // namespace Internal
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+
+namespace ArmoniK {
+namespace Sdk {
+namespace Client {
+namespace Internal {
+
+/**
+ * @brief Digest identifying a blob content
+ *
+ * @details
+ * Combines the size of the content with two independent 64 bits hashes: the standard string hash, and a word-at-a-time
+ * multiplicative hash. The hashes are not cryptographic: the digests only select the candidate contents, which are then
+ * compared byte for byte.
+ */
+struct ContentDigest {
+  std::size_t size = 0;
+  std::size_t hash = 0;
+  std::uint64_t mix = 0;
+
+  /**
+   * @brief Compute the digest of a content
+   * @param data The content
+   * @return The digest
+   */
+  static ContentDigest Of(const std::string &data) {
+    ContentDigest digest;
+    digest.size = data.size();
+    digest.hash = std::hash<std::string>()(data);
+
+    const std::uint64_t multiplier = 0x9E3779B97F4A7C15ULL;
+    std::uint64_t mix = 0xCBF29CE484222325ULL ^ data.size();
+    std::size_t i = 0;
+    for (; i + sizeof(std::uint64_t) <= data.size(); i += sizeof(std::uint64_t)) {
+      std::uint64_t word;
+      std::memcpy(&word, data.data() + i, sizeof(word));
+      mix = (mix ^ word) * multiplier;
+      mix ^= mix >> 32;
+    }
+    for (; i < data.size(); ++i) {
+      mix = (mix ^ static_cast<unsigned char>(data[i])) * multiplier;
+    }
+    digest.mix = mix ^ (mix >> 29);
+    return digest;
+  }
+
+  bool operator==(const ContentDigest &other) const {
+    return size == other.size && hash == other.hash && mix == other.mix;
+  }
+
+  /**
+   * @brief Hasher to use the digests as keys of unordered containers
+   */
+  struct Hash {
+    std::size_t operator()(const ContentDigest &digest) const { return digest.hash; }
+  };
+};
+
+} // namespace Internal
+} // namespace Client
+} // namespace Sdk
+} // namespace ArmoniK
@@ -4,9 +4,13 @@
 #include <armonik/common/logger/logger.h>
 #include <armonik/common/logger/writer.h>
 #include <condition_variable>
+#include <cstddef>
 #include <functional>
+#include <memory>
 #include <mutex>
+#include <new>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 namespace ArmoniK {
@@ -14,20 +18,32 @@ namespace Sdk {
 namespace Client {
 namespace Internal {
 
+/**
+ * @brief Default inline storage capacity of Function, in bytes
+ *
+ * Large enough for the jobs spawned by the SDK, which capture a batch vector and a few references.
+ */
+constexpr std::size_t FunctionDefaultCapacity = 64;
+
 /**
  * @brief A type-erased function wrapper
  *
  * @tparam Signature The function signature
+ * @tparam Capacity Size of the inline storage, in bytes
  */
-template <class> class Function;
+template <class, std::size_t Capacity = FunctionDefaultCapacity> class Function;
 
 /**
- * @brief A type-erased function wrapper
+ * @brief A type-erased, move-only function wrapper with small buffer optimization
+ *
+ * Callables that fit in Capacity bytes, with a compatible alignment and a non-throwing move constructor, are stored
+ * inline without any allocation. Larger callables are allocated on the heap.
  *
  * @tparam Ret The return type
  * @tparam Args The argument types
+ * @tparam Capacity Size of the inline storage, in bytes
  */
-template <class Ret, class... Args> class Function<Ret(Args...)> {
+template <class Ret, class... Args, std::size_t Capacity> class Function<Ret(Args...), Capacity> {
 private:
   /**
    * @brief Type-erased callable interface
@@ -42,6 +58,13 @@ private:
      * @brief Call the function
      */
     virtual Ret call(Args... args) = 0;
+
+    /**
+     * @brief Move the callable into the given inline storage
+     * @param storage Inline storage of another Function
+     * @return The moved callable
+     */
+    virtual Callable *move_to(void *storage) noexcept = 0;
   };
 
   /**
@@ -51,13 +74,66 @@ private:
     F f_;
     explicit Impl(F f) : f_(std::move(f)) {}
     Ret call(Args... args) override { return f_(static_cast<Args &&>(args)...); }
+    Callable *move_to(void *storage) noexcept override { return new (storage) Impl(std::move(f_)); }
   };
 
+  /**
+   * @brief Whether a callable of type F is stored inline
+   */
+  template <class F>
+  static constexpr bool fits_inline = sizeof(Impl<F>) <= Capacity && alignof(Impl<F>) <= alignof(std::max_align_t) &&
+                                      std::is_nothrow_move_constructible<F>::value;
+
 private:
   /**
-   * @brief The type-erased callable
+   * @brief The type-erased callable, pointing either to the inline storage or to the heap
+   */
+  Callable *callable_ = nullptr;
+
+  /**
+   * @brief Inline storage for small callables
+   */
+  alignas(std::max_align_t) unsigned char storage_[Capacity > 0 ? Capacity : 1];
+
+  /**
+   * @brief Whether the callable is stored inline
+   */
+  bool is_inline() const noexcept { return callable_ == reinterpret_cast<const Callable *>(storage_); }
+
+  /**
+   * @brief Take the callable of another function, leaving it empty
+   */
+  void take(Function &other) noexcept {
+    if (other.is_inline()) {
+      callable_ = other.callable_->move_to(storage_);
+      other.reset();
+    } else {
+      callable_ = other.callable_;
+      other.callable_ = nullptr;
+    }
+  }
+
+  /**
+   * @brief Destroy the callable, if any
+   */
+  void reset() noexcept {
+    if (is_inline()) {
+      callable_->~Callable();
+    } else {
+      delete callable_;
+    }
+    callable_ = nullptr;
+  }
+
+  /**
+   * @brief Store a small callable inline
+   */
+  template <class F> void emplace(F &&f, std::true_type) { callable_ = new (storage_) Impl<F>(std::move(f)); }
+
+  /**
+   * @brief Store a large callable on the heap
    */
-  std::unique_ptr<Callable> callable_{};
+  template <class F> void emplace(F &&f, std::false_type) { callable_ = new Impl<F>(std::move(f)); }
 
 public:
   /**
@@ -68,7 +144,7 @@ public:
   /**
    * @brief Constructs a Function from a callable
    */
-  template <class F> Function(F f) : callable_(std::make_unique<Impl<F>>(std::move(f))) {}
+  template <class F> Function(F f) { emplace(std::move(f), std::integral_constant<bool, fits_inline<F>>{}); }
 
   /**
    * @brief Copy constructor (deleted)
@@ -82,16 +158,22 @@ public:
   /**
    * @brief Move constructor
    */
-  Function(Function &&other) noexcept = default;
+  Function(Function &&other) noexcept { take(other); }
   /**
    * @brief Move assignment operator
    */
-  Function &operator=(Function &&other) noexcept = default;
+  Function &operator=(Function &&other) noexcept {
+    if (this != &other) {
+      reset();
+      take(other);
+    }
+    return *this;
+  }
 
   /**
    * @brief Destructor
    */
-  ~Function() = default;
+  ~Function() { reset(); }
 
   /**
    * @brief Call the function
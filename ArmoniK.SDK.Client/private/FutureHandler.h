@@ -0,0 +1,100 @@
+#pragma once
+
+#include "armonik/sdk/client/IServiceInvocationHandler.h"
+#include "armonik/sdk/client/TaskFuture.h"
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace ArmoniK {
+namespace Sdk {
+namespace Client {
+namespace Internal {
+
+/**
+ * @brief Task result handler fulfilling a promise per task
+ *
+ * @details
+ * The result of a task may be handled before its future is requested, as the tasks are known to the result tracker as
+ * soon as they are submitted: whichever comes first creates the promise of the task, which is forgotten once both the
+ * result and the future have been handed over.
+ */
+class FutureHandler : public IServiceInvocationHandler {
+public:
+  /**
+   * @brief Get the future result of a task
+   * @param task_id Task id
+   * @return The future result
+   * @note Can only be called once per task
+   */
+  std::future<TaskResult> Future(const std::string &task_id);
+
+  /**
+   * @brief Fulfill the promise of a task with its result
+   */
+  void HandleResponse(const std::string &result_payload, const std::string &taskId,
+                      const std::string &result_id) override;
+
+  /**
+   * @brief Fail the promise of a task with its error
+   * @note The error is stored with its dynamic type when called while it is being handled, as the session service
+   * does
+   */
+  void HandleError(const std::exception &e, const std::string &taskId) override;
+
+  /**
+   * @brief Fail the promise of a task whose result will never be handled
+   * @param task_id Task id
+   * @param reason Reason of the failure
+   */
+  void Discard(const std::string &task_id, const std::string &reason);
+
+  /**
+   * @brief Fail the promises of all the tasks whose result has not been handled
+   * @param reason Reason of the failure
+   */
+  void DiscardAll(const std::string &reason);
+
+  /**
+   * @brief Check if futures are still waiting for the result of their task
+   */
+  bool HasPending();
+
+private:
+  /**
+   * @brief Promise of a task
+   */
+  struct Entry {
+    std::promise<TaskResult> promise;
+    bool has_future = false;
+    bool done = false;
+  };
+
+  /**
+   * @brief Complete the promise of a task with f, unless already done. Called with the mutex held.
+   */
+  template <class F> void Complete(const std::string &task_id, F &&f);
+
+  /**
+   * @brief Promises by task id
+   */
+  std::unordered_map<std::string, Entry> entries_;
+
+  /**
+   * @brief Number of futures whose promise is not done
+   */
+  std::size_t pending_ = 0;
+
+  /**
+   * @brief Mutex protecting the promises
+   */
+  std::mutex mutex_;
+};
+
+} // namespace Internal
+} // namespace Client
+} // namespace Sdk
+} // namespace ArmoniK
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "ContentDigest.h"
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace ArmoniK {
+namespace Sdk {
+namespace Client {
+namespace Internal {
+
+/**
+ * @brief Ids of the results holding the raw inputs already uploaded in a session, by content
+ *
+ * @details
+ * Entries are found by digest, then the bytes of the cached content are compared with the searched one, so that a
+ * digest collision never substitutes another input. The cache keeps the contents alive to compare them, sharing the
+ * buffers of the blob definitions, and evicts the least recently used entries once their total size exceeds the limit.
+ */
+class InputCache {
+public:
+  /**
+   * @brief Creates an empty cache
+   * @param max_size Maximum total size of the cached contents in bytes, 0 disabling the cache
+   */
+  explicit InputCache(std::size_t max_size);
+
+  /**
+   * @brief Find the result holding a content
+   * @param digest Digest of the content
+   * @param data The content
+   * @return Id of the result, empty if the content is not cached
+   */
+  std::string Find(const ContentDigest &digest, const std::string &data);
+
+  /**
+   * @brief Add the result holding a content, evicting the least recently used entries above the size limit
+   * @param digest Digest of the content
+   * @param data The content, kept by the cache
+   * @param result_id Id of the result
+   * @note A content larger than the limit is not cached
+   */
+  void Insert(const ContentDigest &digest, std::shared_ptr<const std::string> data, std::string result_id);
+
+  /**
+   * @brief Remove all the entries
+   */
+  void Clear();
+
+  /**
+   * @brief Total size of the cached contents in bytes
+   */
+  std::size_t Size();
+
+private:
+  struct Entry {
+    ContentDigest digest;
+    std::shared_ptr<const std::string> data;
+    std::string result_id;
+  };
+  using Entries = std::list<Entry>;
+
+  /**
+   * @brief Entry of a content, with the mutex held
+   * @return The entry, or entries_.end() if the content is not cached
+   */
+  Entries::iterator Lookup(const ContentDigest &digest, const std::string &data);
+
+  std::size_t max_size_;
+  std::size_t size_ = 0;
+
+  /**
+   * @brief Entries from the most recently used to the least recently used
+   */
+  Entries entries_;
+  std::unordered_multimap<ContentDigest, Entries::iterator, ContentDigest::Hash> index_;
+  std::mutex mutex_;
+};
+
+} // namespace Internal
+} // namespace Client
+} // namespace Sdk
+} // namespace ArmoniK
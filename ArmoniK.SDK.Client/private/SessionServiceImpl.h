@@ -1,12 +1,27 @@
 #pragma once
 
+#include "Batcher.h"
+#include "BlobSource.h"
 #include "ChannelPool.h"
+#include "ContentDigest.h"
+#include "FutureHandler.h"
+#include "InputCache.h"
+#include "TaskRegistry.h"
 #include "ThreadPool.h"
+#include "armonik/sdk/client/TaskFuture.h"
 #include "armonik/sdk/client/WaitBehavior.h"
 #include <armonik/client/results/ResultsClient.h>
 #include <armonik/sdk/common/TaskOptions.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <list>
 #include <mutex>
 #include <results_service.grpc.pb.h>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace ArmoniK {
 namespace Sdk {
@@ -30,6 +45,8 @@ namespace ArmoniK {
 namespace Sdk {
 namespace Client {
 namespace Internal {
+class TaskSubmitterImpl;
+
 /**
  * @brief Private implementation of the Session Service
  */
@@ -45,29 +62,47 @@ private:
   ArmoniK::Sdk::Common::TaskOptions taskOptions;
 
   /**
-   * @brief Map between taskId and resultId
+   * @brief Submitted tasks awaiting their result, with their result id and handler
    */
-  std::map<std::string, std::string> taskId_resultId;
+  TaskRegistry task_registry_;
 
   /**
-   * @brief Map between result id and task id
+   * @brief Results of registered tasks known to be no longer in CREATED status, which no wait has taken yet
    */
-  std::map<std::string, std::string> resultId_taskId;
+  std::unordered_map<std::string, armonik::api::grpc::v1::results::ResultRaw> completed_results_;
 
   /**
-   * @brief Map between the task id to its result ids
+   * @brief Results seen no longer in CREATED status while not registered, from the oldest to the latest
+   *
+   * @details
+   * A task can complete before SubmitRaw registers it, the completion cursor having moved past its result by then: the
+   * result is moved to completed_results_ once registered. The results handled by a concurrent wait or cleaned up are
+   * kept as well, hence the bound on their count.
    */
-  std::map<std::string, std::vector<std::string>> tid_rids;
+  std::list<armonik::api::grpc::v1::results::ResultRaw> unregistered_results_;
+  std::unordered_map<std::string, std::list<armonik::api::grpc::v1::results::ResultRaw>::iterator>
+      unregistered_index_;
 
   /**
-   * @brief Map between a result_id and it's handler
+   * @brief Latest completion date, since the epoch and as dated by the control plane, of the results listed by the
+   * waits
    */
-  std::map<std::string, std::shared_ptr<IServiceInvocationHandler>> result_handlers;
+  std::chrono::nanoseconds completion_cursor_{0};
 
   /**
-   * @brief Maps mutex
+   * @brief Results listed with the completion date of the cursor, which the next listing returns again
    */
-  std::mutex maps_mutex;
+  std::unordered_set<std::string> completion_cursor_results_;
+
+  /**
+   * @brief Date of the next reconciliation of the waited results
+   */
+  std::chrono::steady_clock::time_point next_reconcile_{};
+
+  /**
+   * @brief Mutex protecting the completion tracking state
+   */
+  std::mutex tracker_mutex_;
 
   /**
    * @brief Channel pool
@@ -79,6 +114,21 @@ private:
    */
   ThreadPool thread_pool_;
 
+  /**
+   * @brief Thread pool calling the result handlers
+   */
+  ThreadPool handler_pool_;
+
+  /**
+   * @brief Maximum number of results being downloaded or waiting for a handler thread
+   */
+  std::size_t max_concurrent_downloads_;
+
+  /**
+   * @brief Logger
+   */
+  armonik::api::common::logger::Logger &root_logger_;
+
   /**
    * @brief Local logger
    *
@@ -88,18 +138,88 @@ private:
   /**
    * @brief Batch size for waiting results
    */
-  int wait_batch_size_;
+  BatchSizeController wait_batch_size_;
 
   /**
    * @brief Batch size for task submission
    */
-  int submit_batch_size_;
+  BatchSizeController submit_batch_size_;
+
+  /**
+   * @brief Time after which the partial batches of the submitters are submitted
+   */
+  std::chrono::milliseconds batch_flush_delay_;
 
   /**
    * @brief Override message size for result upload and creation
    */
   int override_message_size_;
 
+  /**
+   * @brief Whether legacy TaskPayloads are serialized with the binary encoding
+   */
+  bool binary_task_payload_;
+
+  /**
+   * @brief Cached maximum size of the data chunks accepted by the Results service
+   */
+  std::size_t data_chunk_max_size_ = 0;
+
+  /**
+   * @brief Time after which the cached data chunk size is fetched again
+   */
+  std::chrono::steady_clock::time_point data_chunk_max_size_expiry_{};
+
+  /**
+   * @brief Mutex protecting the cached data chunk size, held while it is fetched
+   */
+  std::mutex data_chunk_max_size_mutex_;
+
+  /**
+   * @brief Whether the raw inputs uploaded by a submission are reused by the next submissions of the same content
+   */
+  bool input_cache_enabled_;
+
+  /**
+   * @brief Ids of the results holding the raw inputs already uploaded in the session
+   */
+  InputCache input_cache_;
+
+  /**
+   * @brief Blobs uploaded with UploadBlobs and not cleaned up yet
+   */
+  std::set<std::string> uploaded_blobs_;
+
+  /**
+   * @brief Mutex protecting the uploaded blobs
+   */
+  std::mutex uploaded_blobs_mutex_;
+
+  /**
+   * @brief Handler of the tasks submitted with futures
+   */
+  std::shared_ptr<FutureHandler> future_handler_ = std::make_shared<FutureHandler>();
+
+  /**
+   * @brief Mutex protecting the start of the futures tracking thread, and its wake-ups
+   */
+  std::mutex future_tracker_mutex_;
+
+  /**
+   * @brief Notified when futures are added or the tracking is stopped
+   */
+  std::condition_variable future_tasks_changed_;
+
+  /**
+   * @brief Whether the futures tracking thread must stop
+   */
+  std::atomic<bool> stop_future_tracking_{false};
+
+  /**
+   * @brief Thread waiting for the results of the futures, started with the first submission with futures
+   */
+  std::thread future_tracker_;
+
 public:
   SessionServiceImpl() = delete;
   SessionServiceImpl(const SessionServiceImpl &) = delete;
@@ -111,6 +231,11 @@ public:
   explicit SessionServiceImpl(const ArmoniK::Sdk::Common::Properties &properties,
                               armonik::api::common::logger::Logger &logger, const std::string &session_id = "");
 
+  /**
+   * @brief Stop the futures tracking, the futures left pending are broken
+   */
+  ~SessionServiceImpl();
+
   /**
    * @brief Submits the given list of task requests using the session's task options
    * @param task_requests List of task requests
@@ -154,11 +279,49 @@ public:
                                   const Common::TaskOptions &task_options);
 
   /**
-   * @brief Uploads raw library content to ArmoniK blob storage.
-   * @param content Raw bytes of the .so file
+   * @brief Submits the given list of task definitions and returns the future result of each task
+   * @param task_requests List of task definitions
+   * @param task_options Task options to use for this batch of requests
+   * @return Future results, in the order of the task definitions
+   */
+  std::vector<TaskFuture> SubmitWithFutures(const std::vector<Common::TaskDefinition> &task_requests,
+                                            const Common::TaskOptions &task_options);
+
+  /**
+   * @brief Creates a streaming submitter sending the pushed tasks in batches
+   * @param handler Result handler of the submitted tasks
+   * @param task_options Task options of the submitted tasks
+   * @param max_in_flight Maximum number of tasks pushed but not yet submitted, 0 for a default of 4 batches
+   * @return Submitter implementation
+   */
+  std::unique_ptr<TaskSubmitterImpl> CreateSubmitter(std::shared_ptr<IServiceInvocationHandler> handler,
+                                                     const Common::TaskOptions &task_options,
+                                                     std::size_t max_in_flight);
+
+  /**
+   * @brief Uploads library content to ArmoniK blob storage.
+   * @param content Content of the .so file
    * @return Blob ID (result ID) of the uploaded library
    */
-  std::string UploadLibrary(const std::string &content);
+  std::string UploadLibrary(const BlobSource &content);
+
+  /**
+   * @brief Uploads blobs which can be used as inputs of any number of tasks of the session
+   * @param sources Contents of the blobs
+   * @return Blob IDs (result IDs), in the order of the sources
+   */
+  std::vector<std::string> UploadBlobs(const std::vector<BlobSource> &sources);
+
+  /**
+   * @brief Deletes the data of the given blobs
+   * @param blob_ids Blob IDs
+   */
+  void CleanupBlobs(std::vector<std::string> blob_ids);
+
+  /**
+   * @brief Deletes the data of all the blobs uploaded with UploadBlobs and not cleaned up yet
+   */
+  void CleanupBlobs();
 
   /**
    * @brief Get the session Id associated with this service
@@ -166,6 +329,12 @@ public:
    */
   [[nodiscard]] const std::string &getSession() const;
 
+  /**
+   * @brief Get the default task options of the session
+   * @return Session task options
+   */
+  [[nodiscard]] const Common::TaskOptions &getTaskOptions() const;
+
   /**
    * @brief Waits for the completion of the given tasks
    * @param task_ids Task ids to wait on. If left empty, will wait for submitted tasks in
@@ -209,6 +378,37 @@ public:
   void CleanupTasks(std::vector<std::string> task_ids);
 
 private:
+  /**
+   * @brief Wait for the results of the futures until stopped, failing the pending futures after
+   * FutureTrackingMaxFailures consecutive failed waits or a non-retryable error
+   */
+  void TrackFutures();
+
+  /**
+   * @brief Keep a result which is not registered, dropping the oldest ones above the limit. Called with the tracker
+   * mutex held.
+   * @param result The result
+   */
+  void KeepUnregistered(armonik::api::grpc::v1::results::ResultRaw result);
+
+  /**
+   * @brief Waits for the completion of the given tasks, or of the tasks of the futures
+   * @param task_ids Task ids to wait on, all the submitted tasks if empty
+   * @param futures Handler of the futures whose tasks are waited on instead of task_ids, as long as some are pending
+   * and the tracking is not stopped, or null
+   * @param waitBehavior Wait for all tasks completion, any task completion and/or stop waiting if a result is aborted
+   * @param options Wait options
+   */
+  void Wait(std::set<std::string> task_ids, FutureHandler *futures, WaitBehavior waitBehavior,
+            const WaitOptions &options);
+
+  /**
+   * @brief Maximum size of the data chunks for result creation and upload
+   * @return The override message size if set, otherwise the size from the Results service configuration, fetched
+   * once and refreshed periodically
+   */
+  std::size_t DataChunkMaxSize();
+
   /**
    * @brief Core submission logic operating on pre-serialized payloads.
    * @param serialized_payloads Pre-serialized task payload bytes (one per task)
@@ -221,6 +421,15 @@ private:
                                      const std::vector<std::vector<std::string>> &data_dependencies,
                                      std::shared_ptr<IServiceInvocationHandler> handler,
                                      const Common::TaskOptions &task_options);
+
+  /**
+   * @brief Creates results holding the given contents: the small ones are sent inline in batches, the others are
+   * streamed in parallel
+   * @param sources Contents of the results
+   * @param name_prefix Prefix of the names of the results
+   * @return Result IDs, in the order of the sources
+   */
+  std::vector<std::string> CreateBlobs(const std::vector<BlobSource> &sources, const std::string &name_prefix);
 };
 } // namespace Internal
 } // namespace Client
@@ -0,0 +1,319 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ArmoniK {
+namespace Sdk {
+namespace Client {
+class IServiceInvocationHandler;
+
+namespace Internal {
+
+/**
+ * @brief Registry of the submitted tasks awaiting their result
+ *
+ * @details
+ * Each task is a single record {task id, result id, handler}, found either by its result id or by its task id.
+ * Records are sharded by result id, each shard storing them in a slot array with an open addressing index, so that
+ * concurrent completions mostly take distinct locks. A second set of shards indexes the records by task id. The
+ * records registered together point to a shared batch entry holding their handler and the sequence number of the
+ * registration, so that the tasks registered before a given point can be told apart from the later ones.
+ *
+ * Locks are only nested from a task shard to a record shard.
+ */
+class TaskRegistry {
+public:
+  /**
+   * @brief A registered task
+   */
+  struct Record {
+    /**
+     * @brief Task id
+     */
+    std::string task_id;
+
+    /**
+     * @brief Id of the result of the task
+     */
+    std::string result_id;
+
+    /**
+     * @brief Handler of the result
+     */
+    std::shared_ptr<IServiceInvocationHandler> handler;
+
+    /**
+     * @brief Sequence number of the registration of the task
+     */
+    std::uint64_t sequence = 0;
+  };
+
+  /**
+   * @brief Creates an empty registry
+   */
+  TaskRegistry();
+
+  /**
+   * @brief Copy constructor
+   */
+  TaskRegistry(const TaskRegistry &) = delete;
+
+  /**
+   * @brief Copy assignment operator
+   */
+  TaskRegistry &operator=(const TaskRegistry &) = delete;
+
+  /**
+   * @brief Destroy the registry
+   */
+  ~TaskRegistry();
+
+  /**
+   * @brief Register tasks sharing the same handler
+   * @param task_ids Task ids
+   * @param result_ids Result ids, one per task
+   * @param handler Handler of the results
+   * @return Sequence number of the registration, greater than the ones of the previous registrations
+   * @note A result id already registered is replaced
+   */
+  std::uint64_t Add(const std::vector<std::string> &task_ids, const std::vector<std::string> &result_ids,
+                    const std::shared_ptr<IServiceInvocationHandler> &handler);
+
+  /**
+   * @brief Remove the task of a result
+   * @param result_id Result id
+   * @param record Removed record
+   * @param max_sequence Only remove the task if it was registered with at most this sequence number
+   * @param handler Only remove the task if it was registered with this handler, unless null
+   * @return Whether the task was removed
+   */
+  bool TakeByResult(const std::string &result_id, Record &record, std::uint64_t max_sequence = UINT64_MAX,
+                    const IServiceInvocationHandler *handler = nullptr);
+
+  /**
+   * @brief Check if the task of a result is registered
+   * @param result_id Result id
+   * @return Whether the result is registered
+   */
+  bool HasResult(const std::string &result_id);
+
+  /**
+   * @brief Remove a task
+   * @param task_id Task id
+   * @return Whether the task was registered
+   */
+  bool RemoveByTask(const std::string &task_id);
+
+  /**
+   * @brief Find the result of a task
+   * @param task_id Task id
+   * @param result_id Result id of the task
+   * @return Whether the task is registered
+   */
+  bool FindResult(const std::string &task_id, std::string &result_id);
+
+  /**
+   * @brief Get the result ids of the registered tasks
+   * @param max_sequence Only get the tasks registered with at most this sequence number
+   * @param handler Only get the tasks registered with this handler, unless null
+   * @return Result ids
+   */
+  std::vector<std::string> ResultIds(std::uint64_t max_sequence = UINT64_MAX,
+                                     const IServiceInvocationHandler *handler = nullptr);
+
+  /**
+   * @brief Sequence number of the last registration
+   * @return The sequence number, or 0 if nothing was ever registered
+   */
+  std::uint64_t LastSequence();
+
+  /**
+   * @brief Check if tasks registered with at most the given sequence number remain
+   * @param max_sequence Sequence number
+   * @return Whether such tasks remain
+   */
+  bool HasPending(std::uint64_t max_sequence);
+
+  /**
+   * @brief Remove all the tasks
+   */
+  void Clear();
+
+  /**
+   * @brief Number of registered tasks
+   */
+  std::size_t Size();
+
+private:
+  /**
+   * @brief Tasks registered together
+   */
+  struct Batch {
+    /**
+     * @brief Handler of the tasks
+     */
+    std::shared_ptr<IServiceInvocationHandler> handler;
+
+    /**
+     * @brief Sequence number of the registration
+     */
+    std::uint64_t sequence = 0;
+
+    /**
+     * @brief Number of records of the batch still registered
+     */
+    std::atomic<std::size_t> count{0};
+  };
+
+  /**
+   * @brief Entry of an open addressing index
+   */
+  struct IndexEntry {
+    /**
+     * @brief Hash of the key
+     */
+    std::uint64_t hash;
+
+    /**
+     * @brief Record shard, for the task index
+     */
+    std::uint32_t shard;
+
+    /**
+     * @brief Record slot in the shard, or Empty or Tombstone
+     */
+    std::uint32_t slot;
+  };
+
+  /**
+   * @brief Open addressing index with linear probing
+   */
+  class Index {
+  public:
+    static constexpr std::uint32_t Empty = UINT32_MAX;
+    static constexpr std::uint32_t Tombstone = UINT32_MAX - 1;
+
+    /**
+     * @brief Find the entry with the given hash accepted by match
+     * @return The entry, or null if not found
+     */
+    template <class Match> IndexEntry *Find(std::uint64_t hash, Match &&match);
+
+    /**
+     * @brief Insert a new entry, whose key is not in the index
+     */
+    void Insert(IndexEntry entry);
+
+    /**
+     * @brief Erase an entry returned by Find
+     */
+    void Erase(IndexEntry *entry);
+
+    /**
+     * @brief Remove all the entries
+     */
+    void Clear();
+
+  private:
+    /**
+     * @brief Grow or clean the table if too loaded
+     */
+    void Reserve();
+
+    /**
+     * @brief Entries, the size is zero or a power of 2
+     */
+    std::vector<IndexEntry> entries_;
+
+    /**
+     * @brief Number of live entries
+     */
+    std::size_t size_ = 0;
+
+    /**
+     * @brief Number of tombstones
+     */
+    std::size_t tombstones_ = 0;
+  };
+
+  /**
+   * @brief Stored record
+   */
+  struct Slot {
+    std::string task_id;
+    std::string result_id;
+    Batch *batch = nullptr;
+  };
+
+  /**
+   * @brief Shard of the records, by result id
+   */
+  struct RecordShard {
+    std::mutex mutex;
+    std::vector<Slot> slots;
+    std::vector<std::uint32_t> free_slots;
+    Index by_result;
+  };
+
+  /**
+   * @brief Shard of the task index, by task id
+   */
+  struct TaskShard {
+    std::mutex mutex;
+    Index by_task;
+  };
+
+  static constexpr std::size_t ShardCount = 64;
+
+  /**
+   * @brief Create the batch of count new records
+   */
+  Batch *NewBatch(const std::shared_ptr<IServiceInvocationHandler> &handler, std::size_t count);
+
+  /**
+   * @brief Release a record of a batch, destroying the batch with its last record
+   * @return The handler of the batch
+   */
+  std::shared_ptr<IServiceInvocationHandler> Release(Batch *batch);
+
+  /**
+   * @brief Free a slot of a shard, whose mutex is held, and release its handler
+   * @return The handler of the slot
+   */
+  std::shared_ptr<IServiceInvocationHandler> FreeSlot(RecordShard &shard, std::uint32_t slot);
+
+  /**
+   * @brief Erase the task index entry of a removed record
+   */
+  void EraseTaskEntry(const std::string &task_id, std::uint32_t shard, std::uint32_t slot);
+
+  std::array<RecordShard, ShardCount> record_shards_;
+  std::array<TaskShard, ShardCount> task_shards_;
+
+  /**
+   * @brief Batches with registered records, by sequence number
+   */
+  std::map<std::uint64_t, std::unique_ptr<Batch>> batches_;
+
+  /**
+   * @brief Sequence number of the last registration
+   */
+  std::uint64_t last_sequence_ = 0;
+
+  /**
+   * @brief Mutex protecting the batches and the sequence number
+   */
+  std::mutex batches_mutex_;
+};
+
+} // namespace Internal
+} // namespace Client
+} // namespace Sdk
+} // namespace ArmoniK
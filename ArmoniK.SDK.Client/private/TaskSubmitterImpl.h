@@ -0,0 +1,178 @@
+#pragma once
+
+#include <armonik/common/logger/logger.h>
+#include <armonik/sdk/common/TaskDefinition.h>
+#include <armonik/sdk/common/TaskOptions.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ArmoniK {
+namespace Sdk {
+namespace Client {
+class IServiceInvocationHandler;
+namespace Internal {
+class SessionServiceImpl;
+
+/**
+ * @brief Private implementation of the TaskSubmitter
+ *
+ * @details
+ * Full batches are queued and submitted by dedicated dispatcher threads through SessionServiceImpl::Submit(). The
+ * dispatchers are not ThreadPool threads, so they can block on the JoinSets of the submission without starving the
+ * pool. Several batches are in flight at the same time, each one being uploaded and submitted independently, by at
+ * most as many dispatchers as the pool has threads whatever the number of queued batches. A partial batch is queued
+ * once its first task has waited for the flush delay, so that tasks pushed slowly are not held back.
+ */
+class TaskSubmitterImpl {
+private:
+  /**
+   * @brief A batch of tasks waiting to be submitted
+   */
+  struct Batch {
+    std::vector<Common::TaskDefinition> tasks;
+    std::vector<std::promise<std::string>> promises;
+  };
+
+  /**
+   * @brief Session service used to submit the batches
+   */
+  SessionServiceImpl &service_;
+
+  /**
+   * @brief Result handler of the submitted tasks
+   */
+  std::shared_ptr<IServiceInvocationHandler> handler_;
+
+  /**
+   * @brief Task options of the submitted tasks
+   */
+  Common::TaskOptions task_options_;
+
+  /**
+   * @brief Number of tasks per batch
+   */
+  std::size_t batch_size_;
+
+  /**
+   * @brief Maximum number of tasks pushed but not yet submitted, bounding the memory held by the queued batches
+   */
+  std::size_t max_in_flight_;
+
+  /**
+   * @brief Number of tasks pushed but not yet submitted
+   */
+  std::size_t in_flight_ = 0;
+
+  /**
+   * @brief Time after which a partial batch is queued, 0 to wait for a full batch
+   */
+  std::chrono::milliseconds flush_delay_;
+
+  /**
+   * @brief Batch being filled
+   */
+  Batch current_;
+
+  /**
+   * @brief Time at which the batch being filled is queued even if partial
+   */
+  std::chrono::steady_clock::time_point current_deadline_;
+
+  /**
+   * @brief Full batches waiting for a dispatcher
+   */
+  std::deque<Batch> ready_;
+
+  /**
+   * @brief Whether the submitter is closed
+   */
+  bool closed_ = false;
+
+  /**
+   * @brief Mutex protecting the batches
+   */
+  std::mutex mutex_;
+
+  /**
+   * @brief Notified when a batch is ready, a batch is started or the submitter is closed
+   */
+  std::condition_variable work_condition_;
+
+  /**
+   * @brief Notified when in-flight tasks have been submitted
+   */
+  std::condition_variable space_condition_;
+
+  /**
+   * @brief Dispatcher threads
+   */
+  std::vector<std::thread> dispatchers_;
+
+  /**
+   * @brief Local logger
+   */
+  armonik::api::common::logger::LocalLogger logger_;
+
+  /**
+   * @brief Main loop of the dispatcher threads
+   */
+  void Dispatch();
+
+  /**
+   * @brief Queue the current batch for submission
+   * @note Must be called with the mutex locked
+   */
+  void QueueCurrent();
+
+public:
+  /**
+   * @brief Creates a submitter
+   * @param service Session service used to submit the batches
+   * @param handler Result handler of the submitted tasks
+   * @param task_options Task options of the submitted tasks
+   * @param batch_size Number of tasks per batch
+   * @param max_in_flight Maximum number of tasks pushed but not yet submitted, 0 for 4 batches
+   * @param max_dispatchers Maximum number of dispatcher threads, hence of batches submitted at the same time
+   * @param flush_delay Time after which a partial batch is submitted, 0 to wait for a full batch
+   * @param logger Logger
+   */
+  TaskSubmitterImpl(SessionServiceImpl &service, std::shared_ptr<IServiceInvocationHandler> handler,
+                    Common::TaskOptions task_options, std::size_t batch_size, std::size_t max_in_flight,
+                    std::size_t max_dispatchers, std::chrono::milliseconds flush_delay,
+                    armonik::api::common::logger::Logger &logger);
+
+  TaskSubmitterImpl(const TaskSubmitterImpl &) = delete;
+  TaskSubmitterImpl &operator=(const TaskSubmitterImpl &) = delete;
+
+  /**
+   * @brief Closes the submitter
+   */
+  ~TaskSubmitterImpl();
+
+  /**
+   * @brief Pushes a task to be submitted
+   * @param task Task definition
+   * @return Future of the task id
+   */
+  std::future<std::string> Push(Common::TaskDefinition task);
+
+  /**
+   * @brief Queue the partial batch for submission
+   */
+  void Flush();
+
+  /**
+   * @brief Submits the pending tasks and waits for the dispatchers to finish
+   */
+  void Close();
+};
+} // namespace Internal
+} // namespace Client
+} // namespace Sdk
+} // namespace ArmoniK
@@ -4,10 +4,12 @@
 #include <armonik/common/logger/formatter.h>
 #include <armonik/common/logger/logger.h>
 #include <armonik/common/logger/writer.h>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <vector>
 
@@ -17,6 +19,12 @@ namespace Client {
 namespace Internal {
 /**
  * @brief A thread pool to execute tasks in background
+ *
+ * @details
+ * Work-stealing scheduler: each thread owns a deque of tasks. A task spawned from a thread of the pool is pushed to
+ * the deque of that thread and executed by it in LIFO order, which keeps nested spawns local. Tasks spawned from
+ * outside the pool are distributed round-robin over the deques. Idle threads steal the oldest tasks of the other
+ * deques before going to sleep, so that no single lock is taken by every spawn.
  */
 class ThreadPool {
 public:
@@ -82,6 +90,7 @@ private:
 
     /**
      * @brief Execute the task
+     * @param logger Logger of the executing thread, only used to report errors
      */
     void Execute(armonik::api::common::logger::ILogger &logger);
 
@@ -89,6 +98,26 @@ private:
      * @brief Record current error for the join set
      */
     void RecordError();
+
+    /**
+     * @brief Logging context identifying the join set of the task
+     */
+    armonik::api::common::logger::Context JoinSetContext() const;
+  };
+
+  /**
+   * @brief Tasks owned by a thread of the pool
+   */
+  struct Worker {
+    /**
+     * @brief Mutex to protect the deque, only contended when a task is stolen
+     */
+    std::mutex mutex;
+
+    /**
+     * @brief Pending tasks: the owner pushes and pops at the back, thieves take from the front
+     */
+    std::deque<Task> tasks;
   };
 
 private:
@@ -97,13 +126,28 @@ private:
    */
   std::size_t max_threads_;
 
+  /**
+   * @brief One deque per thread, allocated upfront as threads are started lazily
+   */
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  /**
+   * @brief The number of started threads
+   */
+  std::atomic<std::size_t> started_threads_;
+
   /**
    * @brief The number of sleeping threads
    */
-  std::size_t sleeping_threads_;
+  std::atomic<std::size_t> sleeping_threads_;
 
   /**
-   * @brief Mutex to protect the pool
+   * @brief The number of spawned tasks not yet picked up by a thread
+   */
+  std::atomic<std::size_t> pending_tasks_;
+
+  /**
+   * @brief Mutex to protect the threads and the sleeping state
    */
   std::mutex mutex_;
 
@@ -122,15 +166,10 @@ private:
    */
   std::vector<std::thread> threads_;
 
-  /**
-   * @brief The pending tasks waiting to be executed by the pool
-   */
-  std::queue<Task> pending_tasks_;
-
   /**
    * @brief Flag to stop the pool
    */
-  bool stop_;
+  std::atomic<bool> stop_;
 
 private:
   /**
@@ -140,8 +179,22 @@ private:
 
   /**
    * @brief The main loop for each thread
+   * @param index Index of the deque owned by the thread
+   */
+  void Run(std::size_t index);
+
+  /**
+   * @brief Take a task, from the own deque of the thread first, then from the other deques
+   * @param index Index of the deque owned by the thread
+   * @param task Taken task
+   * @return Whether a task has been taken
+   */
+  bool TryTake(std::size_t index, Task &task);
+
+  /**
+   * @brief Start a new thread if no thread is available to execute a new task
    */
-  void Run();
+  void StartThreadIfNeeded();
 
   /**
    * @brief Spawn a task on the pool
@@ -184,12 +237,23 @@ public:
    * @param f The task to execute
    */
   void Spawn(Function<void()> &&f);
+
+  /**
+   * @brief Maximum number of threads of the pool
+   */
+  std::size_t MaxThreads() const { return max_threads_; }
 };
 
 /**
  * @brief A join set to wait for a set of tasks to finish
  */
 class ThreadPool::JoinSet {
+public:
+  /**
+   * @brief An operation of the join set running outside of the pool, such as an asynchronous RPC
+   */
+  class Pending;
+
 private:
   friend class ThreadPool;
 
@@ -201,8 +265,9 @@ private:
 
   /**
    * @brief The number of unfinished tasks in the join set
+   * @note Only the last decrement, which may wake up waiters, is done under the mutex
    */
-  std::size_t task_count_;
+  std::atomic<std::size_t> task_count_;
 
   /**
    * @brief The exception that occurred in any task of the join set, if any
@@ -210,7 +275,7 @@ private:
   std::exception_ptr exception_;
 
   /**
-   * @brief Mutex to protect the join set
+   * @brief Mutex to protect the exception and the waits
    */
   std::mutex mutex_;
 
@@ -225,6 +290,11 @@ private:
    */
   armonik::api::common::logger::LocalLogger Logger(armonik::api::common::logger::Context context = {});
 
+  /**
+   * @brief Mark a task of the join set as finished, waking up the waiters if it was the last one
+   */
+  void TaskDone();
+
 public:
   /**
    * @brief Creates a join set on the given thread pool
@@ -256,6 +326,12 @@ public:
    */
   void Spawn(Function<void()> &&f);
 
+  /**
+   * @brief Add an operation running outside of the pool to the join set
+   * @return The pending operation, the join set waits until it is completed or destroyed
+   */
+  Pending Track();
+
   /**
    * @brief Wait for all tasks in the join set to finish
    * @throw If any task has thrown, the exception is thrown by Wait()
@@ -264,6 +340,65 @@ public:
   void Wait();
 };
 
+/**
+ * @brief An operation of the join set running outside of the pool
+ *
+ * @details
+ * It counts as a task of the join set until it is completed, so that Wait() also waits for it without any thread
+ * being blocked on the operation itself.
+ */
+class ThreadPool::JoinSet::Pending {
+private:
+  /**
+   * @brief The join set of the operation, null once completed
+   */
+  JoinSet *join_set_;
+
+public:
+  /**
+   * @brief Add a pending operation to the join set
+   * @param join_set The join set
+   */
+  explicit Pending(JoinSet &join_set);
+
+  /**
+   * @brief Copy constructor
+   */
+  Pending(const Pending &) = delete;
+
+  /**
+   * @brief Copy assignment operator
+   */
+  Pending &operator=(const Pending &) = delete;
+
+  /**
+   * @brief Move constructor
+   */
+  Pending(Pending &&other) noexcept;
+
+  /**
+   * @brief Move assignment operator
+   */
+  Pending &operator=(Pending &&other) noexcept;
+
+  /**
+   * @brief Complete the operation if not already done
+   */
+  ~Pending();
+
+  /**
+   * @brief Complete the operation by spawning its continuation on the join set
+   * @param f The continuation
+   */
+  void Then(Function<void()> &&f);
+
+  /**
+   * @brief Complete the operation with an error
+   * @param e The error, rethrown by Wait()
+   */
+  void Fail(std::exception_ptr e);
+};
+
 } // namespace Internal
 } // namespace Client
 } // namespace Sdk
@@ -0,0 +1,151 @@
+#include "BlobSource.h"
+#include <armonik/sdk/common/ArmoniKSdkException.h>
+#include <utility>
+#ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ArmoniK {
+namespace Sdk {
+namespace Client {
+namespace Internal {
+
+#ifndef _WIN32
+namespace {
+/**
+ * @brief Open a file for reading and get its size
+ * @param path Path of the file
+ * @param size Size of the file
+ * @return Descriptor of the file, to be closed by the caller
+ */
+int open_file(const std::string &path, std::size_t &size) {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  struct stat stats {};
+  if (fd < 0 || fstat(fd, &stats) != 0) {
+    auto error = errno;
+    if (fd >= 0) {
+      close(fd);
+    }
+    throw ArmoniK::Sdk::Common::ArmoniKSdkException("Unable to open blob file " + path + ": " + std::strerror(error));
+  }
+  size = static_cast<std::size_t>(stats.st_size);
+  return fd;
+}
+} // namespace
+
+/**
+ * @brief Mapping of a file, keeping the file open to check its size
+ */
+struct BlobSource::Mapping {
+  Mapping(const char *address, std::size_t size, int fd) : address(address), size(size), fd(fd) {}
+  Mapping(const Mapping &) = delete;
+  Mapping &operator=(const Mapping &) = delete;
+  ~Mapping() {
+    munmap(const_cast<char *>(address), size);
+    close(fd);
+  }
+
+  const char *address;
+  std::size_t size;
+  int fd;
+};
+#endif
+
+BlobSource BlobSource::FromData(absl::string_view data) {
+  BlobSource source;
+  source.data_ = data;
+  source.size_ = data.size();
+  return source;
+}
+
+BlobSource BlobSource::FromFile(std::string path) {
+  BlobSource source;
+#ifdef _WIN32
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    throw ArmoniK::Sdk::Common::ArmoniKSdkException("Unable to open blob file " + path);
+  }
+  source.size_ = static_cast<std::size_t>(file.tellg());
+#else
+  close(open_file(path, source.size_));
+#endif
+  source.path_ = std::move(path);
+  return source;
+}
+
+absl::string_view BlobSource::Read(std::size_t offset, std::size_t length, std::string &buffer) const {
+  if (path_.empty()) {
+    return data_.substr(offset, length);
+  }
+  if (length == 0) {
+    return {};
+  }
+
+#ifdef _WIN32
+  if (!file_) {
+    file_ = std::make_shared<std::ifstream>(path_, std::ios::binary);
+  }
+  buffer.resize(length);
+  if (!file_->seekg(static_cast<std::streamoff>(offset)) ||
+      !file_->read(&buffer[0], static_cast<std::streamsize>(length))) {
+    file_.reset();
+    throw ArmoniK::Sdk::Common::ArmoniKSdkException("Unable to read blob file " + path_);
+  }
+  if (offset + length >= size_) {
+    file_.reset();
+  }
+  return buffer;
+#else
+  std::string error;
+  if (!mapping_) {
+    std::size_t size = 0;
+    int fd = open_file(path_, size);
+    void *address = MAP_FAILED;
+    if (size != size_) {
+      error = "size has changed";
+    } else {
+      address = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (address == MAP_FAILED) {
+        error = std::strerror(errno);
+      }
+    }
+    if (address == MAP_FAILED) {
+      close(fd);
+      throw ArmoniK::Sdk::Common::ArmoniKSdkException("Unable to map blob file " + path_ + ": " + error);
+    }
+    // The file is read once from start to end: the kernel can read ahead and drop the pages read
+    madvise(address, size_, MADV_SEQUENTIAL);
+    mapping_ = std::make_shared<const Mapping>(static_cast<const char *>(address), size_, fd);
+  } else {
+    // Reading the pages of a truncated file would raise SIGBUS
+    struct stat stats {};
+    if (fstat(mapping_->fd, &stats) != 0) {
+      error = std::strerror(errno);
+    } else if (static_cast<std::size_t>(stats.st_size) != size_) {
+      error = "size has changed";
+    }
+    if (!error.empty()) {
+      mapping_.reset();
+      throw ArmoniK::Sdk::Common::ArmoniKSdkException("Unable to read blob file " + path_ + ": " + error);
+    }
+  }
+
+  absl::string_view part(mapping_->address + offset, length);
+  if (offset + length < size_) {
+    return part;
+  }
+  buffer.assign(part.data(), part.size());
+  mapping_.reset();
+  return buffer;
+#endif
+}
+
+} // namespace Internal
+} // namespace Client
+} // namespace Sdk
+} // namespace ArmoniK
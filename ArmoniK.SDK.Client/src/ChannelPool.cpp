@@ -4,6 +4,7 @@
 #include <armonik/common/options/ControlPlane.h>
 #include <armonik/common/utils/ChannelArguments.h>
 #include <armonik/sdk/common/Version.h>
+#include <algorithm>
 #include <grpcpp/create_channel.h>
 #include <utility>
 
@@ -12,41 +13,116 @@ namespace Sdk {
 namespace Client {
 namespace Internal {
 
-std::shared_ptr<grpc::Channel> ChannelPool::AcquireChannel() {
-  std::shared_ptr<grpc::Channel> channel;
-  {
-    std::lock_guard<std::mutex> _(channel_mutex_);
-    if (!channel_pool_.empty()) {
-      channel = channel_pool_.front();
-      channel_pool_.pop();
-    }
+ChannelPool::Connection::Connection(std::shared_ptr<grpc::Channel> channel)
+    : channel(std::move(channel)), results(armonik::api::grpc::v1::results::Results::NewStub(this->channel)),
+      tasks(armonik::api::grpc::v1::tasks::Tasks::NewStub(this->channel)),
+      sessions(armonik::api::grpc::v1::sessions::Sessions::NewStub(this->channel)) {}
+
+void ChannelPool::Prewarm() {
+  std::unique_lock<std::mutex> lock(channel_mutex_);
+  while (channel_pool_.size() + connecting_ < min_channels_) {
+    auto connection = OpenConnection(lock);
+    // Start the connection and its handshake in background
+    connection->channel->GetState(true);
   }
+  logger_.debug("Channel pool prewarmed", {{"channels", std::to_string(channel_pool_.size())}});
+}
+
+std::shared_ptr<ChannelPool::Connection> ChannelPool::AcquireConnection() {
+  std::unique_lock<std::mutex> lock(channel_mutex_);
+  while (true) {
+    // Pick the least used healthy connection, dropping the unused ones in failure
+    std::shared_ptr<Connection> connection;
+    for (auto it = channel_pool_.begin(); it != channel_pool_.end();) {
+      auto &candidate = *it;
+      if (ShutdownOnFailure(candidate->channel)) {
+        if (candidate->leases == 0) {
+          logger_.debug("Shutdown unhealthy channel");
+          it = channel_pool_.erase(it);
+          continue;
+        }
+      } else if (candidate->leases < max_streams_per_channel_ &&
+                 (connection == nullptr || candidate->leases < connection->leases)) {
+        connection = candidate;
+      }
+      ++it;
+    }
+
+    if (connection == nullptr && channel_pool_.size() + connecting_ < max_channels_) {
+      connection = OpenConnection(lock);
+    }
 
-  if (channel != nullptr) {
-    if (ShutdownOnFailure(channel)) {
-      logger_.debug("Shutdown unhealthy channel");
-    } else {
-      logger_.debug("Acquired already existing channel from pool");
-      return channel;
+    if (connection != nullptr) {
+      ++connection->leases;
+      return connection;
     }
+
+    ++waiting_;
+    logger_.debug("Waiting for a free channel", {{"channels", std::to_string(channel_pool_.size())},
+                                                  {"waiting", std::to_string(waiting_)}});
+    channel_released_.wait(lock);
+    --waiting_;
   }
-  armonik::api::common::logger::Logger logger{armonik::api::common::logger::writer_console(),
-                                              armonik::api::common::logger::formatter_plain(true)};
-  armonik::api::client::ChannelFactory channelFactory(
-      static_cast<armonik::api::common::utils::Configuration>(properties_.configuration), logger);
-  channel = channelFactory.create_channel();
-  logger_.debug("Created and acquired new channel from pool");
-  return channel;
 }
 
-void ChannelPool::ReleaseChannel(std::shared_ptr<grpc::Channel> channel) {
-  if (ShutdownOnFailure(channel)) {
+void ChannelPool::ReleaseConnection(std::shared_ptr<Connection> connection) {
+  std::lock_guard<std::mutex> _(channel_mutex_);
+  if (--connection->leases == 0 && ShutdownOnFailure(connection->channel)) {
     logger_.debug("Shutdown unhealthy channel");
+    channel_pool_.erase(std::remove(channel_pool_.begin(), channel_pool_.end(), connection), channel_pool_.end());
   } else {
     logger_.debug("Released channel to pool");
+  }
+  channel_released_.notify_one();
+}
+
+std::shared_ptr<grpc::Channel> ChannelPool::AcquireChannel() { return AcquireConnection()->channel; }
+
+void ChannelPool::ReleaseChannel(std::shared_ptr<grpc::Channel> channel) {
+  std::shared_ptr<Connection> connection;
+  {
     std::lock_guard<std::mutex> _(channel_mutex_);
-    channel_pool_.push(channel);
+    for (auto &candidate : channel_pool_) {
+      if (candidate->channel == channel) {
+        connection = candidate;
+        break;
+      }
+    }
+  }
+  if (connection != nullptr) {
+    ReleaseConnection(std::move(connection));
+  }
+}
+
+ChannelPool::Stats ChannelPool::GetStats() {
+  std::lock_guard<std::mutex> _(channel_mutex_);
+  Stats stats{channel_pool_.size(), connecting_, 0, waiting_, created_};
+  for (auto &connection : channel_pool_) {
+    stats.leases += connection->leases;
   }
+  return stats;
+}
+
+std::shared_ptr<ChannelPool::Connection> ChannelPool::OpenConnection(std::unique_lock<std::mutex> &lock) {
+  ++connecting_;
+  lock.unlock();
+  std::shared_ptr<Connection> connection;
+  try {
+    std::lock_guard<std::mutex> _(factory_mutex_);
+    connection = std::make_shared<Connection>(channel_factory_.create_channel());
+  } catch (...) {
+    lock.lock();
+    --connecting_;
+    channel_released_.notify_one();
+    throw;
+  }
+  lock.lock();
+  --connecting_;
+  ++created_;
+  channel_pool_.push_back(connection);
+  logger_.debug("Created new channel in pool", {{"channels", std::to_string(channel_pool_.size())},
+                                                {"created", std::to_string(created_)}});
+  return connection;
 }
 
 bool ChannelPool::ShutdownOnFailure(std::shared_ptr<grpc::Channel> channel) {
@@ -76,17 +152,30 @@ bool ChannelPool::ShutdownOnFailure(std::shared_ptr<grpc::Channel> channel) {
 }
 
 ChannelPool::ChannelPool(ArmoniK::Sdk::Common::Properties properties, armonik::api::common::logger::Logger &logger)
-    : properties_(std::move(properties)), logger_(logger.local({{"sdk_version", ArmoniK::Sdk::Common::getVersion()}})) {
-}
+    : properties_(std::move(properties)), logger_(logger.local({{"sdk_version", ArmoniK::Sdk::Common::getVersion()}})),
+      channel_factory_(static_cast<armonik::api::common::utils::Configuration>(properties_.configuration), logger),
+      min_channels_(properties_.configuration.get_control_plane().getMinChannels()),
+      max_channels_(properties_.configuration.get_control_plane().getMaxChannels()),
+      max_streams_per_channel_(properties_.configuration.get_control_plane().getMaxStreamsPerChannel()) {}
 ChannelPool::~ChannelPool() = default;
 
 ChannelPool::ChannelGuard::ChannelGuard(Internal::ChannelPool *pool) : pool_(pool) {
   if (pool_ != nullptr) {
-    channel = pool_->AcquireChannel();
+    connection = pool_->AcquireConnection();
+    channel = connection->channel;
   }
 }
 
-ChannelPool::ChannelGuard::~ChannelGuard() { pool_->ReleaseChannel(channel); }
+ChannelPool::ChannelGuard::ChannelGuard(ChannelGuard &&other) noexcept
+    : channel(std::move(other.channel)), connection(std::move(other.connection)), pool_(other.pool_) {
+  other.pool_ = nullptr;
+}
+
+ChannelPool::ChannelGuard::~ChannelGuard() {
+  if (pool_ != nullptr) {
+    pool_->ReleaseConnection(std::move(connection));
+  }
+}
 
 ChannelPool::ChannelGuard ChannelPool::GetChannel() { return ChannelGuard(this); }
 
@@ -0,0 +1,84 @@
+#include "armonik/sdk/client/FileDownloadHandler.h"
+#include <armonik/sdk/common/ArmoniKSdkException.h>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+namespace ArmoniK {
+namespace Sdk {
+namespace Client {
+
+FileDownloadHandler::FileDownloadHandler(std::string directory) : directory(std::move(directory)) {}
+
+void FileDownloadHandler::HandleResponseBegin(const std::string &taskId, const std::string &result_id) {
+  auto path = directory + "/" + result_id;
+  std::lock_guard<std::mutex> _(mutex);
+  auto &download = downloads[result_id];
+  download.task_id = taskId;
+  download.file.open(path + ".part", std::ios::binary | std::ios::trunc);
+  if (!download.file) {
+    downloads.erase(result_id);
+    throw ArmoniK::Sdk::Common::ArmoniKSdkException("Unable to create result file " + path + ".part");
+  }
+  download.path = std::move(path);
+}
+
+void FileDownloadHandler::HandleResponseChunk(absl::string_view chunk, const std::string &,
+                                              const std::string &result_id) {
+  // Only the thread delivering this result uses its file
+  auto &download = GetDownload(result_id);
+  if (!download.file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()))) {
+    throw ArmoniK::Sdk::Common::ArmoniKSdkException("Unable to write result file " + download.path + ".part");
+  }
+}
+
+void FileDownloadHandler::HandleResponseEnd(const std::string &taskId, const std::string &result_id) {
+  std::string path;
+  {
+    auto &download = GetDownload(result_id);
+    download.file.close();
+    path = download.path;
+    std::lock_guard<std::mutex> _(mutex);
+    downloads.erase(result_id);
+  }
+
+  const auto part_path = path + ".part";
+  if (std::rename(part_path.c_str(), path.c_str()) != 0) {
+    std::remove(part_path.c_str());
+    throw ArmoniK::Sdk::Common::ArmoniKSdkException("Unable to move result file to " + path);
+  }
+  HandleFile(path, taskId, result_id);
+}
+
+void FileDownloadHandler::HandleError(const std::exception &e, const std::string &taskId) {
+  std::vector<std::string> partial_paths;
+  {
+    std::lock_guard<std::mutex> _(mutex);
+    for (auto it = downloads.begin(); it != downloads.end();) {
+      if (it->second.task_id == taskId) {
+        it->second.file.close();
+        partial_paths.push_back(it->second.path + ".part");
+        it = downloads.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  for (auto &&path : partial_paths) {
+    std::remove(path.c_str());
+  }
+  HandleFileError(e, taskId);
+}
+
+FileDownloadHandler::Download &FileDownloadHandler::GetDownload(const std::string &result_id) {
+  std::lock_guard<std::mutex> _(mutex);
+  auto it = downloads.find(result_id);
+  if (it == downloads.end()) {
+    throw ArmoniK::Sdk::Common::ArmoniKSdkException("No download in progress for result " + result_id);
+  }
+  return it->second;
+}
+
+} // namespace Client
+} // namespace Sdk
+} // namespace ArmoniK
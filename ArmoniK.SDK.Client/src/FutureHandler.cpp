@@ -0,0 +1,87 @@
+#include "FutureHandler.h"
+#include <armonik/sdk/common/ArmoniKSdkException.h>
+#include <stdexcept>
+#include <utility>
+
+namespace ArmoniK {
+namespace Sdk {
+namespace Client {
+namespace Internal {
+
+std::future<TaskResult> FutureHandler::Future(const std::string &task_id) {
+  std::lock_guard<std::mutex> _(mutex_);
+  auto it = entries_.emplace(task_id, Entry{}).first;
+  auto future = it->second.promise.get_future();
+  it->second.has_future = true;
+  if (it->second.done) {
+    entries_.erase(it);
+  } else {
+    ++pending_;
+  }
+  return future;
+}
+
+template <class F> void FutureHandler::Complete(const std::string &task_id, F &&f) {
+  auto it = entries_.emplace(task_id, Entry{}).first;
+  if (it->second.done) {
+    return;
+  }
+  f(it->second.promise);
+  it->second.done = true;
+  if (it->second.has_future) {
+    --pending_;
+    entries_.erase(it);
+  }
+}
+
+void FutureHandler::HandleResponse(const std::string &result_payload, const std::string &taskId,
+                                   const std::string &result_id) {
+  std::lock_guard<std::mutex> _(mutex_);
+  Complete(taskId, [&](std::promise<TaskResult> &promise) { promise.set_value({taskId, result_id, result_payload}); });
+}
+
+void FutureHandler::HandleError(const std::exception &e, const std::string &taskId) {
+  // Keep the dynamic type of the error being handled, such as ArmoniKTaskError, when there is one
+  auto error = std::current_exception();
+  if (!error) {
+    error = std::make_exception_ptr(std::runtime_error(e.what()));
+  }
+  std::lock_guard<std::mutex> _(mutex_);
+  Complete(taskId, [&](std::promise<TaskResult> &promise) { promise.set_exception(error); });
+}
+
+void FutureHandler::Discard(const std::string &task_id, const std::string &reason) {
+  std::lock_guard<std::mutex> _(mutex_);
+  // Only the tasks submitted through this handler have an entry
+  if (entries_.find(task_id) != entries_.end()) {
+    Complete(task_id, [&](std::promise<TaskResult> &promise) {
+      promise.set_exception(std::make_exception_ptr(ArmoniK::Sdk::Common::ArmoniKSdkException(reason)));
+    });
+  }
+}
+
+void FutureHandler::DiscardAll(const std::string &reason) {
+  std::lock_guard<std::mutex> _(mutex_);
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (!it->second.done) {
+      it->second.promise.set_exception(std::make_exception_ptr(ArmoniK::Sdk::Common::ArmoniKSdkException(reason)));
+      it->second.done = true;
+    }
+    if (it->second.has_future) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  pending_ = 0;
+}
+
+bool FutureHandler::HasPending() {
+  std::lock_guard<std::mutex> _(mutex_);
+  return pending_ > 0;
+}
+
+} // namespace Internal
+} // namespace Client
+} // namespace Sdk
+} // namespace ArmoniK
@@ -0,0 +1,80 @@
+#include "InputCache.h"
+
+#include <iterator>
+#include <utility>
+
+namespace ArmoniK {
+namespace Sdk {
+namespace Client {
+namespace Internal {
+
+InputCache::InputCache(std::size_t max_size) : max_size_(max_size) {}
+
+InputCache::Entries::iterator InputCache::Lookup(const ContentDigest &digest, const std::string &data) {
+  auto range = index_.equal_range(digest);
+  for (auto it = range.first; it != range.second; ++it) {
+    const auto &cached = *it->second->data;
+    if (&cached == &data || cached == data) {
+      return it->second;
+    }
+  }
+  return entries_.end();
+}
+
+std::string InputCache::Find(const ContentDigest &digest, const std::string &data) {
+  std::lock_guard<std::mutex> _(mutex_);
+  auto entry = Lookup(digest, data);
+  if (entry == entries_.end()) {
+    return {};
+  }
+  entries_.splice(entries_.begin(), entries_, entry);
+  return entry->result_id;
+}
+
+void InputCache::Insert(const ContentDigest &digest, std::shared_ptr<const std::string> data, std::string result_id) {
+  if (max_size_ == 0 || data->size() > max_size_) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> _(mutex_);
+  auto entry = Lookup(digest, *data);
+  if (entry != entries_.end()) {
+    entry->result_id = std::move(result_id);
+    entries_.splice(entries_.begin(), entries_, entry);
+    return;
+  }
+
+  while (!entries_.empty() && size_ + data->size() > max_size_) {
+    auto &oldest = entries_.back();
+    auto range = index_.equal_range(oldest.digest);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == std::prev(entries_.end())) {
+        index_.erase(it);
+        break;
+      }
+    }
+    size_ -= oldest.data->size();
+    entries_.pop_back();
+  }
+
+  size_ += data->size();
+  entries_.push_front({digest, std::move(data), std::move(result_id)});
+  index_.emplace(digest, entries_.begin());
+}
+
+void InputCache::Clear() {
+  std::lock_guard<std::mutex> _(mutex_);
+  index_.clear();
+  entries_.clear();
+  size_ = 0;
+}
+
+std::size_t InputCache::Size() {
+  std::lock_guard<std::mutex> _(mutex_);
+  return size_;
+}
+
+} // namespace Internal
+} // namespace Client
+} // namespace Sdk
+} // namespace ArmoniK
@@ -1,8 +1,8 @@
 #include "armonik/sdk/client/SessionService.h"
 #include "SessionServiceImpl.h"
+#include "TaskSubmitterImpl.h"
+#include <armonik/sdk/common/BlobDefinition.h>
 #include <armonik/sdk/common/Version.h>
-#include <fstream>
-#include <sstream>
 #include <string>
 #include <utility>
 
@@ -49,15 +49,91 @@ std::vector<std::string> SessionService::Submit(const std::vector<Common::TaskDe
   return impl->Submit(requests, std::move(handler));
 }
 
+std::vector<TaskFuture> SessionService::SubmitWithFutures(const std::vector<Common::TaskDefinition> &requests,
+                                                          const ArmoniK::Sdk::Common::TaskOptions &task_options) {
+  ensure_valid();
+  return impl->SubmitWithFutures(requests, task_options);
+}
+
+std::vector<TaskFuture> SessionService::SubmitWithFutures(const std::vector<Common::TaskDefinition> &requests) {
+  ensure_valid();
+  return impl->SubmitWithFutures(requests, impl->getTaskOptions());
+}
+
+TaskSubmitter SessionService::CreateSubmitter(std::shared_ptr<IServiceInvocationHandler> handler,
+                                              const ArmoniK::Sdk::Common::TaskOptions &task_options,
+                                              std::size_t max_in_flight) {
+  ensure_valid();
+  return TaskSubmitter(impl->CreateSubmitter(std::move(handler), task_options, max_in_flight));
+}
+
+TaskSubmitter SessionService::CreateSubmitter(std::shared_ptr<IServiceInvocationHandler> handler,
+                                              std::size_t max_in_flight) {
+  ensure_valid();
+  return TaskSubmitter(impl->CreateSubmitter(std::move(handler), impl->getTaskOptions(), max_in_flight));
+}
+
 void SessionService::UploadLibrary(const std::string &library_path, Common::DynamicLibrary &lib) {
   ensure_valid();
-  std::ifstream f(library_path, std::ios::binary);
-  if (!f) {
-    throw std::runtime_error("Cannot open library file: " + library_path);
+  lib.library_blob_id = impl->UploadLibrary(Internal::BlobSource::FromFile(library_path));
+}
+
+namespace {
+std::vector<Common::BlobDefinition> blob_definitions(std::vector<std::string> &&blob_ids) {
+  std::vector<Common::BlobDefinition> blobs;
+  blobs.reserve(blob_ids.size());
+  for (auto &&blob_id : blob_ids) {
+    blobs.push_back(Common::BlobDefinition::FromBlobId(std::move(blob_id)));
   }
-  std::ostringstream buf;
-  buf << f.rdbuf();
-  lib.library_blob_id = impl->UploadLibrary(buf.str());
+  return blobs;
+}
+} // namespace
+
+Common::BlobDefinition SessionService::UploadBlob(const std::string &data) {
+  ensure_valid();
+  return blob_definitions(impl->UploadBlobs({Internal::BlobSource::FromData(data)})).front();
+}
+
+std::vector<Common::BlobDefinition> SessionService::UploadBlobs(const std::vector<std::string> &data) {
+  ensure_valid();
+  std::vector<Internal::BlobSource> sources;
+  sources.reserve(data.size());
+  for (const auto &d : data) {
+    sources.push_back(Internal::BlobSource::FromData(d));
+  }
+  return blob_definitions(impl->UploadBlobs(sources));
+}
+
+Common::BlobDefinition SessionService::UploadBlobFromFile(const std::string &path) {
+  ensure_valid();
+  return blob_definitions(impl->UploadBlobs({Internal::BlobSource::FromFile(path)})).front();
+}
+
+std::vector<Common::BlobDefinition> SessionService::UploadBlobsFromFiles(const std::vector<std::string> &paths) {
+  ensure_valid();
+  std::vector<Internal::BlobSource> sources;
+  sources.reserve(paths.size());
+  for (const auto &path : paths) {
+    sources.push_back(Internal::BlobSource::FromFile(path));
+  }
+  return blob_definitions(impl->UploadBlobs(sources));
+}
+
+void SessionService::CleanupBlobs(const std::vector<Common::BlobDefinition> &blobs) {
+  ensure_valid();
+  std::vector<std::string> blob_ids;
+  blob_ids.reserve(blobs.size());
+  for (const auto &blob : blobs) {
+    if (blob.IsBlobId()) {
+      blob_ids.push_back(blob.GetBlobId());
+    }
+  }
+  impl->CleanupBlobs(std::move(blob_ids));
+}
+
+void SessionService::CleanupBlobs() {
+  ensure_valid();
+  impl->CleanupBlobs();
 }
 
 void SessionService::WaitResults(std::set<std::string> task_ids, WaitBehavior waitBehavior,
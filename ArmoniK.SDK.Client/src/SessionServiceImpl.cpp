@@ -1,6 +1,11 @@
 #include "SessionServiceImpl.h"
+#include "AsyncRpc.h"
 #include "Batcher.h"
+#include "BlobSource.h"
+#include "TaskSubmitterImpl.h"
 #include "armonik/sdk/client/IServiceInvocationHandler.h"
+#include "armonik/sdk/client/IStreamingServiceInvocationHandler.h"
+#include <armonik/client/events_service.grpc.pb.h>
 #include <armonik/client/results/ResultsClient.h>
 #include <armonik/client/results_common.pb.h>
 #include <armonik/client/results_service.grpc.pb.h>
@@ -18,8 +23,16 @@
 #include <armonik/sdk/common/TaskPayload.h>
 #include <armonik/sdk/common/Version.h>
 #include <armonik/sdk/common/internal/ConventionPayload.h>
+#include <algorithm>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <map>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -29,26 +42,83 @@ namespace Client {
 namespace Internal {
 
 namespace {
+/**
+ * @brief Period after which the cached service configuration is fetched again
+ */
+constexpr std::chrono::minutes ServiceConfigurationRefreshPeriod{5};
+
+/**
+ * @brief Maximum number of results kept while not registered
+ */
+constexpr std::size_t UnregisteredResultsMaxCount = 10000;
+
+/**
+ * @brief Number of consecutive failed waits after which the futures tracking gives up and fails the pending futures
+ */
+constexpr int FutureTrackingMaxFailures = 5;
+
+/**
+ * @brief Creates the controller of a batch size
+ * @param control_plane Configuration of the adaptive batching
+ * @param initial Initial batch size
+ * @return The controller
+ */
+BatchSizeController batch_size_controller(const Common::ControlPlane &control_plane, int initial) {
+  return BatchSizeController(static_cast<std::size_t>(std::max(initial, 1)),
+                             static_cast<std::size_t>(control_plane.getMinBatchSize()),
+                             static_cast<std::size_t>(control_plane.getMaxBatchSize()),
+                             std::chrono::milliseconds(std::max(control_plane.getBatchTargetLatencyMs(), 0)));
+}
+
+/**
+ * @brief Get the maximum size of the data chunks accepted by the Results service
+ * @param pool The channel pool to use to perform the request
+ * @return Maximum size of a chunk in bytes
+ */
+std::size_t get_data_chunk_max_size(ArmoniK::Sdk::Client::Internal::ChannelPool &pool) {
+  return pool.WithResults([](auto &results) {
+    grpc::ClientContext context{};
+    armonik::api::grpc::v1::Empty request{};
+    armonik::api::grpc::v1::results::ResultsServiceConfigurationResponse response{};
+    auto status = results.GetServiceConfiguration(&context, request, &response);
+    if (!status.ok()) {
+      throw armonik::api::common::exceptions::ArmoniKApiException("Unable to get result service configuration: " +
+                                                                  status.error_message());
+    }
+    return static_cast<std::size_t>(response.data_chunk_max_size());
+  });
+}
+
 /**
  * @brief Upload a large result using a stream, retrying the upload in case of error
+ *
+ * @details
+ * The chunks are written with the buffer hint so that gRPC can coalesce them instead of flushing every message, and
+ * the last one is written together with the half-close. The request message is reused for all the chunks, so its
+ * buffer is allocated once per upload. Each upload picks its own channel from the pool, so concurrent uploads of
+ * several results are spread over distinct connections. The content is read from its source chunk by chunk, so a file
+ * is never loaded as a whole.
+ *
+ * @note The Results service has no resumable upload: a retry restarts from the first byte.
  * @param pool The channel pool to use to perform the requests
  * @param session Id of the session where the result has been created
  * @param result_id Id of the result to upload
- * @param data Content of the result to upload
+ * @param source Content of the result to upload
  * @param data_max_chunk_size Size of the chunks to upload the data
  * @param logger Logger
  */
 void upload_large_result(ArmoniK::Sdk::Client::Internal::ChannelPool &pool, std::string session, std::string result_id,
-                         absl::string_view data, std::size_t data_chunk_max_size,
+                         const ArmoniK::Sdk::Client::Internal::BlobSource &source, std::size_t data_chunk_max_size,
                          armonik::api::common::logger::ILogger &logger) {
 
   std::exception_ptr eptr;
+  const std::size_t chunk_size = std::max<std::size_t>(data_chunk_max_size, 1);
+  const auto corked = grpc::WriteOptions().set_buffer_hint();
 
   // Retry the upload at most 3 times
   const int max_retry = 3;
   for (int retry = 0; retry < max_retry; ++retry) {
     eptr = nullptr;
-    auto remaining_data = data;
 
     // If retry is available (not the last iteration), add prefix to the logs to indicate the upload will be retried
     // even though there was an error, and log errors as warnings
@@ -64,26 +134,34 @@ void upload_large_result(ArmoniK::Sdk::Client::Internal::ChannelPool &pool, std:
       armonik::api::grpc::v1::results::UploadResultDataRequest request{};
       armonik::api::grpc::v1::results::UploadResultDataResponse response{};
 
-      auto client = armonik::api::grpc::v1::results::Results::NewStub(channel.channel);
-      auto stream = client->UploadResultData(&context, &response);
+      auto stream = channel.connection->results->UploadResultData(&context, &response);
 
-      // Send message header with the result identifier
+      // Send message header with the result identifier, buffered with the first chunk
       request.mutable_id()->set_session_id(session);
       request.mutable_id()->set_result_id(result_id);
-      stream->Write(request);
+      if (!stream->Write(request, source.Size() == 0 ? grpc::WriteOptions() : corked)) {
+        throw armonik::api::common::exceptions::ArmoniKApiException("Unable to start upload result " + result_id);
+      }
       request.clear_id();
 
-      // Chunk the content to send it in multiple messages
-      while (!remaining_data.empty()) {
-        auto chunk = remaining_data.substr(0, data_chunk_max_size);
-        request.mutable_data_chunk()->assign(chunk.data(), chunk.size());
-        if (!stream->Write(request)) {
+      // Chunk the content to send it in multiple messages, reading the file sources directly into the message
+      auto &data_chunk = *request.mutable_data_chunk();
+      data_chunk.reserve(std::min(source.Size(), chunk_size));
+      for (std::size_t offset = 0; offset < source.Size();) {
+        const auto length = std::min(chunk_size, source.Size() - offset);
+        auto chunk = source.Read(offset, length, data_chunk);
+        if (chunk.data() != data_chunk.data()) {
+          data_chunk.assign(chunk.data(), chunk.size());
+        }
+        offset += length;
+        const bool last = offset == source.Size();
+        if (!stream->Write(request, last ? grpc::WriteOptions(corked).set_last_message() : corked)) {
           throw armonik::api::common::exceptions::ArmoniKApiException("Unable to continue upload result " + result_id);
         }
-        remaining_data = remaining_data.substr(chunk.size());
       }
 
-      if (!stream->WritesDone()) {
+      // Writing the last chunk already half-closed the stream
+      if (source.Size() == 0 && !stream->WritesDone()) {
         throw armonik::api::common::exceptions::ArmoniKApiException("Unable to upload result " + result_id);
       }
       auto status = stream->Finish();
@@ -94,16 +172,15 @@ void upload_large_result(ArmoniK::Sdk::Client::Internal::ChannelPool &pool, std:
 
       // If the uploaded size is different than the actual data size, upload must be retried
       // Otherwise, we are good to go.
-      if (response.result().size() == std::int64_t(data.size())) {
+      if (response.result().size() == std::int64_t(source.Size())) {
         break;
       }
 
-      // If the uploaded size is different, delete the uploaded data from the object storage
+      // If the uploaded size is different, delete the uploaded data from the object storage, reusing the channel as
+      // acquiring another one could wait forever on a full pool
       try {
-        pool.WithChannel([&](auto channel) {
-          armonik::api::client::ResultsClient(armonik::api::grpc::v1::results::Results::NewStub(channel))
-              .delete_results_data(session, {std::move(*response.mutable_result()->mutable_result_id())});
-        });
+        armonik::api::client::ResultsClient(armonik::api::grpc::v1::results::Results::NewStub(channel.channel))
+            .delete_results_data(session, {std::move(*response.mutable_result()->mutable_result_id())});
       } catch (const std::exception &e) {
         logger.warning("Unable to clean data for " + result_id + ": " + e.what());
       } catch (...) {
@@ -112,7 +189,7 @@ void upload_large_result(ArmoniK::Sdk::Client::Internal::ChannelPool &pool, std:
 
       std::stringstream ss;
       ss << retry_notif << "Corrupted result " << result_id << " upload: mismatched between client size ("
-         << data.size() << " B) and server size (" << response.result().size() << ")";
+         << source.Size() << " B) and server size (" << response.result().size() << ")";
 
       throw std::make_exception_ptr(armonik::api::common::exceptions::ArmoniKApiException(ss.str()));
     } catch (const std::exception &e) {
@@ -128,25 +205,327 @@ void upload_large_result(ArmoniK::Sdk::Client::Internal::ChannelPool &pool, std:
     std::rethrow_exception(eptr);
   }
 }
+
+/**
+ * @brief Download a result using a stream, delivering its chunks as they are received
+ * @param pool The channel pool to use to perform the requests
+ * @param session Id of the session of the result
+ * @param result_id Id of the result to download
+ * @param on_chunk Function called with each chunk, in order
+ */
+void download_result_chunks(ArmoniK::Sdk::Client::Internal::ChannelPool &pool, const std::string &session,
+                            const std::string &result_id, const std::function<void(absl::string_view)> &on_chunk) {
+  pool.WithResults([&](auto &results) {
+    grpc::ClientContext context{};
+    armonik::api::grpc::v1::results::DownloadResultDataRequest request{};
+    armonik::api::grpc::v1::results::DownloadResultDataResponse response{};
+    request.set_session_id(session);
+    request.set_result_id(result_id);
+
+    auto stream = results.DownloadResultData(&context, request);
+    while (stream->Read(&response)) {
+      on_chunk(response.data_chunk());
+    }
+    auto status = stream->Finish();
+    if (!status.ok()) {
+      throw armonik::api::common::exceptions::ArmoniKApiException("Unable to download result " + result_id + ": " +
+                                                                  status.error_message());
+    }
+  });
+}
+
+/**
+ * @brief Start functions of the asynchronous calls, see AsyncUnary
+ */
+const auto start_create_results_metadata = [](ChannelPool::Connection &connection, auto *context, auto *request,
+                                              auto *response, auto done) {
+  connection.results->async()->CreateResultsMetaData(context, request, response, std::move(done));
+};
+const auto start_create_results = [](ChannelPool::Connection &connection, auto *context, auto *request,
+                                     auto *response, auto done) {
+  connection.results->async()->CreateResults(context, request, response, std::move(done));
+};
+const auto start_submit_tasks = [](ChannelPool::Connection &connection, auto *context, auto *request,
+                                   auto *response, auto done) {
+  connection.tasks->async()->SubmitTasks(context, request, response, std::move(done));
+};
+const auto start_list_results = [](ChannelPool::Connection &connection, auto *context, auto *request,
+                                   auto *response, auto done) {
+  connection.results->async()->ListResults(context, request, response, std::move(done));
+};
+
+/**
+ * @brief Index the results of a creation response by name
+ * @param response Response of CreateResultsMetaData or CreateResults
+ * @return Result ids by result name
+ */
+template <class Response> std::map<std::string, std::string> result_ids_by_name(Response &&response) {
+  std::map<std::string, std::string> ids;
+  for (auto &&result : *response.mutable_results()) {
+    ids.emplace(std::move(*result.mutable_name()), std::move(*result.mutable_result_id()));
+  }
+  return ids;
+}
+
+/**
+ * @brief List the results of a session which completed from a given date, by completion date
+ * @param pool The channel pool to use to perform the requests
+ * @param session Id of the session
+ * @param since Completion date, since the epoch, from which the results are listed
+ * @param page_size Number of results per request
+ * @param f Function called with each listed result, as f(std::move(result))
+ */
+template <class F>
+void list_completed_results(ChannelPool &pool, const std::string &session, std::chrono::nanoseconds since,
+                            int page_size, F &&f) {
+  namespace results = armonik::api::grpc::v1::results;
+  results::ListResultsRequest request{};
+  auto &filter = *request.mutable_filters()->add_or_();
+
+  auto session_filter = filter.add_and_();
+  session_filter->mutable_field()->mutable_result_raw_field()->set_field(results::RESULT_RAW_ENUM_FIELD_SESSION_ID);
+  session_filter->mutable_filter_string()->set_value(session);
+  session_filter->mutable_filter_string()->set_operator_(armonik::api::grpc::v1::FILTER_STRING_OPERATOR_EQUAL);
+
+  auto status_filter = filter.add_and_();
+  status_filter->mutable_field()->mutable_result_raw_field()->set_field(results::RESULT_RAW_ENUM_FIELD_STATUS);
+  status_filter->mutable_filter_status()->set_value(armonik::api::grpc::v1::result_status::RESULT_STATUS_CREATED);
+  status_filter->mutable_filter_status()->set_operator_(armonik::api::grpc::v1::FILTER_STATUS_OPERATOR_NOT_EQUAL);
+
+  auto date_filter = filter.add_and_();
+  date_filter->mutable_field()->mutable_result_raw_field()->set_field(results::RESULT_RAW_ENUM_FIELD_COMPLETED_AT);
+  auto date = date_filter->mutable_filter_date()->mutable_value();
+  date->set_seconds(std::chrono::duration_cast<std::chrono::seconds>(since).count());
+  date->set_nanos(static_cast<std::int32_t>((since % std::chrono::seconds(1)).count()));
+  date_filter->mutable_filter_date()->set_operator_(armonik::api::grpc::v1::FILTER_DATE_OPERATOR_AFTER_OR_EQUAL);
+
+  request.set_page_size(page_size);
+  request.mutable_sort()->set_direction(armonik::api::grpc::v1::sort_direction::SORT_DIRECTION_ASC);
+  request.mutable_sort()->mutable_field()->mutable_result_raw_field()->set_field(
+      results::RESULT_RAW_ENUM_FIELD_COMPLETED_AT);
+
+  for (int page = 0;; ++page) {
+    request.set_page(page);
+    results::ListResultsResponse response{};
+    pool.WithResults([&](auto &stub) {
+      grpc::ClientContext context{};
+      auto status = stub.ListResults(&context, request, &response);
+      if (!status.ok()) {
+        throw RpcError("Unable to list completed results", status);
+      }
+    });
+    const auto count = response.results_size();
+    for (auto &result : *response.mutable_results()) {
+      f(std::move(result));
+    }
+    if (count < page_size) {
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Completion date of a result
+ * @param result The result
+ * @return Completion date since the epoch
+ */
+std::chrono::nanoseconds completion_date(const armonik::api::grpc::v1::results::ResultRaw &result) {
+  const auto &date = result.completed_at();
+  return std::chrono::seconds(date.seconds()) + std::chrono::nanoseconds(date.nanos());
+}
+
+/**
+ * @brief Latest completion date of the results of a session, as recorded by the control plane
+ * @param pool The channel pool to use to perform the request
+ * @param session Id of the session
+ * @return Completion date since the epoch, or zero if no result of the session is completed
+ */
+std::chrono::nanoseconds latest_completion_date(ChannelPool &pool, const std::string &session) {
+  namespace results = armonik::api::grpc::v1::results;
+  results::ListResultsRequest request{};
+  auto &filter = *request.mutable_filters()->add_or_();
+
+  auto session_filter = filter.add_and_();
+  session_filter->mutable_field()->mutable_result_raw_field()->set_field(results::RESULT_RAW_ENUM_FIELD_SESSION_ID);
+  session_filter->mutable_filter_string()->set_value(session);
+  session_filter->mutable_filter_string()->set_operator_(armonik::api::grpc::v1::FILTER_STRING_OPERATOR_EQUAL);
+
+  auto status_filter = filter.add_and_();
+  status_filter->mutable_field()->mutable_result_raw_field()->set_field(results::RESULT_RAW_ENUM_FIELD_STATUS);
+  status_filter->mutable_filter_status()->set_value(armonik::api::grpc::v1::result_status::RESULT_STATUS_COMPLETED);
+  status_filter->mutable_filter_status()->set_operator_(armonik::api::grpc::v1::FILTER_STATUS_OPERATOR_EQUAL);
+
+  request.set_page(0);
+  request.set_page_size(1);
+  request.mutable_sort()->set_direction(armonik::api::grpc::v1::sort_direction::SORT_DIRECTION_DESC);
+  request.mutable_sort()->mutable_field()->mutable_result_raw_field()->set_field(
+      results::RESULT_RAW_ENUM_FIELD_COMPLETED_AT);
+
+  results::ListResultsResponse response{};
+  pool.WithResults([&](auto &stub) {
+    grpc::ClientContext context{};
+    auto status = stub.ListResults(&context, request, &response);
+    if (!status.ok()) {
+      throw armonik::api::common::exceptions::ArmoniKApiException("Unable to list completed results: " +
+                                                                  status.error_message());
+    }
+  });
+  return response.results().empty() ? std::chrono::nanoseconds(0) : completion_date(response.results(0));
+}
+
+/**
+ * @brief Subscription to the result status updates of a session using the events stream
+ *
+ * @details
+ * The stream is consumed by a background thread which accumulates the updates until they are fetched with
+ * WaitUpdates(). The updates are only received once the stream is established, which is reported once by
+ * TakeEstablished() so that the results completed before can be listed. The subscription is cancelled when the object
+ * is destroyed.
+ */
+class ResultEventsSubscription {
+public:
+  /**
+   * @brief Result status update
+   */
+  using Update = std::pair<std::string, armonik::api::grpc::v1::result_status::ResultStatus>;
+
+  /**
+   * @brief Subscribe to the result status updates of the given session
+   * @param pool The channel pool to use to open the stream
+   * @param session Id of the session
+   * @param logger Logger
+   */
+  ResultEventsSubscription(ChannelPool &pool, std::string session, armonik::api::common::logger::ILogger &logger)
+      : pool_(pool), channel_(pool.AcquireChannel()), session_(std::move(session)), logger_(logger) {
+    thread_ = std::thread([this]() { Run(); });
+  }
+
+  ResultEventsSubscription(const ResultEventsSubscription &) = delete;
+  ResultEventsSubscription &operator=(const ResultEventsSubscription &) = delete;
+
+  /**
+   * @brief Cancel the subscription and wait for the background thread to finish
+   */
+  ~ResultEventsSubscription() {
+    context_.TryCancel();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    pool_.ReleaseChannel(channel_);
+  }
+
+  /**
+   * @brief Check if the stream is still alive
+   * @return true if updates can still be received
+   */
+  bool Healthy() {
+    std::lock_guard<std::mutex> _(mutex_);
+    return !stopped_;
+  }
+
+  /**
+   * @brief Check if the stream has been established since the last call
+   * @return true once the server has acknowledged the subscription, or once the stream has stopped before
+   */
+  bool TakeEstablished() {
+    std::lock_guard<std::mutex> _(mutex_);
+    return std::exchange(established_, false);
+  }
+
+  /**
+   * @brief Wait until updates are received, the stream is established or stopped, or the deadline is reached
+   * @param deadline Time until which to wait
+   * @return The updates received since the last call
+   */
+  std::vector<Update> WaitUpdates(std::chrono::steady_clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait_until(lock, deadline, [this]() { return stopped_ || established_ || !updates_.empty(); });
+    std::vector<Update> updates;
+    updates.swap(updates_);
+    return updates;
+  }
+
+private:
+  /**
+   * @brief Consume the events stream
+   */
+  void Run() {
+    armonik::api::grpc::v1::events::EventSubscriptionRequest request;
+    request.set_session_id(session_);
+    request.add_returned_events(armonik::api::grpc::v1::events::EVENTS_ENUM_RESULT_STATUS_UPDATE);
+
+    auto stub = armonik::api::grpc::v1::events::Events::NewStub(channel_);
+    auto reader = stub->GetEvents(&context_, request);
+
+    // The server acknowledges the subscription with its initial metadata, from which no update is missed
+    reader->WaitForInitialMetadata();
+    {
+      std::lock_guard<std::mutex> _(mutex_);
+      established_ = true;
+      condition_.notify_one();
+    }
+
+    armonik::api::grpc::v1::events::EventSubscriptionResponse response;
+    while (reader->Read(&response)) {
+      if (!response.has_result_status_update()) {
+        continue;
+      }
+      auto &update = *response.mutable_result_status_update();
+      std::lock_guard<std::mutex> _(mutex_);
+      updates_.emplace_back(std::move(*update.mutable_result_id()), update.status());
+      condition_.notify_one();
+    }
+
+    auto status = reader->Finish();
+    if (!status.ok() && status.error_code() != grpc::StatusCode::CANCELLED) {
+      logger_.warning("Result events stream stopped, falling back to polling: " + status.error_message());
+    }
+
+    std::lock_guard<std::mutex> _(mutex_);
+    stopped_ = true;
+    condition_.notify_all();
+  }
+
+  ChannelPool &pool_;
+  std::shared_ptr<grpc::Channel> channel_;
+  std::string session_;
+  armonik::api::common::logger::ILogger &logger_;
+  grpc::ClientContext context_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::vector<Update> updates_;
+  bool established_ = false;
+  bool stopped_ = false;
+  std::thread thread_;
+};
 } // namespace
 
 const std::string &SessionServiceImpl::getSession() const { return session; }
 
+const Common::TaskOptions &SessionServiceImpl::getTaskOptions() const { return taskOptions; }
+
+std::size_t SessionServiceImpl::DataChunkMaxSize() {
+  if (override_message_size_) {
+    return override_message_size_;
+  }
+
+  // Concurrent submissions wait for a single fetch
+  std::lock_guard<std::mutex> _(data_chunk_max_size_mutex_);
+  auto now = std::chrono::steady_clock::now();
+  if (data_chunk_max_size_ == 0 || now >= data_chunk_max_size_expiry_) {
+    data_chunk_max_size_ = get_data_chunk_max_size(channel_pool);
+    data_chunk_max_size_expiry_ = now + ServiceConfigurationRefreshPeriod;
+  }
+  return data_chunk_max_size_;
+}
+
 std::vector<std::string> SessionServiceImpl::SubmitRaw(const std::vector<std::string> &serialized_payloads,
                                                        const std::vector<std::vector<std::string>> &data_dependencies,
                                                        std::shared_ptr<IServiceInvocationHandler> handler,
                                                        const Common::TaskOptions &task_options) {
 
   const std::size_t message_overhead = 128;
-  std::size_t data_chunk_max_size =
-      override_message_size_ ? override_message_size_ : channel_pool.WithChannel([](auto channel) {
-        return armonik::api::client::ResultsClient(armonik::api::grpc::v1::results::Results::NewStub(channel))
-            .get_service_configuration()
-            .data_chunk_max_size;
-      });
-
-  // Number of bytes to be sent in the next CreateResult request
-  std::size_t data_batched = 0;
+  std::size_t data_chunk_max_size = DataChunkMaxSize();
 
   std::vector<std::string> input_result_ids(serialized_payloads.size());
   std::vector<std::string> output_result_ids(serialized_payloads.size());
@@ -157,94 +536,104 @@ std::vector<std::string> SessionServiceImpl::SubmitRaw(const std::vector<std::st
   // Batch Result metadata creation (for outputs and large inputs) and upload inputs
   Batcher<std::pair<std::size_t, bool>> create_metadata_and_upload_batcher(
       submit_batch_size_, [&](std::vector<std::pair<std::size_t, bool>> &&batch) {
-        join_set.Spawn([&, batch = std::move(batch)]() {
-          std::vector<std::string> names(batch.size());
-          for (std::size_t j = 0; j < batch.size(); ++j) {
-            int i = batch[j].first;
-            bool is_output = batch[j].second;
-
-            names[j] = (is_output ? "output-" : "input-") + std::to_string(i);
-          }
-
-          auto reply = channel_pool.WithChannel([&](auto channel) {
-            return armonik::api::client::ResultsClient(armonik::api::grpc::v1::results::Results::NewStub(channel))
-                .create_results_metadata(session, names);
-          });
+        armonik::api::grpc::v1::results::CreateResultsMetaDataRequest request;
+        request.set_session_id(session);
+        std::vector<std::string> names(batch.size());
+        for (std::size_t j = 0; j < batch.size(); ++j) {
+          int i = batch[j].first;
+          bool is_output = batch[j].second;
+
+          names[j] = (is_output ? "output-" : "input-") + std::to_string(i);
+          request.add_results()->set_name(names[j]);
+        }
 
-          // threadsafe as the index is unique among all batches
-          for (std::size_t j = 0; j < batch.size(); ++j) {
-            std::size_t i = batch[j].first;
-            bool is_output = batch[j].second;
-
-            if (is_output) {
-              output_result_ids[i] = std::move(reply[names[j]]);
-            } else {
-              input_result_ids[i] = std::move(reply[names[j]]);
-
-              // Upload result using stream
-              join_set.Spawn([&, i]() {
-                upload_large_result(channel_pool, session, input_result_ids[i], serialized_payloads[i],
-                                    data_chunk_max_size, logger_);
-              });
-            }
-          }
-        });
+        const auto items = batch.size();
+        AsyncUnary<armonik::api::grpc::v1::results::CreateResultsMetaDataResponse>(
+            channel_pool, join_set, std::move(request), start_create_results_metadata,
+            [&, batch = std::move(batch), names = std::move(names)](auto &&response) {
+              auto reply = result_ids_by_name(response);
+
+              // threadsafe as the index is unique among all batches
+              for (std::size_t j = 0; j < batch.size(); ++j) {
+                std::size_t i = batch[j].first;
+                bool is_output = batch[j].second;
+
+                if (is_output) {
+                  output_result_ids[i] = std::move(reply[names[j]]);
+                } else {
+                  input_result_ids[i] = std::move(reply[names[j]]);
+
+                  // Upload result using stream
+                  join_set.Spawn([&, i]() {
+                    upload_large_result(channel_pool, session, input_result_ids[i],
+                                        BlobSource::FromData(serialized_payloads[i]), data_chunk_max_size, logger_);
+                  });
+                }
+              }
+            },
+            "Unable to create results metadata", submit_batch_size_.Observe(items));
       });
 
-  // Batch Result data creation (for small inputs)
-  Batcher<std::size_t> create_data_batcher(submit_batch_size_, [&](std::vector<std::size_t> &&batch) {
-    // Reset the number of bytes to be sent in the current batch
-    data_batched = 0;
-
-    join_set.Spawn([&, batch = std::move(batch)]() {
-      std::vector<std::pair<std::string, std::string>> results(batch.size());
-      for (std::size_t j = 0; j < batch.size(); ++j) {
-        std::size_t i = batch[j];
-        results[j] = {"input-" + std::to_string(i), serialized_payloads[i]};
-      }
-      auto reply = channel_pool.WithChannel([&](auto channel) {
-        return armonik::api::client::ResultsClient(armonik::api::grpc::v1::results::Results::NewStub(channel))
-            .create_results(session, results);
-      });
+  // Batch Result data creation (for small inputs), each request holding at most a data chunk
+  Batcher<std::size_t> create_data_batcher(
+      submit_batch_size_,
+      [&](std::vector<std::size_t> &&batch) {
+        armonik::api::grpc::v1::results::CreateResultsRequest request;
+        request.set_session_id(session);
+        for (std::size_t i : batch) {
+          auto result = request.add_results();
+          result->set_name("input-" + std::to_string(i));
+          result->set_data(serialized_payloads[i]);
+        }
 
-      // threadsafe as the index is unique among all batches
-      for (std::size_t j = 0; j < batch.size(); ++j) {
-        std::size_t i = batch[j];
-        input_result_ids[i] = std::move(reply[results[j].first]);
-      }
-    });
-  });
+        const auto items = batch.size();
+        AsyncUnary<armonik::api::grpc::v1::results::CreateResultsResponse>(
+            channel_pool, join_set, std::move(request), start_create_results,
+            [&, batch = std::move(batch)](auto &&response) {
+              auto reply = result_ids_by_name(response);
+
+              // threadsafe as the index is unique among all batches
+              for (std::size_t i : batch) {
+                input_result_ids[i] = std::move(reply["input-" + std::to_string(i)]);
+              }
+            },
+            "Unable to create results", submit_batch_size_.Observe(items));
+      },
+      data_chunk_max_size);
 
   // Batch task submission
+  const auto grpc_task_options = static_cast<armonik::api::grpc::v1::TaskOptions>(task_options);
   Batcher<std::size_t> submit_batcher(submit_batch_size_, [&](std::vector<std::size_t> &&batch) {
-    join_set.Spawn([&, batch = std::move(batch)]() {
-      std::vector<armonik::api::common::TaskCreation> requests(batch.size());
-      for (std::size_t j = 0; j < batch.size(); ++j) {
-        std::size_t i = batch[j];
-        const auto &deps = data_dependencies[i];
-        auto &request = requests[j];
-
-        request = armonik::api::common::TaskCreation();
-        request.payload_id = input_result_ids[i];
-        request.expected_output_keys.push_back(output_result_ids[i]);
-        request.data_dependencies.insert(request.data_dependencies.end(), deps.begin(), deps.end());
-      }
-
-      auto reply = channel_pool.WithChannel([&](auto channel) {
-        return armonik::api::client::TasksClient(armonik::api::grpc::v1::tasks::Tasks::NewStub(channel))
-            .submit_tasks(session, std::move(requests), static_cast<armonik::api::grpc::v1::TaskOptions>(task_options));
-      });
+    armonik::api::grpc::v1::tasks::SubmitTasksRequest request;
+    request.set_session_id(session);
+    *request.mutable_task_options() = grpc_task_options;
+    for (std::size_t i : batch) {
+      const auto &deps = data_dependencies[i];
+      auto creation = request.add_task_creations();
+      creation->set_payload_id(input_result_ids[i]);
+      creation->add_expected_output_keys(output_result_ids[i]);
+      creation->mutable_data_dependencies()->Add(deps.begin(), deps.end());
+    }
 
-      // threadsafe as the index is unique among all batches
-      for (std::size_t j = 0; j < batch.size(); ++j) {
-        std::size_t i = batch[j];
-        task_ids[i] = std::move(reply[j].task_id);
+    const auto items = batch.size();
+    AsyncUnary<armonik::api::grpc::v1::tasks::SubmitTasksResponse>(
+        channel_pool, join_set, std::move(request), start_submit_tasks,
+        [&, batch = std::move(batch)](auto &&response) {
+          if (static_cast<std::size_t>(response.task_infos_size()) != batch.size()) {
+            throw armonik::api::common::exceptions::ArmoniKApiException("Unexpected number of submitted tasks");
+          }
 
-        std::stringstream ss;
-        ss << "Submitted task " << task_ids[i] << " with result " << output_result_ids[i];
-        logger_.debug(ss.str());
-      }
-    });
+          // threadsafe as the index is unique among all batches
+          for (std::size_t j = 0; j < batch.size(); ++j) {
+            std::size_t i = batch[j];
+            task_ids[i] = std::move(*response.mutable_task_infos(j)->mutable_task_id());
+
+            std::stringstream ss;
+            ss << "Submitted task " << task_ids[i] << " with result " << output_result_ids[i];
+            logger_.debug(ss.str());
+          }
+        },
+        "Unable to submit tasks", submit_batch_size_.Observe(items));
   });
 
   // Create all results
@@ -255,13 +644,7 @@ std::vector<std::string> SessionServiceImpl::SubmitRaw(const std::vector<std::st
     if (payload_size + message_overhead >= data_chunk_max_size) {
       create_metadata_and_upload_batcher.Add({i, false});
     } else {
-      // If current batch would be too large, send it right now
-      if (data_batched + payload_size + message_overhead >= data_chunk_max_size) {
-        create_data_batcher.ProcessBatch();
-      }
-
-      data_batched += payload_size + message_overhead;
-      create_data_batcher.Add(i);
+      create_data_batcher.Add(i, payload_size + message_overhead);
     }
   }
 
@@ -279,14 +662,19 @@ std::vector<std::string> SessionServiceImpl::SubmitRaw(const std::vector<std::st
   submit_batcher.ProcessBatch();
   join_set.Wait();
 
-  std::lock_guard<std::mutex> lock(maps_mutex);
+  task_registry_.Add(task_ids, output_result_ids, handler);
 
-  for (std::size_t i = 0; i < serialized_payloads.size(); ++i) {
-    const auto &result_id = output_result_ids[i];
-    const auto &task_id = task_ids[i];
-    result_handlers[result_id] = handler;
-    resultId_taskId[result_id] = task_id;
-    taskId_resultId[task_id] = result_id;
+  // Some tasks may have completed before being registered: their results are handed to the waits
+  {
+    std::lock_guard<std::mutex> _(tracker_mutex_);
+    for (auto &result_id : output_result_ids) {
+      auto it = unregistered_index_.find(result_id);
+      if (it != unregistered_index_.end()) {
+        completed_results_[result_id] = std::move(*it->second);
+        unregistered_results_.erase(it->second);
+        unregistered_index_.erase(it);
+      }
+    }
   }
 
   return task_ids;
@@ -298,12 +686,14 @@ std::vector<std::string> SessionServiceImpl::SubmitRaw(const std::vector<std::st
 SessionServiceImpl::Submit(const std::vector<Common::TaskPayload> &task_requests,
                            std::shared_ptr<IServiceInvocationHandler> handler,
                            const Common::TaskOptions &task_options) {
+  const auto encoding =
+      binary_task_payload_ ? Common::TaskPayload::Encoding::Binary : Common::TaskPayload::Encoding::Hex;
   std::vector<std::string> serialized;
   serialized.reserve(task_requests.size());
   std::vector<std::vector<std::string>> deps;
   deps.reserve(task_requests.size());
   for (const auto &req : task_requests) {
-    serialized.push_back(req.Serialize());
+    serialized.push_back(req.Serialize(encoding));
     deps.push_back(req.data_dependencies);
   }
   return SubmitRaw(serialized, deps, std::move(handler), task_options);
@@ -318,106 +708,100 @@ std::vector<std::string> SessionServiceImpl::Submit(const std::vector<Common::Ta
 std::vector<std::string> SessionServiceImpl::Submit(const std::vector<Common::TaskDefinition> &task_requests,
                                                     std::shared_ptr<IServiceInvocationHandler> handler,
                                                     const Common::TaskOptions &task_options) {
-  const std::size_t message_overhead = 128;
-  const std::size_t data_chunk_max_size =
-      override_message_size_
-          ? static_cast<std::size_t>(override_message_size_)
-          : channel_pool.WithChannel([](auto channel) {
-              return static_cast<std::size_t>(
-                  armonik::api::client::ResultsClient(armonik::api::grpc::v1::results::Results::NewStub(channel))
-                      .get_service_configuration()
-                      .data_chunk_max_size);
-            });
-
-  // Flatten all raw-data inputs across all tasks so they can be batch-created
+  // Flatten all raw-data and file inputs across all tasks so they can be batch-created, identical contents and files
+  // being uploaded once
   struct InputRef {
+    BlobSource source;
+    std::shared_ptr<const std::string> data;
+    ContentDigest digest;
+  };
+  struct InputUse {
     std::size_t task_idx;
     std::string name;
-    std::string result_key;
+    std::size_t input;
   };
   std::vector<InputRef> raw_inputs;
+  std::vector<InputUse> raw_uses;
+  std::unordered_map<const std::string *, std::size_t> inputs_by_address;
+  std::unordered_map<ContentDigest, std::vector<std::size_t>, ContentDigest::Hash> inputs_by_digest;
+  std::unordered_map<std::string, std::size_t> inputs_by_path;
   for (std::size_t i = 0; i < task_requests.size(); ++i) {
     for (const auto &kv : task_requests[i].inputs) {
       const auto &name = kv.first;
       const auto &blob = kv.second;
-      if (blob.IsRawData()) {
-        raw_inputs.push_back({i, name, "input-" + std::to_string(raw_inputs.size())});
+      if (blob.IsFile()) {
+        auto inserted = inputs_by_path.emplace(blob.GetPath(), raw_inputs.size());
+        if (inserted.second) {
+          raw_inputs.push_back({BlobSource::FromFile(blob.GetPath()), nullptr, {}});
+        }
+        raw_uses.push_back({i, name, inserted.first->second});
+        continue;
+      }
+      if (!blob.IsRawData()) {
+        continue;
+      }
+
+      // Copies of a definition share their data, which is then recognized without being hashed
+      auto data = blob.GetSharedData();
+      if (data == nullptr) {
+        data = std::make_shared<const std::string>();
+      }
+      auto by_address = inputs_by_address.find(data.get());
+      if (by_address != inputs_by_address.end()) {
+        raw_uses.push_back({i, name, by_address->second});
+        continue;
+      }
+      auto digest = ContentDigest::Of(*data);
+      auto &same_digest = inputs_by_digest[digest];
+      auto same = std::find_if(same_digest.begin(), same_digest.end(),
+                               [&](std::size_t j) { return *raw_inputs[j].data == *data; });
+      if (same == same_digest.end()) {
+        same_digest.push_back(raw_inputs.size());
+        inputs_by_address.emplace(data.get(), raw_inputs.size());
+        raw_uses.push_back({i, name, raw_inputs.size()});
+        raw_inputs.push_back({BlobSource::FromData(*data), data, digest});
+      } else {
+        inputs_by_address.emplace(data.get(), *same);
+        raw_uses.push_back({i, name, *same});
       }
     }
   }
 
-  // Parallel to raw_inputs: result IDs assigned after creation
+  // Parallel to raw_inputs: result IDs assigned after creation, or found in the session input cache, which does not
+  // hold files as their contents are not hashed
   std::vector<std::string> raw_result_ids(raw_inputs.size());
+  std::vector<bool> cached(raw_inputs.size(), false);
+  if (input_cache_enabled_) {
+    for (std::size_t j = 0; j < raw_inputs.size(); ++j) {
+      if (raw_inputs[j].data == nullptr) {
+        continue;
+      }
+      raw_result_ids[j] = input_cache_.Find(raw_inputs[j].digest, *raw_inputs[j].data);
+      cached[j] = !raw_result_ids[j].empty();
+    }
+  }
 
-  if (!raw_inputs.empty()) {
-    ThreadPool::JoinSet join_set(thread_pool_);
-
-    // Large inputs: create metadata then stream-upload
-    Batcher<std::size_t> large_batcher(submit_batch_size_, [&](std::vector<std::size_t> &&batch) {
-      join_set.Spawn([&, batch = std::move(batch)]() {
-        std::vector<std::string> keys;
-        keys.reserve(batch.size());
-        for (std::size_t j : batch) {
-          keys.push_back(raw_inputs[j].result_key);
-        }
-
-        auto reply = channel_pool.WithChannel([&](auto channel) {
-          return armonik::api::client::ResultsClient(armonik::api::grpc::v1::results::Results::NewStub(channel))
-              .create_results_metadata(session, keys);
-        });
-
-        for (std::size_t k = 0; k < batch.size(); ++k) {
-          std::size_t j = batch[k];
-          raw_result_ids[j] = reply.at(keys[k]); // threadsafe: each j is unique across batches
-
-          join_set.Spawn([&, j]() {
-            const auto &ri = raw_inputs[j];
-            upload_large_result(channel_pool, session, raw_result_ids[j],
-                                task_requests[ri.task_idx].inputs.at(ri.name).GetData(), data_chunk_max_size, logger_);
-          });
-        }
-      });
-    });
-
-    // Small inputs: inline create (metadata + data in one RPC)
-    std::size_t data_batched = 0;
-    Batcher<std::size_t> small_batcher(submit_batch_size_, [&](std::vector<std::size_t> &&batch) {
-      data_batched = 0;
-      join_set.Spawn([&, batch = std::move(batch)]() {
-        std::vector<std::pair<std::string, std::string>> pairs;
-        pairs.reserve(batch.size());
-        for (std::size_t j : batch) {
-          const auto &ri = raw_inputs[j];
-          pairs.push_back({ri.result_key, task_requests[ri.task_idx].inputs.at(ri.name).GetData()});
-        }
-
-        auto reply = channel_pool.WithChannel([&](auto channel) {
-          return armonik::api::client::ResultsClient(armonik::api::grpc::v1::results::Results::NewStub(channel))
-              .create_results(session, pairs);
-        });
-
-        for (std::size_t k = 0; k < batch.size(); ++k) {
-          raw_result_ids[batch[k]] = reply.at(pairs[k].first); // threadsafe: each j is unique
-        }
-      });
-    });
+  std::vector<BlobSource> sources;
+  std::vector<std::size_t> uploaded;
+  for (std::size_t j = 0; j < raw_inputs.size(); ++j) {
+    if (!cached[j]) {
+      sources.push_back(raw_inputs[j].source);
+      uploaded.push_back(j);
+    }
+  }
+  if (!sources.empty()) {
+    auto created = CreateBlobs(sources, "input-");
+    for (std::size_t k = 0; k < uploaded.size(); ++k) {
+      raw_result_ids[uploaded[k]] = std::move(created[k]);
+    }
 
-    for (std::size_t j = 0; j < raw_inputs.size(); ++j) {
-      const auto &data = task_requests[raw_inputs[j].task_idx].inputs.at(raw_inputs[j].name).GetData();
-      if (data.size() + message_overhead >= data_chunk_max_size) {
-        large_batcher.Add(j);
-      } else {
-        if (data_batched + data.size() + message_overhead >= data_chunk_max_size) {
-          small_batcher.ProcessBatch();
+    if (input_cache_enabled_) {
+      for (std::size_t j : uploaded) {
+        if (raw_inputs[j].data != nullptr) {
+          input_cache_.Insert(raw_inputs[j].digest, raw_inputs[j].data, raw_result_ids[j]);
         }
-        data_batched += data.size() + message_overhead;
-        small_batcher.Add(j);
       }
     }
-
-    large_batcher.ProcessBatch();
-    small_batcher.ProcessBatch();
-    join_set.Wait();
   }
 
   // Build ConventionPayloads: existing-blob inputs resolved directly, raw inputs resolved from upload
@@ -427,20 +811,25 @@ std::vector<std::string> SessionServiceImpl::Submit(const std::vector<Common::Ta
     for (const auto &kv : task_requests[i].inputs) {
       const auto &name = kv.first;
       const auto &blob = kv.second;
-      if (!blob.IsRawData()) {
+      if (blob.IsBlobId()) {
         payloads[i].inputs[name] = blob.GetBlobId();
       }
     }
   }
-  for (std::size_t j = 0; j < raw_inputs.size(); ++j) {
-    payloads[raw_inputs[j].task_idx].inputs[raw_inputs[j].name] = raw_result_ids[j];
+  for (const auto &use : raw_uses) {
+    payloads[use.task_idx].inputs[use.name] = raw_result_ids[use.input];
   }
 
-  // Serialize payloads
+  // Serialize payloads in the encoding negotiated by the ConventionVersion option
+  auto encoding = Common::ConventionPayload::Encoding::Json;
+  auto version_it = task_options.options.find(Common::DynamicLibrary::KeyConventionVersion);
+  if (version_it != task_options.options.end()) {
+    encoding = Common::ConventionPayload::EncodingFromVersion(version_it->second);
+  }
   std::vector<std::string> serialized;
   serialized.reserve(payloads.size());
   for (auto &p : payloads) {
-    serialized.push_back(p.Serialize());
+    serialized.push_back(p.Serialize(encoding));
   }
 
   // Build per-task deps: library blob + all input blob IDs so the DynamicWorker can resolve them
@@ -451,13 +840,18 @@ std::vector<std::string> SessionServiceImpl::Submit(const std::vector<Common::Ta
   }
 
   std::vector<std::vector<std::string>> deps(task_requests.size(), library_deps);
-  for (std::size_t j = 0; j < raw_inputs.size(); ++j) {
-    deps[raw_inputs[j].task_idx].push_back(std::move(raw_result_ids[j]));
+  for (const auto &use : raw_uses) {
+    // A task given the same content under several names depends on the uploaded result only once
+    auto &task_deps = deps[use.task_idx];
+    const auto &result_id = raw_result_ids[use.input];
+    if (std::find(task_deps.begin(), task_deps.end(), result_id) == task_deps.end()) {
+      task_deps.push_back(result_id);
+    }
   }
   for (std::size_t i = 0; i < task_requests.size(); ++i) {
     for (const auto &kv : task_requests[i].inputs) {
       const auto &blob = kv.second;
-      if (!blob.IsRawData()) {
+      if (blob.IsBlobId()) {
         deps[i].push_back(blob.GetBlobId());
       }
     }
@@ -466,13 +860,89 @@ std::vector<std::string> SessionServiceImpl::Submit(const std::vector<Common::Ta
   return SubmitRaw(serialized, deps, std::move(handler), task_options);
 }
 
-std::string SessionServiceImpl::UploadLibrary(const std::string &content) {
-  const std::size_t data_chunk_max_size =
-      override_message_size_ ? override_message_size_ : channel_pool.WithChannel([](auto channel) {
-        return armonik::api::client::ResultsClient(armonik::api::grpc::v1::results::Results::NewStub(channel))
-            .get_service_configuration()
-            .data_chunk_max_size;
-      });
+std::vector<TaskFuture> SessionServiceImpl::SubmitWithFutures(const std::vector<Common::TaskDefinition> &task_requests,
+                                                              const Common::TaskOptions &task_options) {
+  auto task_ids = Submit(task_requests, future_handler_, task_options);
+
+  std::vector<TaskFuture> futures;
+  futures.reserve(task_ids.size());
+  for (auto &task_id : task_ids) {
+    futures.push_back({task_id, future_handler_->Future(task_id)});
+  }
+
+  // The results are waited for in the background, so that each future is ready as soon as its result is received
+  {
+    std::lock_guard<std::mutex> _(future_tracker_mutex_);
+    if (!future_tracker_.joinable()) {
+      future_tracker_ = std::thread([this]() { TrackFutures(); });
+    }
+  }
+  future_tasks_changed_.notify_all();
+  return futures;
+}
+
+void SessionServiceImpl::KeepUnregistered(armonik::api::grpc::v1::results::ResultRaw result) {
+  auto it = unregistered_index_.find(result.result_id());
+  if (it != unregistered_index_.end()) {
+    *it->second = std::move(result);
+    return;
+  }
+  unregistered_results_.push_back(std::move(result));
+  unregistered_index_.emplace(unregistered_results_.back().result_id(), std::prev(unregistered_results_.end()));
+  if (unregistered_results_.size() > UnregisteredResultsMaxCount) {
+    unregistered_index_.erase(unregistered_results_.front().result_id());
+    unregistered_results_.pop_front();
+  }
+}
+
+void SessionServiceImpl::TrackFutures() {
+  std::unique_lock<std::mutex> lock(future_tracker_mutex_);
+  int failures = 0;
+  while (!stop_future_tracking_) {
+    if (!future_handler_->HasPending()) {
+      future_tasks_changed_.wait(lock);
+      continue;
+    }
+
+    // A single wait follows the completions of all the futures, including the ones added while it runs, and returns
+    // once none is pending
+    lock.unlock();
+    std::string error;
+    bool retryable = true;
+    try {
+      Wait({}, future_handler_.get(), All, WaitOptions());
+    } catch (const RpcError &e) {
+      error = e.what();
+      retryable = e.IsRetryable();
+    } catch (const std::exception &e) {
+      error = e.what();
+    }
+
+    if (error.empty()) {
+      failures = 0;
+    } else if (!retryable || ++failures >= FutureTrackingMaxFailures) {
+      // The results may never be received: fail the futures rather than letting their owners wait forever
+      logger_.error("Unable to wait for the results of the futures, giving up: " + error);
+      future_handler_->DiscardAll("Unable to wait for the result: " + error);
+      failures = 0;
+    } else {
+      logger_.warning("Unable to wait for the results of the futures: " + error);
+      std::this_thread::sleep_for(std::chrono::milliseconds(WaitOptions().polling_ms));
+    }
+    lock.lock();
+  }
+}
+
+std::unique_ptr<TaskSubmitterImpl>
+SessionServiceImpl::CreateSubmitter(std::shared_ptr<IServiceInvocationHandler> handler,
+                                    const Common::TaskOptions &task_options, std::size_t max_in_flight) {
+  return std::make_unique<TaskSubmitterImpl>(*this, std::move(handler), task_options, submit_batch_size_.Limit(),
+                                             max_in_flight, thread_pool_.MaxThreads(), batch_flush_delay_,
+                                             root_logger_);
+}
+
+std::string SessionServiceImpl::UploadLibrary(const BlobSource &content) {
+  const std::size_t data_chunk_max_size = DataChunkMaxSize();
 
   // Create a single result entry to hold the library blob
   auto reply = channel_pool.WithChannel([&](auto channel) {
@@ -483,18 +953,148 @@ std::string SessionServiceImpl::UploadLibrary(const std::string &content) {
 
   upload_large_result(channel_pool, session, result_id, content, data_chunk_max_size, logger_);
 
-  logger_.info("Uploaded library blob: " + result_id + " (" + std::to_string(content.size()) + " bytes)");
+  logger_.info("Uploaded library blob: " + result_id + " (" + std::to_string(content.Size()) + " bytes)");
   return result_id;
 }
 
+std::vector<std::string> SessionServiceImpl::CreateBlobs(const std::vector<BlobSource> &sources,
+                                                         const std::string &name_prefix) {
+  const std::size_t message_overhead = 128;
+  const std::size_t data_chunk_max_size = DataChunkMaxSize();
+
+  std::vector<std::string> result_ids(sources.size());
+  ThreadPool::JoinSet join_set(thread_pool_);
+
+  // Large blobs: create metadata then stream-upload
+  Batcher<std::size_t> large_batcher(submit_batch_size_, [&](std::vector<std::size_t> &&batch) {
+    armonik::api::grpc::v1::results::CreateResultsMetaDataRequest request;
+    request.set_session_id(session);
+    for (std::size_t j : batch) {
+      request.add_results()->set_name(name_prefix + std::to_string(j));
+    }
+
+    const auto items = batch.size();
+    AsyncUnary<armonik::api::grpc::v1::results::CreateResultsMetaDataResponse>(
+        channel_pool, join_set, std::move(request), start_create_results_metadata,
+        [&, batch = std::move(batch)](auto &&response) {
+          auto reply = result_ids_by_name(response);
+
+          for (std::size_t j : batch) {
+            result_ids[j] = reply.at(name_prefix + std::to_string(j)); // threadsafe: each j is unique across batches
+
+            join_set.Spawn([&, j]() {
+              upload_large_result(channel_pool, session, result_ids[j], sources[j], data_chunk_max_size, logger_);
+            });
+          }
+        },
+        "Unable to create results metadata", submit_batch_size_.Observe(items));
+  });
+
+  // Small blobs: inline create (metadata + data in one RPC), each request holding at most a data chunk
+  Batcher<std::size_t> small_batcher(
+      submit_batch_size_,
+      [&](std::vector<std::size_t> &&batch) {
+        armonik::api::grpc::v1::results::CreateResultsRequest request;
+        request.set_session_id(session);
+        for (std::size_t j : batch) {
+          auto result = request.add_results();
+          result->set_name(name_prefix + std::to_string(j));
+          auto &data = *result->mutable_data();
+          auto content = sources[j].Read(0, sources[j].Size(), data);
+          if (content.data() != data.data()) {
+            data.assign(content.data(), content.size());
+          }
+        }
+
+        const auto items = batch.size();
+        AsyncUnary<armonik::api::grpc::v1::results::CreateResultsResponse>(
+            channel_pool, join_set, std::move(request), start_create_results,
+            [&, batch = std::move(batch)](auto &&response) {
+              auto reply = result_ids_by_name(response);
+              for (std::size_t j : batch) {
+                result_ids[j] = reply.at(name_prefix + std::to_string(j)); // threadsafe: each j is unique
+              }
+            },
+            "Unable to create results", submit_batch_size_.Observe(items));
+      },
+      data_chunk_max_size);
+
+  for (std::size_t j = 0; j < sources.size(); ++j) {
+    if (sources[j].Size() + message_overhead >= data_chunk_max_size) {
+      large_batcher.Add(j);
+    } else {
+      small_batcher.Add(j, sources[j].Size() + message_overhead);
+    }
+  }
+
+  large_batcher.ProcessBatch();
+  small_batcher.ProcessBatch();
+  join_set.Wait();
+  return result_ids;
+}
+
+std::vector<std::string> SessionServiceImpl::UploadBlobs(const std::vector<BlobSource> &sources) {
+  auto blob_ids = CreateBlobs(sources, "blob-");
+  std::lock_guard<std::mutex> _(uploaded_blobs_mutex_);
+  uploaded_blobs_.insert(blob_ids.begin(), blob_ids.end());
+  return blob_ids;
+}
+
+void SessionServiceImpl::CleanupBlobs(std::vector<std::string> blob_ids) {
+  {
+    std::lock_guard<std::mutex> _(uploaded_blobs_mutex_);
+    for (const auto &blob_id : blob_ids) {
+      uploaded_blobs_.erase(blob_id);
+    }
+  }
+
+  const size_t batch_size = 500;
+  auto blobs_iterator = blob_ids.begin();
+  while (blobs_iterator != blob_ids.end()) {
+    channel_pool.WithChannel([&](const std::shared_ptr<::grpc::Channel> &channel) {
+      std::vector<std::string> batched_ids;
+      for (size_t i = 0; i < batch_size && blobs_iterator != blob_ids.end(); ++i) {
+        batched_ids.push_back(std::move(*blobs_iterator));
+        blobs_iterator++;
+      }
+      armonik::api::client::ResultsClient(armonik::api::grpc::v1::results::Results::NewStub(channel))
+          .delete_results_data(session, batched_ids);
+    });
+  }
+}
+
+void SessionServiceImpl::CleanupBlobs() {
+  std::vector<std::string> blob_ids;
+  {
+    std::lock_guard<std::mutex> _(uploaded_blobs_mutex_);
+    blob_ids.assign(uploaded_blobs_.begin(), uploaded_blobs_.end());
+  }
+  CleanupBlobs(std::move(blob_ids));
+}
+
 SessionServiceImpl::SessionServiceImpl(const Common::Properties &properties,
                                        armonik::api::common::logger::Logger &logger, const std::string &session_id)
     : taskOptions(properties.taskOptions), channel_pool(properties, logger),
       thread_pool_(properties.configuration.get_control_plane().getThreadPoolSize(), logger),
+      handler_pool_(properties.configuration.get_control_plane().getHandlerThreadPoolSize(), logger),
+      max_concurrent_downloads_(properties.configuration.get_control_plane().getMaxConcurrentDownloads() > 0
+                                    ? static_cast<std::size_t>(
+                                          properties.configuration.get_control_plane().getMaxConcurrentDownloads())
+                                    : thread_pool_.MaxThreads()),
+      root_logger_(logger),
       logger_(logger.local({{"sdk_version", ArmoniK::Sdk::Common::getVersion()}})),
-      wait_batch_size_(properties.configuration.get_control_plane().getWaitBatchSize()),
-      submit_batch_size_(properties.configuration.get_control_plane().getSubmitBatchSize()),
-      override_message_size_(properties.configuration.get_control_plane().getOverrideMessageSize()) {
+      wait_batch_size_(batch_size_controller(properties.configuration.get_control_plane(),
+                                             properties.configuration.get_control_plane().getWaitBatchSize())),
+      submit_batch_size_(batch_size_controller(properties.configuration.get_control_plane(),
+                                               properties.configuration.get_control_plane().getSubmitBatchSize())),
+      batch_flush_delay_(properties.configuration.get_control_plane().getBatchFlushDelayMs()),
+      override_message_size_(properties.configuration.get_control_plane().getOverrideMessageSize()),
+      binary_task_payload_(properties.configuration.get_control_plane().isBinaryTaskPayload()),
+      input_cache_enabled_(properties.configuration.get_control_plane().isInputCacheEnabled()),
+      input_cache_(static_cast<std::size_t>(properties.configuration.get_control_plane().getInputCacheMaxSize())) {
+  // Start the handshakes of the channels while the session is created
+  channel_pool.Prewarm();
+
   // Creates a new session
   session = session_id.empty() ? channel_pool.WithChannel([&](auto &&channel) {
     return armonik::api::client::SessionsClient(armonik::api::grpc::v1::sessions::Sessions::NewStub(channel))
@@ -502,6 +1102,26 @@ SessionServiceImpl::SessionServiceImpl(const Common::Properties &properties,
                         {properties.taskOptions.partition_id});
   })
                                : session_id;
+
+  // Only the results completed from now on can belong to the tasks submitted through this service. A new session has
+  // no completed result, the cursor of an existing one starts at its latest completion date, as dated by the control
+  // plane so that the cursor never depends on the clock of the client.
+  if (!session_id.empty()) {
+    completion_cursor_ = latest_completion_date(channel_pool, session);
+  }
+}
+
+SessionServiceImpl::~SessionServiceImpl() {
+  {
+    std::lock_guard<std::mutex> _(future_tracker_mutex_);
+    stop_future_tracking_ = true;
+  }
+  future_tasks_changed_.notify_all();
+  if (future_tracker_.joinable()) {
+    future_tracker_.join();
+  }
+  // Nothing waits for the results anymore
+  future_handler_->DiscardAll("The session service has been destroyed");
 }
 
 #pragma GCC diagnostic push
@@ -514,225 +1134,516 @@ std::vector<std::string> SessionServiceImpl::Submit(const std::vector<Common::Ta
 
 void SessionServiceImpl::WaitResults(std::set<std::string> task_ids, WaitBehavior behavior,
                                      const WaitOptions &options) {
+  Wait(std::move(task_ids), nullptr, behavior, options);
+}
+
+void SessionServiceImpl::Wait(std::set<std::string> task_ids, FutureHandler *futures, WaitBehavior behavior,
+                              const WaitOptions &options) {
   auto function_stop = std::chrono::steady_clock::now() + std::chrono::milliseconds(options.timeout);
 
   bool breakOnError = behavior & WaitBehavior::BreakOnError;
   bool stopOnFirst = behavior & WaitBehavior::Any;
 
-  std::map<std::string, armonik::api::grpc::v1::results::ResultRaw> results;
   std::atomic<bool> hasError(false);
 
-  ThreadPool::JoinSet join_set(thread_pool_);
+  // If the task set is empty, wait for all the tasks that have been submitted at the moment of the wait, which are
+  // the ones registered up to the current sequence number
+  const bool wait_all = futures == nullptr && task_ids.empty();
+  const auto max_sequence = wait_all ? task_registry_.LastSequence() : UINT64_MAX;
+
+  // When waiting for the futures, only the tasks registered with their handler are taken, whenever they were submitted
+  const IServiceInvocationHandler *handler = futures;
+
+  // Otherwise, wait for the results of the specified tasks only
+  std::unordered_set<std::string> waited;
+  if (!wait_all && futures == nullptr) {
+    std::string result_id;
+    for (auto &tid : task_ids) {
+      if (!task_registry_.FindResult(tid, result_id)) {
+        logger_.warning("Task ID " + tid + " has no associated result ID, skipping wait.");
+        continue;
+      }
+      waited.insert(result_id);
+    }
+  }
 
-  {
-    std::lock_guard<std::mutex> _(maps_mutex);
+  auto is_waited = [&](const std::string &result_id) {
+    return wait_all || futures != nullptr || waited.count(result_id) != 0;
+  };
+  auto has_pending = [&]() {
+    if (futures != nullptr) {
+      return !stop_future_tracking_ && futures->HasPending();
+    }
+    return wait_all ? task_registry_.HasPending(max_sequence) : !waited.empty();
+  };
+  std::size_t dispatched = 0;
 
-    if (task_ids.empty()) {
-      // If the task set is empty, wait for all the results that have been submitted at the moment of the wait
-      for (auto &handler : result_handlers) {
-        armonik::api::grpc::v1::results::ResultRaw result{};
-        result.set_result_id(handler.first);
-        result.set_status(armonik::api::grpc::v1::result_status::RESULT_STATUS_NOTFOUND);
-        results.emplace(handler.first, std::move(result));
-      }
+  // Results taken from the registry, to be dispatched once the tracker is unlocked
+  std::vector<std::pair<TaskRegistry::Record, armonik::api::grpc::v1::results::ResultRaw>> ready;
+
+  // Take a result which is no longer in CREATED status if it is waited for, otherwise keep it for a later wait.
+  // Called with the tracker mutex held.
+  auto on_status = [&](armonik::api::grpc::v1::results::ResultRaw result) {
+    if (result.status() == armonik::api::grpc::v1::result_status::RESULT_STATUS_CREATED) {
+      return;
+    }
+    TaskRegistry::Record record{};
+    if (is_waited(result.result_id()) &&
+        task_registry_.TakeByResult(result.result_id(), record, max_sequence, handler)) {
+      waited.erase(result.result_id());
+      completed_results_.erase(result.result_id());
+      ready.emplace_back(std::move(record), std::move(result));
+    } else if (task_registry_.HasResult(result.result_id())) {
+      auto result_id = result.result_id();
+      completed_results_[std::move(result_id)] = std::move(result);
     } else {
-      // Otherwise, wait for the results of the specified tasks only
-      for (auto &tid : task_ids) {
-        auto result_id = taskId_resultId.find(tid);
-        if (result_id == taskId_resultId.end()) {
-          logger_.warning("Task ID " + tid + " has no associated result ID, skipping wait.");
-          continue;
-        }
+      // Not registered yet, already handled by a concurrent wait, or cleaned up
+      waited.erase(result.result_id());
+      completed_results_.erase(result.result_id());
+      KeepUnregistered(std::move(result));
+    }
+  };
 
-        armonik::api::grpc::v1::results::ResultRaw result{};
-        result.set_result_id(result_id->second);
-        result.set_status(armonik::api::grpc::v1::result_status::RESULT_STATUS_NOTFOUND);
-        results.emplace(result_id->second, std::move(result));
+  // Batcher to get the status of the waited results in batches when reconciling
+  std::mutex reconciled_mutex;
+  std::vector<armonik::api::grpc::v1::results::ResultRaw> reconciled;
+  ThreadPool::JoinSet reconcile_set(thread_pool_);
+  Batcher<std::string> batcher(wait_batch_size_, [&](std::vector<std::string> &&batch) {
+    armonik::api::grpc::v1::results::ListResultsRequest request{};
+    auto &filters = *request.mutable_filters();
+    for (auto &result_id : batch) {
+
+      auto filter = filters.add_or_()->add_and_();
+      filter->mutable_field()->mutable_result_raw_field()->set_field(
+          armonik::api::grpc::v1::results::RESULT_RAW_ENUM_FIELD_RESULT_ID);
+      filter->mutable_filter_string()->set_value(std::move(result_id));
+      filter->mutable_filter_string()->set_operator_(armonik::api::grpc::v1::FILTER_STRING_OPERATOR_EQUAL);
+    }
+    request.set_page(0);
+    request.set_page_size(filters.or__size());
+    request.mutable_sort()->set_direction(armonik::api::grpc::v1::sort_direction::SORT_DIRECTION_ASC);
+    request.mutable_sort()->mutable_field()->mutable_result_raw_field()->set_field(
+        armonik::api::grpc::v1::results::RESULT_RAW_ENUM_FIELD_CREATED_AT);
+
+    const auto items = batch.size();
+    AsyncUnary<armonik::api::grpc::v1::results::ListResultsResponse>(
+        channel_pool, reconcile_set, std::move(request), start_list_results,
+        [&](auto &&response) {
+          std::lock_guard<std::mutex> _(reconciled_mutex);
+          for (auto &result : *response.mutable_results()) {
+            reconciled.push_back(std::move(result));
+          }
+        },
+        "Unable to list results", wait_batch_size_.Observe(items));
+  });
+
+  // Get the status of all the waited results, including the ones the completion cursor cannot see, such as the
+  // results aborted without completion date or committed after the cursor has passed their completion date. The
+  // requests are sent without the tracker mutex, the returned ids being the ones to apply with apply_reconciled.
+  auto reconcile = [&]() {
+    auto result_ids = wait_all || futures != nullptr ? task_registry_.ResultIds(max_sequence, handler)
+                                                    : std::vector<std::string>(waited.begin(), waited.end());
+    for (auto &result_id : result_ids) {
+      batcher.Add(result_id);
+    }
+    batcher.ProcessBatch();
+    reconcile_set.Wait();
+    return result_ids;
+  };
+
+  // Apply the statuses got by reconcile for the given results. Called with the tracker mutex held.
+  auto apply_reconciled = [&](const std::vector<std::string> &result_ids) {
+    std::unordered_set<std::string> missing(result_ids.begin(), result_ids.end());
+    for (auto &result : reconciled) {
+      missing.erase(result.result_id());
+      on_status(std::move(result));
+    }
+    reconciled.clear();
+
+    // The results which are not listed are reported as not found
+    for (auto &result_id : missing) {
+      armonik::api::grpc::v1::results::ResultRaw result{};
+      result.set_result_id(result_id);
+      result.set_status(armonik::api::grpc::v1::result_status::RESULT_STATUS_NOTFOUND);
+      on_status(std::move(result));
+    }
+  };
+
+  // Take the waited results which were completed during a previous wait. Called with the tracker mutex held.
+  auto take_completed = [&]() {
+    for (auto it = completed_results_.begin(); it != completed_results_.end();) {
+      TaskRegistry::Record record{};
+      if (!is_waited(it->first)) {
+        ++it;
+      } else if (task_registry_.TakeByResult(it->first, record, max_sequence, handler)) {
+        waited.erase(it->first);
+        ready.emplace_back(std::move(record), std::move(it->second));
+        it = completed_results_.erase(it);
+      } else if (!task_registry_.HasResult(it->first)) {
+        waited.erase(it->first);
+        it = completed_results_.erase(it);
+      } else {
+        ++it;
       }
     }
-  }
-  size_t initial_result_size = results.size();
+  };
 
-  // Batcher to get results in batches
-  Batcher<std::string> batcher(wait_batch_size_, [&](std::vector<std::string> &&batch) {
-    join_set.Spawn([&, batch = std::move(batch)]() mutable {
-      armonik::api::grpc::v1::results::Filters filters{};
-      for (auto &result_id : batch) {
+  // The results taken by the poller go through a pipeline: the download stage fetches their data on the thread pool,
+  // at most max_concurrent_downloads_ at a time, and the handler stage calls the handlers on the handler pool. A
+  // download slot is freed as soon as the handler of its result starts, so that slow handlers hold back neither the
+  // polling nor the downloads, while the payloads waiting for a handler stay bounded. The completed results of the
+  // streaming handlers are downloaded by the handler stage, and keep their slot until the end of their download.
+  struct Delivery {
+    TaskRegistry::Record record;
+    armonik::api::grpc::v1::results::ResultRaw result;
+    std::string payload;
+    std::exception_ptr error;
+    std::string reason;
+    bool streamed;
+  };
 
-        auto filter = filters.add_or_()->add_and_();
-        filter->mutable_field()->mutable_result_raw_field()->set_field(
-            armonik::api::grpc::v1::results::RESULT_RAW_ENUM_FIELD_RESULT_ID);
-        filter->mutable_filter_string()->set_value(std::move(result_id));
-        filter->mutable_filter_string()->set_operator_(armonik::api::grpc::v1::FILTER_STRING_OPERATOR_EQUAL);
+  // Report an error to the handler of a result
+  auto handle_error = [&](Delivery &delivery, const std::exception &e, const std::string &reason = {}) {
+    auto &handler = delivery.record.handler;
+    auto &task_id = delivery.record.task_id;
+    hasError.store(true, std::memory_order_relaxed);
+    std::stringstream message;
+    message << "Error while handling result " << delivery.result.result_id() << " for task "
+            << (task_id.empty() ? "[UNKNOWN]" : task_id);
+    if (!reason.empty()) {
+      message << " : " << reason;
+    }
+    message << " : " << e.what();
+    logger_.error(message.str());
+    if (handler) {
+      try {
+        handler->HandleError(e, task_id);
+      } catch (const std::exception &he) {
+        logger_.error(std::string("Handler threw in HandleError: ") + he.what());
+      } catch (...) {
+        logger_.error("Handler threw unknown exception in HandleError");
       }
+    } else {
+      logger_.warning("No handler registered for result " + delivery.result.result_id());
+    }
+  };
 
-      auto response = channel_pool.WithChannel([&](auto &&channel) {
-        armonik::api::client::ResultsClient resultsClient(armonik::api::grpc::v1::results::Results::NewStub(channel));
-        int total = 0;
-        return resultsClient.list_results(std::move(filters), total, 0, filters.or__size());
-      });
+  // Download stage: fetch the payload of a completed result, or the error of any other
+  auto fetch = [&](Delivery &delivery) {
+    auto &result = delivery.result;
+    std::string owner_task_id;
+    switch (result.status()) {
+    // Unreachable, generate an error to avoid missing results
+    case armonik::api::grpc::v1::result_status::RESULT_STATUS_CREATED:
+      delivery.error = std::make_exception_ptr(
+          armonik::api::common::exceptions::ArmoniKApiException("Unreachable: result in CREATED status"));
+      break;
 
-      for (auto &result : response) {
-        // threadsafe as the result is known to be present in the map and we have unique keys
-        results[result.result_id()] = std::move(result);
+    // If the result is completed, we download it
+    case armonik::api::grpc::v1::result_status::RESULT_STATUS_COMPLETED:
+      try {
+        download_result_chunks(channel_pool, session, result.result_id(), [&](absl::string_view chunk) {
+          delivery.payload.append(chunk.data(), chunk.size());
+        });
+      } catch (const std::exception &) {
+        delivery.error = std::current_exception();
+        delivery.reason = "Failed to download result data";
       }
-    });
-  });
+      break;
 
-  // Wait all the specified results
-  while (!results.empty()) {
-    // Get all the results using batched requests
-    for (auto &result : results) {
-      batcher.Add(result.first);
+    // If the result is aborted, we retrieve the task error
+    case armonik::api::grpc::v1::result_status::RESULT_STATUS_ABORTED:
+      // The considered task is either the owner task of the result, or the original task
+      owner_task_id = result.owner_task_id();
+      if (result.owner_task_id().empty()) {
+        owner_task_id = delivery.record.task_id;
+      }
+
+      if (owner_task_id.empty()) {
+        delivery.error =
+            std::make_exception_ptr(armonik::api::common::exceptions::ArmoniKApiException("Result is aborted"));
+      } else {
+        armonik::api::grpc::v1::TaskError error{};
+        error.set_task_id(owner_task_id);
+
+        // Retrieve the task error details
+        try {
+          channel_pool.WithTasks([&](auto &tasks) {
+            grpc::ClientContext context{};
+            armonik::api::grpc::v1::tasks::GetTaskRequest request{};
+            armonik::api::grpc::v1::tasks::GetTaskResponse response{};
+            request.set_task_id(owner_task_id);
+            auto status = tasks.GetTask(&context, request, &response);
+            if (!status.ok()) {
+              throw armonik::api::common::exceptions::ArmoniKApiException("Unable to get task " + owner_task_id +
+                                                                          ": " + status.error_message());
+            }
+            auto &task = *response.mutable_task();
+            auto task_error = error.add_errors();
+            task_error->set_detail(std::move(*task.mutable_output()->mutable_error()));
+            task_error->set_task_status(task.status());
+          });
+        } catch (const std::exception &e) {
+          error.add_errors()->set_detail(e.what());
+        }
+        delivery.error =
+            std::make_exception_ptr(armonik::api::common::exceptions::ArmoniKTaskError("Result is aborted", error));
+      }
+      break;
+
+    // In all other cases, we just call the handler on a generic error
+    case armonik::api::grpc::v1::result_status::RESULT_STATUS_DELETED:
+      delivery.error =
+          std::make_exception_ptr(armonik::api::common::exceptions::ArmoniKApiException("Result is deleted"));
+      break;
+    case armonik::api::grpc::v1::result_status::RESULT_STATUS_NOTFOUND:
+      delivery.error =
+          std::make_exception_ptr(armonik::api::common::exceptions::ArmoniKApiException("Result was not found"));
+      break;
+    default:
+      delivery.error =
+          std::make_exception_ptr(armonik::api::common::exceptions::ArmoniKApiException("Result status is unknown"));
+      break;
+    }
+  };
+
+  // Handler stage: deliver the payload or the error of a fetched result to its handler
+  auto handle = [&](Delivery &delivery) {
+    auto &handler = delivery.record.handler;
+    auto &task_id = delivery.record.task_id;
+    const auto &result_id = delivery.result.result_id();
+    if (delivery.error) {
+      try {
+        std::rethrow_exception(delivery.error);
+      } catch (const std::exception &e) {
+        handle_error(delivery, e, delivery.reason);
+      }
+      return;
     }
-    batcher.ProcessBatch();
-    join_set.Wait();
 
-    for (auto result_it = results.begin(); result_it != results.end();) {
-      auto &result = result_it->second;
-      auto status = result.status();
+    try {
+      if (handler) {
+        handler->HandleResponse(delivery.payload, task_id, result_id);
+      } else {
+        logger_.debug("No handler to deliver result " + result_id);
+      }
+    } catch (const std::exception &e) {
+      handle_error(delivery, e, "Failed to execute result handler");
+    }
+  };
 
-      // reset status to not found for next iteration if not completed or aborted
-      result.set_status(armonik::api::grpc::v1::result_status::RESULT_STATUS_NOTFOUND);
+  // Handler stage for streaming handlers, which receive the chunks as they are downloaded without buffering the whole
+  // result
+  auto stream = [&](Delivery &delivery, IStreamingServiceInvocationHandler &streaming) {
+    auto &task_id = delivery.record.task_id;
+    const auto &result_id = delivery.result.result_id();
+    bool downloaded = false;
+    try {
+      streaming.HandleResponseBegin(task_id, result_id);
+      download_result_chunks(channel_pool, session, result_id, [&](absl::string_view chunk) {
+        streaming.HandleResponseChunk(chunk, task_id, result_id);
+      });
+      downloaded = true;
+      streaming.HandleResponseEnd(task_id, result_id);
+    } catch (const std::exception &e) {
+      handle_error(delivery, e, downloaded ? "Failed to execute result handler" : "Failed to download result data");
+    }
+  };
 
-      // Skip results that are not yet ready
-      if (status == armonik::api::grpc::v1::result_status::RESULT_STATUS_CREATED) {
-        ++result_it;
+  // Results waiting for a download slot, and number of slots taken by the results being downloaded or waiting for a
+  // handler
+  std::mutex downloads_mutex;
+  std::deque<Delivery> download_queue;
+  std::size_t downloads = 0;
+
+  // Start the downloads of the queued results while slots are free. Called with the downloads mutex held.
+  std::function<void()> start_downloads;
+
+  // Hand a result over to the handler stage
+  std::function<void(Delivery &&)> to_handler;
+
+  // The handler stage reports to the same join set as the download stage, so that waiting for it waits for both
+  ThreadPool::JoinSet join_set(thread_pool_);
+
+  start_downloads = [&]() {
+    while (downloads < max_concurrent_downloads_ && !download_queue.empty()) {
+      ++downloads;
+      auto delivery = std::move(download_queue.front());
+      download_queue.pop_front();
+      if (delivery.streamed) {
+        to_handler(std::move(delivery));
         continue;
       }
+      join_set.Spawn([&, delivery = std::move(delivery)]() mutable {
+        fetch(delivery);
+        to_handler(std::move(delivery));
+      });
+    }
+  };
 
-      join_set.Spawn([&, result = std::move(result), status]() mutable {
-        std::shared_ptr<IServiceInvocationHandler> handler{};
-        std::string task_id{};
+  // Free a download slot for the next queued result
+  auto release_slot = [&]() {
+    std::lock_guard<std::mutex> _(downloads_mutex);
+    --downloads;
+    start_downloads();
+  };
 
-        { // Extract the handler and taskid information
-          std::lock_guard<std::mutex> _(maps_mutex);
-          auto handler_it = result_handlers.find(result.result_id());
-          if (handler_it != result_handlers.end()) {
-            handler = std::move(handler_it->second);
-            result_handlers.erase(handler_it);
-          }
-          auto task_id_it = resultId_taskId.find(result.result_id());
-          if (task_id_it != resultId_taskId.end()) {
-            task_id = std::move(task_id_it->second);
-            resultId_taskId.erase(task_id_it);
-            taskId_resultId.erase(task_id);
-          }
+  to_handler = [&](Delivery &&delivery) {
+    handler_pool_.Spawn([&, pending = join_set.Track(), delivery = std::move(delivery)]() mutable {
+      if (!delivery.streamed) {
+        release_slot();
+      }
+      try {
+        if (delivery.streamed) {
+          stream(delivery, dynamic_cast<IStreamingServiceInvocationHandler &>(*delivery.record.handler));
+        } else {
+          handle(delivery);
         }
+      } catch (...) {
+        // The handler pool is not the pool of the join set: report the failure through the pending operation
+        pending.Fail(std::current_exception());
+      }
+      if (delivery.streamed) {
+        release_slot();
+      }
+    });
+  };
 
-        // function to be called upon errors
-        auto handle_error = [&](const std::exception &e, const std::string &reason = {}) {
-          hasError.store(true, std::memory_order_relaxed);
-          std::stringstream message;
-          message << "Error while handling result " << result.result_id() << " for task "
-                  << (task_id.empty() ? "[UNKNOWN]" : task_id);
-          if (!reason.empty()) {
-            message << " : " << reason;
-          }
-          message << " : " << e.what();
-          logger_.error(message.str());
-          if (handler) {
-            try {
-              handler->HandleError(e, task_id);
-            } catch (const std::exception &he) {
-              logger_.error(std::string("Handler threw in HandleError: ") + he.what());
-            } catch (...) {
-              logger_.error("Handler threw unknown exception in HandleError");
-            }
-          } else {
-            logger_.warning("No handler registered for result " + result.result_id());
-          }
-        };
-
-        std::string payload, owner_task_id;
-        switch (status) {
-        // Unreachable, generate an error to avoid missing results
-        case armonik::api::grpc::v1::result_status::RESULT_STATUS_CREATED:
-          handle_error(armonik::api::common::exceptions::ArmoniKApiException("Unreachable: result in CREATED status"));
-          break;
-
-        // If the result is completed, we download it
-        case armonik::api::grpc::v1::result_status::RESULT_STATUS_COMPLETED:
-          // Download the payload
-          try {
-            payload = channel_pool.WithChannel([&](auto &&channel) {
-              return armonik::api::client::ResultsClient(armonik::api::grpc::v1::results::Results::NewStub(channel))
-                  .download_result_data(session, result.result_id());
-            });
-          } catch (const std::exception &e) {
-            handle_error(e, "Failed to download result data");
-          }
+  // Send a result which is no longer in CREATED status down the pipeline
+  auto dispatch = [&](TaskRegistry::Record record, armonik::api::grpc::v1::results::ResultRaw result) {
+    Delivery delivery{std::move(record), std::move(result), {}, nullptr, {}, false};
+    delivery.streamed = delivery.result.status() == armonik::api::grpc::v1::result_status::RESULT_STATUS_COMPLETED &&
+                        std::dynamic_pointer_cast<IStreamingServiceInvocationHandler>(delivery.record.handler);
+    std::lock_guard<std::mutex> _(downloads_mutex);
+    download_queue.push_back(std::move(delivery));
+    start_downloads();
+  };
 
-          // Call the response handler with the payload
-          try {
-            if (handler) {
-              handler->HandleResponse(payload, task_id, result.result_id());
-            } else {
-              logger_.debug("No handler to deliver result " + result.result_id());
-            }
-          } catch (const std::exception &e) {
-            handle_error(e, "Failed to execute result handler");
+  // Update the tracker with f, called with the tracker mutex held, then dispatch the results taken from the registry
+  auto track = [&](auto &&f) {
+    std::exception_ptr error;
+    {
+      std::lock_guard<std::mutex> _(tracker_mutex_);
+      try {
+        f();
+      } catch (...) {
+        error = std::current_exception();
+      }
+    }
+    dispatched += ready.size();
+    for (auto &r : ready) {
+      dispatch(std::move(r.first), std::move(r.second));
+    }
+    ready.clear();
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  };
+
+  // Subscribe to result status updates before the first poll so that no completion is missed
+  std::unique_ptr<ResultEventsSubscription> subscription;
+  if (options.use_events) {
+    try {
+      subscription = std::make_unique<ResultEventsSubscription>(channel_pool, session, logger_);
+    } catch (const std::exception &e) {
+      logger_.warning(std::string("Unable to subscribe to result events, falling back to polling: ") + e.what());
+    }
+  }
+  auto next_resync = std::chrono::steady_clock::now() + std::chrono::milliseconds(options.events_resync_ms);
+  bool poll = true;
+  std::vector<ResultEventsSubscription::Update> updates;
+
+  // Wait all the specified results
+  while (has_pending()) {
+    if (poll) {
+      // Only list the results completed since the last poll, and reconcile the waited ones from time to time. The
+      // tracker is only locked to read and update its state, not during the requests.
+      std::chrono::nanoseconds since{};
+      std::unordered_set<std::string> boundary;
+      bool reconciling = false;
+      track([&]() {
+        take_completed();
+        since = completion_cursor_;
+        boundary = completion_cursor_results_;
+        auto now = std::chrono::steady_clock::now();
+        if (now >= next_reconcile_) {
+          next_reconcile_ = now + std::chrono::milliseconds(options.reconcile_ms);
+          reconciling = true;
+        }
+      });
+
+      // The results completed at the date of the cursor are listed again, only the new ones are kept
+      std::vector<armonik::api::grpc::v1::results::ResultRaw> listed;
+      const auto page_size = static_cast<int>(wait_batch_size_.Limit());
+      list_completed_results(channel_pool, session, since, page_size, [&](auto &&result) {
+        if (completion_date(result) != since || boundary.count(result.result_id()) == 0) {
+          listed.push_back(std::move(result));
+        }
+      });
+      std::vector<std::string> reconciled_ids;
+      if (reconciling) {
+        reconciled_ids = reconcile();
+      }
+
+      track([&]() {
+        for (auto &result : listed) {
+          const auto date = completion_date(result);
+          if (date > completion_cursor_) {
+            completion_cursor_ = date;
+            completion_cursor_results_.clear();
           }
-          break;
-
-        // If the result is aborted, we retrieve the task error
-        case armonik::api::grpc::v1::result_status::RESULT_STATUS_ABORTED:
-          // The considered task is either the owner task of the result, or the original task
-          owner_task_id = result.owner_task_id();
-          if (result.owner_task_id().empty()) {
-            owner_task_id = task_id;
+          if (date == completion_cursor_) {
+            completion_cursor_results_.insert(result.result_id());
           }
-
-          if (owner_task_id.empty()) {
-            handle_error(armonik::api::common::exceptions::ArmoniKApiException("Result is aborted"));
-          } else {
-            armonik::api::grpc::v1::TaskError error{};
-            error.set_task_id(owner_task_id);
-
-            // Retrieve the task error details
-            try {
-              channel_pool.WithChannel([&](auto &&channel) {
-                auto task = armonik::api::client::TasksClient(armonik::api::grpc::v1::tasks::Tasks::NewStub(channel))
-                                .get_task(owner_task_id);
-                auto task_error = error.add_errors();
-                task_error->set_detail(std::move(*task.mutable_output()->mutable_error()));
-                task_error->set_task_status(task.status());
-              });
-            } catch (const std::exception &e) {
-              error.add_errors()->set_detail(e.what());
-            }
-            handle_error(armonik::api::common::exceptions::ArmoniKTaskError("Result is aborted", error));
+          on_status(std::move(result));
+        }
+        if (reconciling) {
+          apply_reconciled(reconciled_ids);
+        }
+      });
+    } else {
+      // Only process the results notified by the events stream
+      track([&]() {
+        take_completed();
+        for (auto &update : updates) {
+          if (update.second != armonik::api::grpc::v1::result_status::RESULT_STATUS_COMPLETED &&
+              update.second != armonik::api::grpc::v1::result_status::RESULT_STATUS_ABORTED) {
+            continue;
           }
-          break;
-
-        // In all other cases, we just call the handler on a generic error
-        case armonik::api::grpc::v1::result_status::RESULT_STATUS_DELETED:
-          handle_error(armonik::api::common::exceptions::ArmoniKApiException("Result is deleted"));
-          break;
-        case armonik::api::grpc::v1::result_status::RESULT_STATUS_NOTFOUND:
-          handle_error(armonik::api::common::exceptions::ArmoniKApiException("Result was not found"));
-          break;
-        default:
-          handle_error(armonik::api::common::exceptions::ArmoniKApiException("Result status is unknown"));
-          break;
+          armonik::api::grpc::v1::results::ResultRaw result{};
+          result.set_result_id(std::move(update.first));
+          result.set_status(update.second);
+          on_status(std::move(result));
         }
       });
-
-      result_it = results.erase(result_it);
+      updates.clear();
     }
 
-    join_set.Wait();
-
     // If we wait for any and at least one is done, or if we break on error and had an error, then return
-    if ((stopOnFirst && results.size() < initial_result_size) ||
-        (breakOnError && hasError.load(std::memory_order_relaxed))) {
+    if ((stopOnFirst && dispatched > 0) || (breakOnError && hasError.load(std::memory_order_relaxed))) {
       break;
     }
-    if (std::chrono::steady_clock::now() > function_stop) {
+    auto now = std::chrono::steady_clock::now();
+    if (now > function_stop || !has_pending()) {
       break;
     }
-    std::this_thread::sleep_for(std::chrono::milliseconds(options.polling_ms));
+    if (subscription && subscription->Healthy()) {
+      // Wait for notifications, and resynchronize periodically in case some were missed. Also resynchronize once the
+      // stream is established, as the results completed between the first poll and the subscription are not notified.
+      updates = subscription->WaitUpdates(std::min(function_stop, next_resync));
+      now = std::chrono::steady_clock::now();
+      poll = subscription->TakeEstablished() || now >= next_resync || !subscription->Healthy();
+      if (poll) {
+        next_resync = now + std::chrono::milliseconds(options.events_resync_ms);
+      }
+    } else {
+      std::this_thread::sleep_for(std::chrono::milliseconds(options.polling_ms));
+      poll = true;
+    }
   }
+
+  // Let the pipeline deliver all the results taken by the poller
+  join_set.Wait();
 }
 
 void SessionServiceImpl::CloseSession() {
@@ -757,12 +1668,19 @@ void SessionServiceImpl::PurgeSession() {
 }
 
 void SessionServiceImpl::DropSession() {
-  // Clear all the maps
+  // Forget all the tasks
+  task_registry_.Clear();
+  future_handler_->DiscardAll("The session has been dropped");
+  {
+    std::lock_guard<std::mutex> _(tracker_mutex_);
+    completed_results_.clear();
+    unregistered_results_.clear();
+    unregistered_index_.clear();
+  }
+  input_cache_.Clear();
   {
-    std::lock_guard<std::mutex> _(maps_mutex);
-    taskId_resultId.clear();
-    resultId_taskId.clear();
-    result_handlers.clear();
+    std::lock_guard<std::mutex> _(uploaded_blobs_mutex_);
+    uploaded_blobs_.clear();
   }
   // Cancel the session
   auto reply = channel_pool.WithChannel([&](const std::shared_ptr<::grpc::Channel> &channel) {
@@ -802,16 +1720,16 @@ void SessionServiceImpl::DropSession() {
 }
 
 void SessionServiceImpl::CleanupTasks(std::vector<std::string> task_ids) {
-  // Remove the given tasks from the maps
+  // Remove the given tasks from the registry
   {
-    std::lock_guard<std::mutex> _(maps_mutex);
+    std::lock_guard<std::mutex> _(tracker_mutex_);
+    std::string result_id;
     for (auto &&t : task_ids) {
-      auto loc = taskId_resultId.find(t);
-      if (loc != taskId_resultId.end()) {
-        resultId_taskId.erase(loc->second);
-        result_handlers.erase(loc->second);
-        taskId_resultId.erase(loc->first);
+      if (task_registry_.FindResult(t, result_id)) {
+        completed_results_.erase(result_id);
       }
+      task_registry_.RemoveByTask(t);
+      future_handler_->Discard(t, "The task has been cleaned up");
     }
   }
   const size_t batch_size = 500;
@@ -0,0 +1,338 @@
+#include "TaskRegistry.h"
+#include "armonik/sdk/client/IServiceInvocationHandler.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace ArmoniK {
+namespace Sdk {
+namespace Client {
+namespace Internal {
+
+namespace {
+std::uint64_t Hash(const std::string &key) { return std::hash<std::string>{}(key); }
+
+/**
+ * @brief Shard of a key: the high bits of the hash, the low ones are used by the index
+ */
+std::size_t ShardOf(std::uint64_t hash, std::size_t shard_count) {
+  return static_cast<std::size_t>(hash >> 32) % shard_count;
+}
+} // namespace
+
+constexpr std::uint32_t TaskRegistry::Index::Empty;
+constexpr std::uint32_t TaskRegistry::Index::Tombstone;
+constexpr std::size_t TaskRegistry::ShardCount;
+
+template <class Match> TaskRegistry::IndexEntry *TaskRegistry::Index::Find(std::uint64_t hash, Match &&match) {
+  if (entries_.empty()) {
+    return nullptr;
+  }
+  // The load factor is kept below 1, so there is always an empty entry to stop the probing
+  const auto mask = entries_.size() - 1;
+  for (auto i = static_cast<std::size_t>(hash) & mask;; i = (i + 1) & mask) {
+    auto &entry = entries_[i];
+    if (entry.slot == Empty) {
+      return nullptr;
+    }
+    if (entry.slot != Tombstone && entry.hash == hash && match(entry)) {
+      return &entry;
+    }
+  }
+}
+
+void TaskRegistry::Index::Insert(IndexEntry entry) {
+  Reserve();
+  const auto mask = entries_.size() - 1;
+  for (auto i = static_cast<std::size_t>(entry.hash) & mask;; i = (i + 1) & mask) {
+    auto &target = entries_[i];
+    if (target.slot == Empty || target.slot == Tombstone) {
+      if (target.slot == Tombstone) {
+        --tombstones_;
+      }
+      target = entry;
+      ++size_;
+      return;
+    }
+  }
+}
+
+void TaskRegistry::Index::Erase(IndexEntry *entry) {
+  entry->slot = Tombstone;
+  --size_;
+  ++tombstones_;
+}
+
+void TaskRegistry::Index::Clear() {
+  entries_.clear();
+  entries_.shrink_to_fit();
+  size_ = 0;
+  tombstones_ = 0;
+}
+
+void TaskRegistry::Index::Reserve() {
+  // Keep at most 3/4 of the entries used, tombstones included
+  if ((size_ + tombstones_ + 1) * 4 <= entries_.size() * 3) {
+    return;
+  }
+  auto capacity = std::max<std::size_t>(entries_.size(), 16);
+  while ((size_ + 1) * 2 > capacity) {
+    capacity *= 2;
+  }
+
+  std::vector<IndexEntry> entries(capacity, IndexEntry{0, 0, Empty});
+  const auto mask = capacity - 1;
+  for (const auto &entry : entries_) {
+    if (entry.slot == Empty || entry.slot == Tombstone) {
+      continue;
+    }
+    auto i = static_cast<std::size_t>(entry.hash) & mask;
+    while (entries[i].slot != Empty) {
+      i = (i + 1) & mask;
+    }
+    entries[i] = entry;
+  }
+  entries_.swap(entries);
+  tombstones_ = 0;
+}
+
+TaskRegistry::TaskRegistry() = default;
+
+TaskRegistry::~TaskRegistry() = default;
+
+std::uint64_t TaskRegistry::Add(const std::vector<std::string> &task_ids, const std::vector<std::string> &result_ids,
+                                const std::shared_ptr<IServiceInvocationHandler> &handler) {
+  if (task_ids.empty()) {
+    std::lock_guard<std::mutex> _(batches_mutex_);
+    return last_sequence_;
+  }
+  auto batch = NewBatch(handler, task_ids.size());
+
+  for (std::size_t i = 0; i < task_ids.size(); ++i) {
+    const auto &task_id = task_ids[i];
+    const auto &result_id = result_ids[i];
+    const auto result_hash = Hash(result_id);
+    const auto shard_index = static_cast<std::uint32_t>(ShardOf(result_hash, ShardCount));
+    auto &shard = record_shards_[shard_index];
+
+    std::string replaced_task_id;
+    std::shared_ptr<IServiceInvocationHandler> replaced_handler;
+    std::uint32_t slot;
+    {
+      std::lock_guard<std::mutex> _(shard.mutex);
+      auto existing = shard.by_result.Find(
+          result_hash, [&](const IndexEntry &e) { return shard.slots[e.slot].result_id == result_id; });
+      if (existing != nullptr) {
+        slot = existing->slot;
+        replaced_task_id = std::move(shard.slots[slot].task_id);
+        replaced_handler = Release(shard.slots[slot].batch);
+      } else if (!shard.free_slots.empty()) {
+        slot = shard.free_slots.back();
+        shard.free_slots.pop_back();
+        shard.by_result.Insert({result_hash, shard_index, slot});
+      } else {
+        slot = static_cast<std::uint32_t>(shard.slots.size());
+        shard.slots.emplace_back();
+        shard.by_result.Insert({result_hash, shard_index, slot});
+      }
+      auto &record = shard.slots[slot];
+      record.task_id = task_id;
+      record.result_id = result_id;
+      record.batch = batch;
+    }
+
+    if (!replaced_task_id.empty()) {
+      EraseTaskEntry(replaced_task_id, shard_index, slot);
+    }
+
+    const auto task_hash = Hash(task_id);
+    auto &task_shard = task_shards_[ShardOf(task_hash, ShardCount)];
+    std::lock_guard<std::mutex> _(task_shard.mutex);
+    task_shard.by_task.Insert({task_hash, shard_index, slot});
+  }
+  return batch->sequence;
+}
+
+bool TaskRegistry::TakeByResult(const std::string &result_id, Record &record, std::uint64_t max_sequence,
+                                const IServiceInvocationHandler *handler) {
+  const auto result_hash = Hash(result_id);
+  const auto shard_index = static_cast<std::uint32_t>(ShardOf(result_hash, ShardCount));
+  auto &shard = record_shards_[shard_index];
+  std::uint32_t slot;
+  {
+    std::lock_guard<std::mutex> _(shard.mutex);
+    auto entry = shard.by_result.Find(
+        result_hash, [&](const IndexEntry &e) { return shard.slots[e.slot].result_id == result_id; });
+    if (entry == nullptr || shard.slots[entry->slot].batch->sequence > max_sequence ||
+        (handler != nullptr && shard.slots[entry->slot].batch->handler.get() != handler)) {
+      return false;
+    }
+    slot = entry->slot;
+    shard.by_result.Erase(entry);
+    record.sequence = shard.slots[slot].batch->sequence;
+    record.task_id = std::move(shard.slots[slot].task_id);
+    record.result_id = std::move(shard.slots[slot].result_id);
+    record.handler = FreeSlot(shard, slot);
+  }
+
+  // Until erased, the task entry points to a freed or reused slot, which lookups by task id reject
+  EraseTaskEntry(record.task_id, shard_index, slot);
+  return true;
+}
+
+bool TaskRegistry::HasResult(const std::string &result_id) {
+  const auto result_hash = Hash(result_id);
+  auto &shard = record_shards_[ShardOf(result_hash, ShardCount)];
+  std::lock_guard<std::mutex> _(shard.mutex);
+  return shard.by_result.Find(result_hash, [&](const IndexEntry &e) {
+    return shard.slots[e.slot].result_id == result_id;
+  }) != nullptr;
+}
+
+bool TaskRegistry::RemoveByTask(const std::string &task_id) {
+  const auto task_hash = Hash(task_id);
+  auto &task_shard = task_shards_[ShardOf(task_hash, ShardCount)];
+  std::shared_ptr<IServiceInvocationHandler> handler;
+
+  std::lock_guard<std::mutex> _(task_shard.mutex);
+  auto entry = task_shard.by_task.Find(task_hash, [&](const IndexEntry &e) {
+    auto &shard = record_shards_[e.shard];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto &record = shard.slots[e.slot];
+    if (record.batch == nullptr || record.task_id != task_id) {
+      return false;
+    }
+
+    // Remove the record while its shard is locked
+    const auto result_hash = Hash(record.result_id);
+    auto result_entry = shard.by_result.Find(result_hash, [&](const IndexEntry &r) { return r.slot == e.slot; });
+    shard.by_result.Erase(result_entry);
+    record.task_id.clear();
+    record.result_id.clear();
+    handler = FreeSlot(shard, e.slot);
+    return true;
+  });
+  if (entry == nullptr) {
+    return false;
+  }
+  task_shard.by_task.Erase(entry);
+  return true;
+}
+
+bool TaskRegistry::FindResult(const std::string &task_id, std::string &result_id) {
+  const auto task_hash = Hash(task_id);
+  auto &task_shard = task_shards_[ShardOf(task_hash, ShardCount)];
+
+  std::lock_guard<std::mutex> _(task_shard.mutex);
+  return task_shard.by_task.Find(task_hash, [&](const IndexEntry &e) {
+    auto &shard = record_shards_[e.shard];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto &record = shard.slots[e.slot];
+    if (record.batch == nullptr || record.task_id != task_id) {
+      return false;
+    }
+    result_id = record.result_id;
+    return true;
+  }) != nullptr;
+}
+
+std::vector<std::string> TaskRegistry::ResultIds(std::uint64_t max_sequence, const IServiceInvocationHandler *handler) {
+  std::vector<std::string> result_ids;
+  for (auto &shard : record_shards_) {
+    std::lock_guard<std::mutex> _(shard.mutex);
+    for (const auto &record : shard.slots) {
+      if (record.batch != nullptr && record.batch->sequence <= max_sequence &&
+          (handler == nullptr || record.batch->handler.get() == handler)) {
+        result_ids.push_back(record.result_id);
+      }
+    }
+  }
+  return result_ids;
+}
+
+std::uint64_t TaskRegistry::LastSequence() {
+  std::lock_guard<std::mutex> _(batches_mutex_);
+  return last_sequence_;
+}
+
+bool TaskRegistry::HasPending(std::uint64_t max_sequence) {
+  std::lock_guard<std::mutex> _(batches_mutex_);
+  return !batches_.empty() && batches_.begin()->first <= max_sequence;
+}
+
+void TaskRegistry::Clear() {
+  std::vector<std::shared_ptr<IServiceInvocationHandler>> handlers;
+  for (auto &shard : record_shards_) {
+    std::lock_guard<std::mutex> _(shard.mutex);
+    for (std::uint32_t slot = 0; slot < shard.slots.size(); ++slot) {
+      if (shard.slots[slot].batch != nullptr) {
+        handlers.push_back(Release(shard.slots[slot].batch));
+      }
+    }
+    shard.slots.clear();
+    shard.slots.shrink_to_fit();
+    shard.free_slots.clear();
+    shard.free_slots.shrink_to_fit();
+    shard.by_result.Clear();
+  }
+  for (auto &task_shard : task_shards_) {
+    std::lock_guard<std::mutex> _(task_shard.mutex);
+    task_shard.by_task.Clear();
+  }
+}
+
+std::size_t TaskRegistry::Size() {
+  std::size_t size = 0;
+  for (auto &shard : record_shards_) {
+    std::lock_guard<std::mutex> _(shard.mutex);
+    size += shard.slots.size() - shard.free_slots.size();
+  }
+  return size;
+}
+
+TaskRegistry::Batch *TaskRegistry::NewBatch(const std::shared_ptr<IServiceInvocationHandler> &handler,
+                                            std::size_t count) {
+  auto batch = std::make_unique<Batch>();
+  batch->handler = handler;
+  batch->count.store(count);
+
+  std::lock_guard<std::mutex> _(batches_mutex_);
+  batch->sequence = ++last_sequence_;
+  auto ptr = batch.get();
+  batches_.emplace(batch->sequence, std::move(batch));
+  return ptr;
+}
+
+std::shared_ptr<IServiceInvocationHandler> TaskRegistry::Release(Batch *batch) {
+  // The batch is alive as long as this record counts in it, and only its last record destroys it
+  auto handler = batch->handler;
+  if (batch->count.fetch_sub(1) == 1) {
+    std::lock_guard<std::mutex> _(batches_mutex_);
+    batches_.erase(batch->sequence);
+  }
+  return handler;
+}
+
+std::shared_ptr<IServiceInvocationHandler> TaskRegistry::FreeSlot(RecordShard &shard, std::uint32_t slot) {
+  auto handler = Release(shard.slots[slot].batch);
+  shard.slots[slot].batch = nullptr;
+  shard.free_slots.push_back(slot);
+  return handler;
+}
+
+void TaskRegistry::EraseTaskEntry(const std::string &task_id, std::uint32_t shard, std::uint32_t slot) {
+  const auto task_hash = Hash(task_id);
+  auto &task_shard = task_shards_[ShardOf(task_hash, ShardCount)];
+  std::lock_guard<std::mutex> _(task_shard.mutex);
+  auto entry =
+      task_shard.by_task.Find(task_hash, [&](const IndexEntry &e) { return e.shard == shard && e.slot == slot; });
+  if (entry != nullptr) {
+    task_shard.by_task.Erase(entry);
+  }
+}
+
+} // namespace Internal
+} // namespace Client
+} // namespace Sdk
+} // namespace ArmoniK
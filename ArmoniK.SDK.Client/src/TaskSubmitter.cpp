@@ -0,0 +1,182 @@
+#include "armonik/sdk/client/TaskSubmitter.h"
+#include "SessionServiceImpl.h"
+#include "TaskSubmitterImpl.h"
+#include <algorithm>
+#include <armonik/sdk/common/Version.h>
+#include <utility>
+
+namespace ArmoniK {
+namespace Sdk {
+namespace Client {
+namespace Internal {
+
+TaskSubmitterImpl::TaskSubmitterImpl(SessionServiceImpl &service, std::shared_ptr<IServiceInvocationHandler> handler,
+                                     Common::TaskOptions task_options, std::size_t batch_size,
+                                     std::size_t max_in_flight, std::size_t max_dispatchers,
+                                     std::chrono::milliseconds flush_delay,
+                                     armonik::api::common::logger::Logger &logger)
+    : service_(service), handler_(std::move(handler)), task_options_(std::move(task_options)),
+      batch_size_(std::max<std::size_t>(batch_size, 1)),
+      max_in_flight_(std::max(max_in_flight == 0 ? 4 * batch_size_ : max_in_flight, batch_size_)),
+      flush_delay_(flush_delay), logger_(logger.local({{"sdk_version", ArmoniK::Sdk::Common::getVersion()}})) {
+  // One dispatcher per batch that can be in flight, the batches beyond the limit waiting in the queue
+  auto nb_dispatchers = std::max<std::size_t>(std::min(max_in_flight_ / batch_size_, max_dispatchers), 1);
+  dispatchers_.reserve(nb_dispatchers);
+  for (std::size_t i = 0; i < nb_dispatchers; ++i) {
+    dispatchers_.emplace_back([this]() { Dispatch(); });
+  }
+  logger_.debug("TaskSubmitter created", {{"batch_size", std::to_string(batch_size_)},
+                                          {"max_in_flight", std::to_string(max_in_flight_)},
+                                          {"dispatchers", std::to_string(nb_dispatchers)},
+                                          {"flush_delay_ms", std::to_string(flush_delay_.count())}});
+}
+
+TaskSubmitterImpl::~TaskSubmitterImpl() {
+  try {
+    Close();
+  } catch (const std::exception &e) {
+    logger_.error(std::string("Error while closing TaskSubmitter: ") + e.what());
+  }
+}
+
+std::future<std::string> TaskSubmitterImpl::Push(Common::TaskDefinition task) {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  // Backpressure: wait for the in-flight batches to be submitted
+  while (in_flight_ >= max_in_flight_ && !closed_) {
+    if (!current_.tasks.empty()) {
+      QueueCurrent();
+    }
+    space_condition_.wait(lock);
+  }
+  if (closed_) {
+    throw std::runtime_error("Push on closed TaskSubmitter");
+  }
+
+  if (current_.tasks.empty() && flush_delay_.count() > 0) {
+    // Let a dispatcher queue the batch once due
+    current_deadline_ = std::chrono::steady_clock::now() + flush_delay_;
+    work_condition_.notify_one();
+  }
+  current_.tasks.push_back(std::move(task));
+  current_.promises.emplace_back();
+  auto future = current_.promises.back().get_future();
+  ++in_flight_;
+
+  if (current_.tasks.size() >= batch_size_) {
+    QueueCurrent();
+  }
+  return future;
+}
+
+void TaskSubmitterImpl::Flush() {
+  std::lock_guard<std::mutex> _(mutex_);
+  if (!current_.tasks.empty()) {
+    QueueCurrent();
+  }
+}
+
+void TaskSubmitterImpl::Close() {
+  {
+    std::lock_guard<std::mutex> _(mutex_);
+    if (!current_.tasks.empty()) {
+      QueueCurrent();
+    }
+    closed_ = true;
+    work_condition_.notify_all();
+    space_condition_.notify_all();
+  }
+
+  for (auto &dispatcher : dispatchers_) {
+    if (dispatcher.joinable()) {
+      dispatcher.join();
+    }
+  }
+}
+
+void TaskSubmitterImpl::QueueCurrent() {
+  ready_.push_back(std::move(current_));
+  current_ = Batch();
+  current_.tasks.reserve(batch_size_);
+  current_.promises.reserve(batch_size_);
+  work_condition_.notify_one();
+}
+
+void TaskSubmitterImpl::Dispatch() {
+  while (true) {
+    Batch batch;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (!closed_ && ready_.empty()) {
+        if (flush_delay_.count() == 0 || current_.tasks.empty()) {
+          work_condition_.wait(lock);
+        } else if (std::chrono::steady_clock::now() >= current_deadline_) {
+          QueueCurrent();
+        } else {
+          work_condition_.wait_until(lock, current_deadline_);
+        }
+      }
+      if (ready_.empty()) {
+        // Closed and nothing left to submit
+        break;
+      }
+      batch = std::move(ready_.front());
+      ready_.pop_front();
+    }
+
+    try {
+      auto task_ids = service_.Submit(batch.tasks, handler_, task_options_);
+      for (std::size_t i = 0; i < task_ids.size(); ++i) {
+        batch.promises[i].set_value(std::move(task_ids[i]));
+      }
+    } catch (const std::exception &e) {
+      logger_.error(std::string("Failed to submit batch of ") + std::to_string(batch.tasks.size()) +
+                    " tasks: " + e.what());
+      for (auto &promise : batch.promises) {
+        promise.set_exception(std::current_exception());
+      }
+    } catch (...) {
+      logger_.error(std::string("Failed to submit batch of ") + std::to_string(batch.tasks.size()) +
+                    " tasks: unknown exception");
+      for (auto &promise : batch.promises) {
+        promise.set_exception(std::current_exception());
+      }
+    }
+
+    std::lock_guard<std::mutex> _(mutex_);
+    in_flight_ -= batch.tasks.size();
+    space_condition_.notify_all();
+  }
+}
+
+} // namespace Internal
+
+TaskSubmitter::TaskSubmitter(std::unique_ptr<Internal::TaskSubmitterImpl> impl) : impl(std::move(impl)) {}
+TaskSubmitter::TaskSubmitter(TaskSubmitter &&) noexcept = default;
+TaskSubmitter &TaskSubmitter::operator=(TaskSubmitter &&) noexcept = default;
+TaskSubmitter::~TaskSubmitter() = default;
+
+void TaskSubmitter::ensure_valid() const {
+  if (!impl) {
+    throw std::runtime_error("Use after move");
+  }
+}
+
+std::future<std::string> TaskSubmitter::Push(Common::TaskDefinition task) {
+  ensure_valid();
+  return impl->Push(std::move(task));
+}
+
+void TaskSubmitter::Flush() {
+  ensure_valid();
+  impl->Flush();
+}
+
+void TaskSubmitter::Close() {
+  ensure_valid();
+  impl->Close();
+}
+
+} // namespace Client
+} // namespace Sdk
+} // namespace ArmoniK
@@ -1,5 +1,6 @@
 #include "ThreadPool.h"
 
+#include <algorithm>
 #include <sstream>
 #include <string>
 
@@ -14,8 +15,7 @@ ThreadPool::Task::Task(Function<void()> &&func, ThreadPool::JoinSet *join_set)
     : func_(std::move(func)), join_set_(join_set) {
   if (join_set_) {
     // Increment the task count in the join set
-    std::lock_guard<std::mutex> lock(join_set_->mutex_);
-    join_set_->task_count_ += 1;
+    join_set_->task_count_.fetch_add(1, std::memory_order_relaxed);
   }
 }
 
@@ -24,6 +24,9 @@ ThreadPool::Task::Task(ThreadPool::Task &&other) noexcept : func_(std::move(othe
 }
 ThreadPool::Task &ThreadPool::Task::operator=(ThreadPool::Task &&other) noexcept {
   if (this != &other) {
+    if (join_set_) {
+      join_set_->TaskDone();
+    }
     func_ = std::move(other.func_);
     join_set_ = other.join_set_;
     other.join_set_ = nullptr;
@@ -33,12 +36,7 @@ ThreadPool::Task &ThreadPool::Task::operator=(ThreadPool::Task &&other) noexcept
 
 ThreadPool::Task::~Task() {
   if (join_set_) {
-    // Decrement the task count in the join set
-    std::lock_guard<std::mutex> lock(join_set_->mutex_);
-    join_set_->task_count_ -= 1;
-    if (join_set_->task_count_ == 0) {
-      join_set_->wake_condition_.notify_all();
-    }
+    join_set_->TaskDone();
   }
 }
 
@@ -47,14 +45,21 @@ void ThreadPool::Task::Execute(armonik::api::common::logger::ILogger &logger) {
   try {
     func_();
   } catch (const std::exception &e) {
-    logger.error("Exception in thread pool task: " + std::string(e.what()));
+    logger.error("Exception in thread pool task: " + std::string(e.what()), JoinSetContext());
     RecordError();
   } catch (...) {
-    logger.error("Unknown exception in thread pool task");
+    logger.error("Unknown exception in thread pool task", JoinSetContext());
     RecordError();
   }
 }
 
+armonik::api::common::logger::Context ThreadPool::Task::JoinSetContext() const {
+  if (!join_set_) {
+    return {};
+  }
+  return {{"join_set_id", std::to_string(reinterpret_cast<std::uintptr_t>(join_set_))}};
+}
+
 void ThreadPool::Task::RecordError() {
   if (!join_set_) {
     return;
@@ -69,9 +74,27 @@ void ThreadPool::Task::RecordError() {
   }
 }
 
+namespace {
+/**
+ * @brief Pool and deque index of the current thread, if it belongs to a pool
+ */
+thread_local const void *current_pool = nullptr;
+thread_local std::size_t current_worker = 0;
+
+/**
+ * @brief Round-robin counter of the current thread to distribute the tasks it spawns on a pool it does not belong to
+ */
+thread_local std::size_t next_worker = 0;
+} // namespace
+
 ThreadPool::ThreadPool(int max_threads, armonik::api::common::logger::Logger &logger)
-    : max_threads_(max_threads == 0 ? std::thread::hardware_concurrency() : max_threads), sleeping_threads_(0),
-      logger_(logger), stop_(false) {
+    : max_threads_(max_threads == 0 ? std::max(std::thread::hardware_concurrency(), 1u) : max_threads),
+      started_threads_(0), sleeping_threads_(0), pending_tasks_(0), logger_(logger), stop_(false) {
+  workers_.reserve(max_threads_);
+  for (std::size_t i = 0; i < max_threads_; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  threads_.reserve(max_threads_);
   Logger().debug("ThreadPool created", {{"max_threads", std::to_string(max_threads_)}});
 }
 
@@ -101,68 +124,111 @@ armonik::api::common::logger::LocalLogger ThreadPool::Logger(armonik::api::commo
   return logger_.local(std::move(context));
 }
 
-void ThreadPool::Run() {
+bool ThreadPool::TryTake(std::size_t index, Task &task) {
+  { // Own deque first, newest task first
+    auto &worker = *workers_[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (!worker.tasks.empty()) {
+      task = std::move(worker.tasks.back());
+      worker.tasks.pop_back();
+      return true;
+    }
+  }
+
+  // Steal the oldest task of another deque
+  for (std::size_t i = 1; i < workers_.size(); ++i) {
+    auto &victim = *workers_[(index + i) % workers_.size()];
+    std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+    if (lock.owns_lock() && !victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::Run(std::size_t index) {
+  current_pool = this;
+  current_worker = index;
+
   std::stringstream ss;
   ss << std::this_thread::get_id();
-  armonik::api::common::logger::Context context{{"thread_id", ss.str()}};
-  auto logger = Logger(context);
+  auto logger = Logger({{"thread_id", ss.str()}});
 
   logger.debug("Thread started");
 
   while (true) {
     Task task;
 
-    { // Lock the pool to get a new task
-      std::unique_lock<std::mutex> lock(mutex_);
-
-      // Wait for a task or stop signal
-      ++sleeping_threads_;
-      condition_.wait(lock, [this]() { return stop_ || !pending_tasks_.empty(); });
-      --sleeping_threads_;
-
-      // If the stopping of the pool has been requested and there is no more task, exit the thread
-      if (stop_ && pending_tasks_.empty()) {
-        break;
+    if (pending_tasks_.load() > 0) {
+      if (TryTake(index, task)) {
+        pending_tasks_.fetch_sub(1);
+        // Execute the task, the task destructor will handle JoinSet bookkeeping
+        task.Execute(logger);
+      } else {
+        // A task is being pushed, or every deque holding one is locked
+        std::this_thread::yield();
       }
-
-      // Get the next task
-      task = std::move(pending_tasks_.front());
-      pending_tasks_.pop();
+      continue;
     }
 
-    auto task_logger = task.join_set_ ? task.join_set_->Logger(context) : Logger(context);
-    task_logger.verbose("Got a new task to execute");
-
-    // Execute the task
-    task.Execute(task_logger);
+    // Nothing to do: sleep until a task is spawned. The sleeping count is published before checking the pending
+    // tasks, and spawners publish the pending tasks before checking the sleeping count, so no wake-up is lost.
+    std::unique_lock<std::mutex> lock(mutex_);
+    sleeping_threads_.fetch_add(1);
+    condition_.wait(lock, [this]() { return stop_ || pending_tasks_.load() > 0; });
+    sleeping_threads_.fetch_sub(1);
 
-    // Task destructor will handle JoinSet bookkeeping
+    // If the stopping of the pool has been requested and there is no more task, exit the thread
+    if (stop_ && pending_tasks_.load() == 0) {
+      break;
+    }
   }
 
   logger.debug("Thread stopped");
 }
 
-void ThreadPool::Spawn(Task &&task) {
-  auto logger = task.join_set_ ? task.join_set_->Logger() : Logger();
-  logger.verbose("Spawning new task");
+void ThreadPool::StartThreadIfNeeded() {
+  if (sleeping_threads_.load() > 0) {
+    // Synchronize with the sleeping thread so that the notification cannot happen between its check and its wait
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    condition_.notify_one();
+    return;
+  }
+  if (started_threads_.load(std::memory_order_relaxed) >= max_threads_) {
+    return;
+  }
 
-  { // Lock the pool to enqueue a new task
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (stop_) {
-      throw std::runtime_error("Spawn on stopped ThreadPool");
-    }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto index = started_threads_.load(std::memory_order_relaxed);
+  if (index < max_threads_ && !stop_) {
+    threads_.emplace_back([this, index]() { Run(index); });
+    started_threads_.store(index + 1);
+  }
+}
 
-    // Enqueue the task
-    pending_tasks_.push(std::move(task));
+void ThreadPool::Spawn(Task &&task) {
+  if (stop_) {
+    throw std::runtime_error("Spawn on stopped ThreadPool");
+  }
 
-    // If there are no sleeping threads and we have not reached max threads, create a new thread
-    if (sleeping_threads_ == 0 && threads_.size() < max_threads_) {
-      threads_.emplace_back([this]() { Run(); });
-    }
+  // Nested spawns stay on the deque of the current thread, others are distributed over the started threads
+  std::size_t index;
+  if (current_pool == this) {
+    index = current_worker;
+  } else {
+    index = next_worker++ % std::max<std::size_t>(started_threads_.load(std::memory_order_relaxed), 1);
+  }
 
-    // Notify one thread that there is a new task available
-    condition_.notify_one();
+  pending_tasks_.fetch_add(1);
+  {
+    auto &worker = *workers_[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.tasks.push_back(std::move(task));
   }
+
+  StartThreadIfNeeded();
 }
 
 void ThreadPool::Spawn(Function<void()> &&f) { Spawn(Task(std::move(f))); }
@@ -173,7 +239,7 @@ ThreadPool::JoinSet::JoinSet(ThreadPool &thread_pool) : thread_pool_(thread_pool
 
 ThreadPool::JoinSet::~JoinSet() {
   std::unique_lock<std::mutex> lock(mutex_);
-  wake_condition_.wait(lock, [this]() { return task_count_ == 0; });
+  wake_condition_.wait(lock, [this]() { return task_count_.load() == 0; });
 
   Logger().debug("JoinSet destroyed");
 }
@@ -183,11 +249,29 @@ armonik::api::common::logger::LocalLogger ThreadPool::JoinSet::Logger(armonik::a
   return thread_pool_.Logger(std::move(context));
 }
 
+void ThreadPool::JoinSet::TaskDone() {
+  auto count = task_count_.load();
+  while (count > 1) {
+    if (task_count_.compare_exchange_weak(count, count - 1)) {
+      return;
+    }
+  }
+
+  // Last task: decrement under the mutex, so that a waiter can only observe the empty join set, and then destroy it,
+  // once this function no longer uses it
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (task_count_.fetch_sub(1) == 1) {
+    wake_condition_.notify_all();
+  }
+}
+
 void ThreadPool::JoinSet::Spawn(Function<void()> &&f) { thread_pool_.Spawn(Task(std::move(f), this)); }
 
+ThreadPool::JoinSet::Pending ThreadPool::JoinSet::Track() { return Pending(*this); }
+
 void ThreadPool::JoinSet::Wait() {
   std::unique_lock<std::mutex> lock(mutex_);
-  wake_condition_.wait(lock, [this]() { return task_count_ == 0 || exception_; });
+  wake_condition_.wait(lock, [this]() { return task_count_.load() == 0 || exception_; });
 
   if (exception_) {
     Logger().debug("Rethrow JoinSet error");
@@ -199,6 +283,60 @@ void ThreadPool::JoinSet::Wait() {
   Logger().debug("JoinSet emptied");
 }
 
+ThreadPool::JoinSet::Pending::Pending(JoinSet &join_set) : join_set_(&join_set) {
+  join_set_->task_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+ThreadPool::JoinSet::Pending::Pending(Pending &&other) noexcept : join_set_(other.join_set_) {
+  other.join_set_ = nullptr;
+}
+
+ThreadPool::JoinSet::Pending &ThreadPool::JoinSet::Pending::operator=(Pending &&other) noexcept {
+  if (this != &other) {
+    if (join_set_) {
+      join_set_->TaskDone();
+    }
+    join_set_ = other.join_set_;
+    other.join_set_ = nullptr;
+  }
+  return *this;
+}
+
+ThreadPool::JoinSet::Pending::~Pending() {
+  if (join_set_) {
+    join_set_->TaskDone();
+  }
+}
+
+void ThreadPool::JoinSet::Pending::Then(Function<void()> &&f) {
+  if (!join_set_) {
+    return;
+  }
+  // The continuation is counted before the operation is done, so that the join set is never seen empty in between
+  auto join_set = join_set_;
+  join_set_ = nullptr;
+  join_set->Spawn(std::move(f));
+  join_set->TaskDone();
+}
+
+void ThreadPool::JoinSet::Pending::Fail(std::exception_ptr e) {
+  if (!join_set_) {
+    return;
+  }
+  auto join_set = join_set_;
+  join_set_ = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(join_set->mutex_);
+
+    // Keep only the first exception
+    if (!join_set->exception_) {
+      join_set->exception_ = std::move(e);
+      join_set->wake_condition_.notify_all();
+    }
+  }
+  join_set->TaskDone();
+}
+
 } // namespace Internal
 } // namespace Client
 } // namespace Sdk
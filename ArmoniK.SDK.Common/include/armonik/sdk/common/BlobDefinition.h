@@ -1,28 +1,56 @@
 #pragma once
 
+#include <memory>
 #include <string>
+#include <utility>
 
 namespace ArmoniK {
 namespace Sdk {
 namespace Common {
 
 /**
- * @brief Represents an input blob: either raw data to be uploaded, or a reference to an
+ * @brief Represents an input blob: either raw data or a file to be uploaded, or a reference to an
  * already-existing blob by ID.
  *
  * Use BlobDefinition::FromData() when you have the raw bytes and want the library to upload
- * them. Use BlobDefinition::FromBlobId() to reference a blob that was already uploaded (e.g.
+ * them. Use BlobDefinition::FromFile() to upload the content of a file without loading it in
+ * memory. Use BlobDefinition::FromBlobId() to reference a blob that was already uploaded (e.g.
  * a shared large dataset reused across many tasks).
  */
 struct BlobDefinition {
   /**
    * @brief Creates a BlobDefinition carrying raw data to be uploaded on submission.
    * @param data Raw bytes to upload
+   * @note Copies of the definition share the data, which is uploaded once per submission
    */
   static BlobDefinition FromData(std::string data) {
+    return FromSharedData(std::make_shared<const std::string>(std::move(data)));
+  }
+
+  /**
+   * @brief Creates a BlobDefinition carrying raw data shared with the caller, to be uploaded on submission.
+   * @param data Raw bytes to upload, which are not copied
+   * @note The same buffer given to several definitions of a submission is uploaded once
+   */
+  static BlobDefinition FromSharedData(std::shared_ptr<const std::string> data) {
+    BlobDefinition b;
+    b.kind_ = Kind::Data;
+    b.data_ = std::move(data);
+    return b;
+  }
+
+  /**
+   * @brief Creates a BlobDefinition carrying a file whose content is uploaded on submission.
+   * The file is mapped in memory (read through a file stream on Windows) and uploaded in chunks, small files being sent
+   * with the creation of the blob.
+   * @param path Path of the file, which must not be modified until the submission returns: truncating a mapped file
+   * while it is read kills the process with SIGBUS
+   * @note The same path given to several definitions of a submission is uploaded once
+   */
+  static BlobDefinition FromFile(std::string path) {
     BlobDefinition b;
-    b.is_raw_data_ = true;
-    b.value_ = std::move(data);
+    b.kind_ = Kind::File;
+    b.value_ = std::move(path);
     return b;
   }
 
@@ -32,29 +60,55 @@ struct BlobDefinition {
    */
   static BlobDefinition FromBlobId(std::string blob_id) {
     BlobDefinition b;
-    b.is_raw_data_ = false;
+    b.kind_ = Kind::BlobId;
     b.value_ = std::move(blob_id);
     return b;
   }
 
   /**
-   * @brief Returns true if this definition holds raw data (to be uploaded), false if it
-   * references an existing blob ID.
+   * @brief Returns true if this definition holds raw data (to be uploaded).
+   */
+  [[nodiscard]] bool IsRawData() const { return kind_ == Kind::Data; }
+
+  /**
+   * @brief Returns true if this definition holds a file (to be uploaded).
+   */
+  [[nodiscard]] bool IsFile() const { return kind_ == Kind::File; }
+
+  /**
+   * @brief Returns true if this definition references an existing blob ID.
    */
-  [[nodiscard]] bool IsRawData() const { return is_raw_data_; }
+  [[nodiscard]] bool IsBlobId() const { return kind_ == Kind::BlobId; }
 
   /**
    * @brief Returns the raw data. Only valid when IsRawData() is true.
    */
-  [[nodiscard]] const std::string &GetData() const { return value_; }
+  [[nodiscard]] const std::string &GetData() const {
+    static const std::string empty;
+    return data_ ? *data_ : empty;
+  }
+
+  /**
+   * @brief Returns the buffer holding the raw data, shared with the copies of the definition. Only valid when
+   * IsRawData() is true.
+   */
+  [[nodiscard]] const std::shared_ptr<const std::string> &GetSharedData() const { return data_; }
+
+  /**
+   * @brief Returns the file path. Only valid when IsFile() is true.
+   */
+  [[nodiscard]] const std::string &GetPath() const { return value_; }
 
   /**
-   * @brief Returns the blob ID. Only valid when IsRawData() is false.
+   * @brief Returns the blob ID. Only valid when IsBlobId() is true.
    */
   [[nodiscard]] const std::string &GetBlobId() const { return value_; }
 
 private:
-  bool is_raw_data_ = true;
+  enum class Kind { Data, File, BlobId };
+
+  Kind kind_ = Kind::Data;
+  std::shared_ptr<const std::string> data_;
   std::string value_;
 };
 
@@ -143,6 +143,102 @@ public:
    */
   [[nodiscard]] int getOverrideMessageSize() const;
 
+  /**
+   * @brief Use the binary encoding for legacy TaskPayloads
+   * @return True if TaskPayloads are serialized with TaskPayload::Encoding::Binary
+   * @note Configuration key: `GrpcClient__BinaryTaskPayload` (default: false)
+   * @note Only enable it when every worker uses this version of the SDK or a later one
+   */
+  [[nodiscard]] bool isBinaryTaskPayload() const;
+
+  /**
+   * @brief Number of channels opened to the control plane when the session service is created
+   * @return Minimum number of channels
+   * @note Configuration key: `GrpcClient__MinChannels` (default: 1)
+   */
+  [[nodiscard]] int getMinChannels() const;
+
+  /**
+   * @brief Maximum number of channels opened to the control plane
+   * @return Maximum number of channels
+   * @note Configuration key: `GrpcClient__MaxChannels` (default: 4)
+   * @note Once reached, calls wait for a channel to have a free stream
+   */
+  [[nodiscard]] int getMaxChannels() const;
+
+  /**
+   * @brief Maximum number of blocking calls and streams sharing a channel
+   * @return Maximum number of streams per channel
+   * @note Configuration key: `GrpcClient__MaxStreamsPerChannel` (default: 64)
+   * @note Asynchronous calls are multiplexed on the channels without counting against this limit
+   */
+  [[nodiscard]] int getMaxStreamsPerChannel() const;
+
+  /**
+   * @brief Number of threads calling the result handlers
+   * @return Handler thread pool size
+   * @note Configuration key: `GrpcClient__HandlerThreadPoolSize` (default: 0)
+   * @note 0 means hardware concurrency
+   */
+  [[nodiscard]] int getHandlerThreadPoolSize() const;
+
+  /**
+   * @brief Maximum number of results being downloaded or waiting for a handler thread, including the results
+   * streamed to their handler while downloaded
+   * @return Maximum number of concurrent downloads
+   * @note Configuration key: `GrpcClient__MaxConcurrentDownloads` (default: 0)
+   * @note 0 means the size of the thread pool
+   */
+  [[nodiscard]] int getMaxConcurrentDownloads() const;
+
+  /**
+   * @brief Smallest batch size the adaptive batching can reach
+   * @return Minimum batch size
+   * @note Configuration key: `GrpcClient__MinBatchSize` (default: 10)
+   * @note The submit and wait batch sizes are the initial batch sizes, adjusted between the minimum and the maximum
+   */
+  [[nodiscard]] int getMinBatchSize() const;
+
+  /**
+   * @brief Largest batch size the adaptive batching can reach
+   * @return Maximum batch size
+   * @note Configuration key: `GrpcClient__MaxBatchSize` (default: 1000)
+   */
+  [[nodiscard]] int getMaxBatchSize() const;
+
+  /**
+   * @brief Latency of a batched call above which the batch size is reduced
+   * @return Target latency in milliseconds
+   * @note Configuration key: `GrpcClient__BatchTargetLatencyMs` (default: 1000)
+   * @note 0 disables the adaptive batching: the submit and wait batch sizes are used as is
+   */
+  [[nodiscard]] int getBatchTargetLatencyMs() const;
+
+  /**
+   * @brief Time after which a partial batch of a TaskSubmitter is submitted
+   * @return Flush delay in milliseconds
+   * @note Configuration key: `GrpcClient__BatchFlushDelayMs` (default: 50)
+   * @note 0 disables the time based flush: partial batches wait for Flush() or Close()
+   */
+  [[nodiscard]] int getBatchFlushDelayMs() const;
+
+  /**
+   * @brief Whether the raw inputs uploaded in a session are reused when a later submission has the same content
+   * @return true if the input cache is enabled
+   * @note Configuration key: `GrpcClient__InputCache` (default: false)
+   * @note The contents are found by digest then compared byte for byte, and the cache is cleared by DropSession()
+   */
+  [[nodiscard]] bool isInputCacheEnabled() const;
+
+  /**
+   * @brief Maximum total size of the contents kept by the input cache
+   * @return Input cache size in bytes
+   * @note Configuration key: `GrpcClient__InputCacheMaxSize` (default: 67108864)
+   * @note The cache shares the buffers of the blob definitions, and evicts the least recently used inputs. 0 keeps no
+   * input
+   */
+  [[nodiscard]] int getInputCacheMaxSize() const;
+
 private:
   std::unique_ptr<armonik::api::common::options::ControlPlane> impl;
   [[nodiscard]] const armonik::api::common::options::ControlPlane &get_impl() const;
@@ -151,6 +247,18 @@ private:
   int submit_batch_size_;
   int thread_pool_size_;
   int override_message_size_;
+  bool binary_task_payload_;
+  int min_channels_;
+  int max_channels_;
+  int max_streams_per_channel_;
+  int handler_thread_pool_size_;
+  int max_concurrent_downloads_;
+  int min_batch_size_;
+  int max_batch_size_;
+  int batch_target_latency_ms_;
+  int batch_flush_delay_ms_;
+  bool input_cache_;
+  int input_cache_max_size_;
 };
 
 /**
@@ -18,7 +18,10 @@ struct DynamicLibrary {
   // from ArmoniK blob storage at task execution time instead of reading it from the local filesystem.
   // LibraryPath is not required when LibraryBlobId is set.
   static constexpr const char *KeyLibraryBlobId = "LibraryBlobId";
+  // JSON payloads, understood by every ArmoniK SDK
   static constexpr const char *ConventionVersion = "v1";
+  // Compact binary payloads, only understood by the C++ DynamicWorker
+  static constexpr const char *ConventionVersionBinary = "v2";
 
   // Path to the .so to load on the worker filesystem.
   // Not required when library_blob_id is set (the path is resolved at runtime from the blob).
@@ -32,6 +35,10 @@ struct DynamicLibrary {
   // from the task's data dependencies and writes it to a temp file before dlopen-ing it.
   // Set via SessionService::UploadLibrary(path, lib).
   std::string library_blob_id;
+
+  // Convention version written in the task options, selecting the payload encoding.
+  // Use ConventionVersionBinary when the tasks are executed by the C++ DynamicWorker to avoid JSON serialization.
+  std::string convention_version = ConventionVersion;
 };
 
 } // namespace Common
@@ -103,7 +103,7 @@ struct TaskOptions {
 
   /**
    * @brief Encodes a DynamicLibrary into this->options using the convention keys.
-   * Also sets the ConventionVersion key.
+   * Also sets the ConventionVersion key from lib.convention_version.
    * @param lib DynamicLibrary to encode
    */
   void SetDynamicLibrary(const DynamicLibrary &lib);
@@ -3,18 +3,72 @@
 #include <absl/strings/string_view.h>
 #include <map>
 #include <sstream>
+#include <string>
 #include <vector>
 
 namespace ArmoniK {
 namespace Sdk {
 namespace Common {
 
+/**
+ * @brief Read-only view on a serialized TaskPayload
+ *
+ * Every string_view points into the serialized buffer, which must outlive the view. Both the hex encoding and the
+ * binary encoding are accepted, the encoding being detected from the content.
+ */
+struct TaskPayloadView {
+  /**
+   * @brief Task's method name
+   */
+  absl::string_view method_name;
+
+  /**
+   * @brief Method's serialized arguments
+   */
+  absl::string_view arguments;
+
+  /**
+   * @brief Task's data dependencies
+   */
+  std::vector<absl::string_view> data_dependencies;
+
+  /**
+   * @brief Decodes a serialized payload without copying its fields
+   * @param serialized Serialized payload, must outlive the view
+   * @return View on the payload
+   * @throws std::runtime_error if the payload is malformed
+   */
+  static TaskPayloadView Parse(absl::string_view serialized);
+
+  /**
+   * @brief Checks whether a serialized payload uses the binary encoding
+   * @param serialized Serialized payload
+   * @return true if the payload uses the binary encoding
+   */
+  static bool IsBinary(absl::string_view serialized);
+};
+
 /**
  * @brief Task payload using custom binary encoding.
  * Used on the legacy execution path (application_name / application_version based loading).
  * @deprecated Use TaskDefinition with Submit(std::vector<TaskDefinition>) instead.
  */
 struct [[deprecated("Use TaskDefinition with Submit(std::vector<TaskDefinition>) instead")]] TaskPayload {
+  /**
+   * @brief Wire encoding of the payload
+   */
+  enum class Encoding {
+    /**
+     * @brief Original encoding, field sizes written as 8 hexadecimal characters. Understood by every worker
+     */
+    Hex,
+    /**
+     * @brief Binary encoding, field sizes written as little-endian 32 bits integers. Only understood by workers
+     * using this version of the SDK
+     */
+    Binary
+  };
+
   TaskPayload() = default;
   /**
    * @brief Constructs a task payload
@@ -43,14 +97,16 @@ struct [[deprecated("Use TaskDefinition with Submit(std::vector<TaskDefinition>)
 
   /**
    * @brief Serializes the payload into the legacy binary format
+   * @param encoding Encoding of the field sizes
    * @return Serialized payload
    */
-  [[nodiscard]] std::string Serialize() const;
+  [[nodiscard]] std::string Serialize(Encoding encoding = Encoding::Hex) const;
 
   /**
    * @brief Deserializes a payload from the legacy binary format
-   * @param serialized Serialized payload
+   * @param serialized Serialized payload, in either encoding
    * @return Deserialized payload
+   * @note Use TaskPayloadView::Parse() to avoid copying the fields
    */
   static TaskPayload Deserialize(absl::string_view serialized);
 };
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "armonik/sdk/common/ArmoniKSdkException.h"
+#include <absl/strings/string_view.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ArmoniK {
+namespace Sdk {
+namespace Common {
+namespace BinaryCodec {
+
+/**
+ * @brief Helpers shared by the binary payload encodings.
+ *
+ * Integers are written as fixed-width little-endian values, byte by byte, so the encoding does not depend on the host
+ * endianness or alignment. Writers append to a buffer that is expected to be pre-sized by the caller; readers consume
+ * a string_view and never copy the data they return.
+ *
+ * @note This is an internal SDK header. It is not part of the public API and
+ *       may change or be removed in any future release without notice.
+ */
+
+/**
+ * @brief Size of an encoded 32 bits length
+ */
+constexpr std::size_t U32Size = 4;
+
+/**
+ * @brief Writes a little-endian 32 bits integer
+ * @param out Output cursor, advanced past the written bytes
+ * @param value Value to write
+ */
+inline void PutU32(char *&out, std::uint32_t value) {
+  for (std::size_t i = 0; i < U32Size; ++i) {
+    *out++ = static_cast<char>((value >> (8 * i)) & 0xFF);
+  }
+}
+
+/**
+ * @brief Writes a length-prefixed field
+ * @param out Output cursor, advanced past the written bytes
+ * @param field Field to write
+ */
+inline void PutField(char *&out, absl::string_view field) {
+  if (field.size() > UINT32_MAX) {
+    throw ArmoniKSdkException("Field too large to be encoded: " + std::to_string(field.size()) + " bytes");
+  }
+  PutU32(out, static_cast<std::uint32_t>(field.size()));
+  out = std::copy(field.begin(), field.end(), out);
+}
+
+/**
+ * @brief Size of a length-prefixed field
+ * @param field Field
+ * @return Encoded size
+ */
+constexpr std::size_t FieldSize(absl::string_view field) { return U32Size + field.size(); }
+
+/**
+ * @brief Extracts raw bytes from the input
+ * @param in Input, advanced past the extracted bytes
+ * @param size Number of bytes to extract
+ * @return View on the extracted bytes
+ * @throws ArmoniKSdkException if the input is too short
+ */
+inline absl::string_view GetBytes(absl::string_view &in, std::size_t size) {
+  if (in.size() < size) {
+    throw ArmoniKSdkException("Truncated binary payload: expected " + std::to_string(size) + " bytes, got " +
+                              std::to_string(in.size()));
+  }
+  auto extracted = in.substr(0, size);
+  in.remove_prefix(size);
+  return extracted;
+}
+
+/**
+ * @brief Reads a little-endian 32 bits integer
+ * @param in Input, advanced past the read bytes
+ * @return Read value
+ * @throws ArmoniKSdkException if the input is too short
+ */
+inline std::uint32_t GetU32(absl::string_view &in) {
+  auto bytes = GetBytes(in, U32Size);
+  std::uint32_t value = 0;
+  for (std::size_t i = 0; i < U32Size; ++i) {
+    value |= static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+  }
+  return value;
+}
+
+/**
+ * @brief Reads a length-prefixed field
+ * @param in Input, advanced past the read field
+ * @return View on the field content
+ * @throws ArmoniKSdkException if the input is too short
+ */
+inline absl::string_view GetField(absl::string_view &in) { return GetBytes(in, GetU32(in)); }
+
+/**
+ * @brief Checks whether the input starts with the given magic
+ * @param in Input
+ * @param magic Expected magic
+ * @return true if the input starts with magic
+ */
+inline bool HasMagic(absl::string_view in, absl::string_view magic) { return in.substr(0, magic.size()) == magic; }
+
+} // namespace BinaryCodec
+} // namespace Common
+} // namespace Sdk
+} // namespace ArmoniK
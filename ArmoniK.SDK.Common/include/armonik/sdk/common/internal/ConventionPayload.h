@@ -1,31 +1,161 @@
 #pragma once
 
 #include <absl/strings/string_view.h>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <map>
 #include <string>
+#include <utility>
 
 namespace ArmoniK {
 namespace Sdk {
 namespace Common {
 
 /**
- * @brief Convention task payload using JSON encoding.
+ * @brief Convention task payload.
  *
- * Internal wire format for the convention execution path.
- * Serialized format: {"method":"<method_name>","inputs":{...},"outputs":{...}}
+ * Internal wire format for the convention execution path. Two encodings are supported, selected by the
+ * ConventionVersion task option:
+ * - v1, JSON: {"method":"<method_name>","inputs":{...},"outputs":{...}}
+ * - v2, binary: "AKCP" magic, little-endian u32 version, then length-prefixed fields:
+ *   method, input count, (name, value) pairs, output count, (name, value) pairs.
+ *   Every name is followed by a null byte so that it can be handed to C interfaces without copy.
+ *
+ * Deserialize() detects the encoding from the content, so both can always be read.
  *
  * @note This is an internal SDK type. It is not part of the public API and
  *       may change or be removed in any future release without notice.
  */
 struct ConventionPayload {
+  /**
+   * @brief Wire encoding of the payload
+   */
+  enum class Encoding {
+    /**
+     * @brief JSON encoding, ConventionVersion v1, readable by every ArmoniK SDK
+     */
+    Json,
+    /**
+     * @brief Compact binary encoding, ConventionVersion v2
+     */
+    Binary
+  };
+
   ConventionPayload() = default;
 
   std::string method_name;
   std::map<std::string, std::string> inputs;
   std::map<std::string, std::string> outputs;
 
-  [[nodiscard]] std::string Serialize() const;
+  [[nodiscard]] std::string Serialize(Encoding encoding = Encoding::Json) const;
   static ConventionPayload Deserialize(absl::string_view serialized);
+
+  /**
+   * @brief Checks whether a serialized payload uses the binary encoding
+   * @param serialized Serialized payload
+   * @return true if the payload can be read with ConventionPayloadView
+   */
+  static bool IsBinary(absl::string_view serialized);
+
+  /**
+   * @brief Gets the encoding associated with a ConventionVersion
+   * @param convention_version Value of the ConventionVersion task option
+   * @return Encoding of the payloads
+   * @throws ArmoniKSdkException if the version is not supported
+   */
+  static Encoding EncodingFromVersion(absl::string_view convention_version);
+};
+
+/**
+ * @brief Read-only view on a binary encoded ConventionPayload.
+ *
+ * The view does not allocate: every string_view points into the serialized buffer, which must outlive the view.
+ *
+ * @note This is an internal SDK type. It is not part of the public API and
+ *       may change or be removed in any future release without notice.
+ */
+class ConventionPayloadView {
+public:
+  /**
+   * @brief Encoded (name, value) pairs, decoded on iteration
+   */
+  class Entries {
+  public:
+    /**
+     * @brief Forward iterator on the entries
+     * @note The name viewed is followed by a null byte in the underlying buffer
+     */
+    class iterator {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = std::pair<absl::string_view, absl::string_view>;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const value_type *;
+      using reference = const value_type &;
+
+      iterator() = default;
+      reference operator*() const { return current; }
+      pointer operator->() const { return &current; }
+      iterator &operator++() {
+        ++index;
+        decode();
+        return *this;
+      }
+      iterator operator++(int) {
+        auto copy = *this;
+        ++*this;
+        return copy;
+      }
+      bool operator==(const iterator &other) const { return index == other.index; }
+      bool operator!=(const iterator &other) const { return index != other.index; }
+
+    private:
+      friend class Entries;
+      iterator(absl::string_view remaining, std::uint32_t index, std::uint32_t count)
+          : remaining(remaining), index(index), count(count) {
+        decode();
+      }
+      void decode();
+
+      absl::string_view remaining;
+      std::uint32_t index = 0;
+      std::uint32_t count = 0;
+      value_type current;
+    };
+
+    Entries() = default;
+
+    /**
+     * @brief Number of entries
+     */
+    [[nodiscard]] std::size_t size() const { return count; }
+    /**
+     * @brief Whether there is no entry
+     */
+    [[nodiscard]] bool empty() const { return count == 0; }
+    [[nodiscard]] iterator begin() const { return {data, 0, count}; }
+    [[nodiscard]] iterator end() const { return {absl::string_view(), count, count}; }
+
+  private:
+    friend class ConventionPayloadView;
+    Entries(absl::string_view data, std::uint32_t count) : data(data), count(count) {}
+
+    absl::string_view data;
+    std::uint32_t count = 0;
+  };
+
+  /**
+   * @brief Decodes and validates a binary encoded payload
+   * @param serialized Serialized payload, must outlive the view
+   * @return View on the payload
+   * @throws ArmoniKSdkException if the payload is not a valid binary payload
+   */
+  static ConventionPayloadView Parse(absl::string_view serialized);
+
+  absl::string_view method_name;
+  Entries inputs;
+  Entries outputs;
 };
 
 } // namespace Common
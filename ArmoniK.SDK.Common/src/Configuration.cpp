@@ -5,6 +5,8 @@
 #include <armonik/common/options/ControlPlane.h>
 #include <armonik/common/utils/Configuration.h>
 
+#include <algorithm>
+#include <cctype>
 #include <utility>
 
 /**
@@ -65,6 +67,31 @@ int getIntFromConfig(const Configuration &config, const std::string &key, int de
   }
   return value > 0 ? value : default_value; // Ensure positive value
 }
+
+/**
+ * @brief Read an integer for which 0 is meaningful, the default being kept if the key is missing, invalid or negative
+ */
+int getNonNegativeIntFromConfig(const Configuration &config, const std::string &key, int default_value) {
+  try {
+    auto value = std::stoi(config.get(key));
+    return value >= 0 ? value : default_value;
+  } catch (...) {
+    return default_value;
+  }
+}
+
+bool getBoolFromConfig(const Configuration &config, const std::string &key, bool default_value) {
+  auto value_str = config.get(key);
+  std::transform(value_str.begin(), value_str.end(), value_str.begin(),
+                 [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  if (value_str == "true" || value_str == "1") {
+    return true;
+  }
+  if (value_str == "false" || value_str == "0") {
+    return false;
+  }
+  return default_value; // Ignore invalid value and keep default
+}
 } // namespace
 
 ControlPlane::ControlPlane(const Configuration &config)
@@ -72,12 +99,31 @@ ControlPlane::ControlPlane(const Configuration &config)
       wait_batch_size_(getIntFromConfig(config, "GrpcClient__WaitBatchSize", 200)),
       submit_batch_size_(getIntFromConfig(config, "GrpcClient__SubmitBatchSize", 200)),
       thread_pool_size_(getIntFromConfig(config, "GrpcClient__ThreadPoolSize", 0)),
-      override_message_size_(getIntFromConfig(config, "GrpcClient__OverrideMessageSize", 0)) {}
+      override_message_size_(getIntFromConfig(config, "GrpcClient__OverrideMessageSize", 0)),
+      binary_task_payload_(getBoolFromConfig(config, "GrpcClient__BinaryTaskPayload", false)),
+      min_channels_(getIntFromConfig(config, "GrpcClient__MinChannels", 1)),
+      max_channels_(std::max(getIntFromConfig(config, "GrpcClient__MaxChannels", 4), min_channels_)),
+      max_streams_per_channel_(getIntFromConfig(config, "GrpcClient__MaxStreamsPerChannel", 64)),
+      handler_thread_pool_size_(getIntFromConfig(config, "GrpcClient__HandlerThreadPoolSize", 0)),
+      max_concurrent_downloads_(getIntFromConfig(config, "GrpcClient__MaxConcurrentDownloads", 0)),
+      min_batch_size_(std::max(getIntFromConfig(config, "GrpcClient__MinBatchSize", 10), 1)),
+      max_batch_size_(std::max(getIntFromConfig(config, "GrpcClient__MaxBatchSize", 1000), min_batch_size_)),
+      batch_target_latency_ms_(getNonNegativeIntFromConfig(config, "GrpcClient__BatchTargetLatencyMs", 1000)),
+      batch_flush_delay_ms_(getNonNegativeIntFromConfig(config, "GrpcClient__BatchFlushDelayMs", 50)),
+      input_cache_(getBoolFromConfig(config, "GrpcClient__InputCache", false)),
+      input_cache_max_size_(getNonNegativeIntFromConfig(config, "GrpcClient__InputCacheMaxSize", 64 << 20)) {}
 
 ControlPlane::ControlPlane(const ControlPlane &controlplane)
     : impl(std::make_unique<armonik::api::common::options::ControlPlane>(*controlplane.impl)),
       wait_batch_size_(controlplane.wait_batch_size_), submit_batch_size_(controlplane.submit_batch_size_),
-      thread_pool_size_(controlplane.thread_pool_size_), override_message_size_(controlplane.override_message_size_) {}
+      thread_pool_size_(controlplane.thread_pool_size_), override_message_size_(controlplane.override_message_size_),
+      binary_task_payload_(controlplane.binary_task_payload_), min_channels_(controlplane.min_channels_),
+      max_channels_(controlplane.max_channels_), max_streams_per_channel_(controlplane.max_streams_per_channel_),
+      handler_thread_pool_size_(controlplane.handler_thread_pool_size_),
+      max_concurrent_downloads_(controlplane.max_concurrent_downloads_), min_batch_size_(controlplane.min_batch_size_),
+      max_batch_size_(controlplane.max_batch_size_), batch_target_latency_ms_(controlplane.batch_target_latency_ms_),
+      batch_flush_delay_ms_(controlplane.batch_flush_delay_ms_), input_cache_(controlplane.input_cache_),
+      input_cache_max_size_(controlplane.input_cache_max_size_) {}
 ControlPlane::ControlPlane(ControlPlane &&) noexcept = default;
 
 ControlPlane &ControlPlane::operator=(const ControlPlane &controlplane) {
@@ -86,6 +132,18 @@ ControlPlane &ControlPlane::operator=(const ControlPlane &controlplane) {
   submit_batch_size_ = controlplane.submit_batch_size_;
   thread_pool_size_ = controlplane.thread_pool_size_;
   override_message_size_ = controlplane.override_message_size_;
+  binary_task_payload_ = controlplane.binary_task_payload_;
+  min_channels_ = controlplane.min_channels_;
+  max_channels_ = controlplane.max_channels_;
+  max_streams_per_channel_ = controlplane.max_streams_per_channel_;
+  handler_thread_pool_size_ = controlplane.handler_thread_pool_size_;
+  max_concurrent_downloads_ = controlplane.max_concurrent_downloads_;
+  min_batch_size_ = controlplane.min_batch_size_;
+  max_batch_size_ = controlplane.max_batch_size_;
+  batch_target_latency_ms_ = controlplane.batch_target_latency_ms_;
+  batch_flush_delay_ms_ = controlplane.batch_flush_delay_ms_;
+  input_cache_ = controlplane.input_cache_;
+  input_cache_max_size_ = controlplane.input_cache_max_size_;
   return *this;
 }
 ControlPlane &ControlPlane::operator=(ControlPlane &&) noexcept = default;
@@ -102,6 +160,18 @@ int ControlPlane::getWaitBatchSize() const { return wait_batch_size_; }
 int ControlPlane::getSubmitBatchSize() const { return submit_batch_size_; }
 int ControlPlane::getThreadPoolSize() const { return thread_pool_size_; }
 int ControlPlane::getOverrideMessageSize() const { return override_message_size_; }
+bool ControlPlane::isBinaryTaskPayload() const { return binary_task_payload_; }
+int ControlPlane::getMinChannels() const { return min_channels_; }
+int ControlPlane::getMaxChannels() const { return max_channels_; }
+int ControlPlane::getMaxStreamsPerChannel() const { return max_streams_per_channel_; }
+int ControlPlane::getHandlerThreadPoolSize() const { return handler_thread_pool_size_; }
+int ControlPlane::getMaxConcurrentDownloads() const { return max_concurrent_downloads_; }
+int ControlPlane::getMinBatchSize() const { return min_batch_size_; }
+int ControlPlane::getMaxBatchSize() const { return max_batch_size_; }
+int ControlPlane::getBatchTargetLatencyMs() const { return batch_target_latency_ms_; }
+int ControlPlane::getBatchFlushDelayMs() const { return batch_flush_delay_ms_; }
+bool ControlPlane::isInputCacheEnabled() const { return input_cache_; }
+int ControlPlane::getInputCacheMaxSize() const { return input_cache_max_size_; }
 
 const armonik::api::common::options::ControlPlane &ControlPlane::get_impl() const {
   const static armonik::api::common::options::ControlPlane default_config =
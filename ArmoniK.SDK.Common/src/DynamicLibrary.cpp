@@ -10,6 +10,7 @@ constexpr const char *DynamicLibrary::KeyLibraryPath;
 constexpr const char *DynamicLibrary::KeySymbol;
 constexpr const char *DynamicLibrary::KeyLibraryBlobId;
 constexpr const char *DynamicLibrary::ConventionVersion;
+constexpr const char *DynamicLibrary::ConventionVersionBinary;
 
 } // namespace Common
 } // namespace Sdk
@@ -38,7 +38,8 @@ TaskOptions::TaskOptions(const armonik::api::grpc::v1::TaskOptions &raw)
       options(raw.options().begin(), raw.options().end()) {}
 
 void TaskOptions::SetDynamicLibrary(const DynamicLibrary &lib) {
-  options[DynamicLibrary::KeyConventionVersion] = DynamicLibrary::ConventionVersion;
+  options[DynamicLibrary::KeyConventionVersion] =
+      lib.convention_version.empty() ? DynamicLibrary::ConventionVersion : lib.convention_version;
   options[DynamicLibrary::KeyLibraryPath] = lib.library_path;
   options[DynamicLibrary::KeySymbol] = lib.symbol;
   if (!lib.library_blob_id.empty()) {
@@ -72,6 +73,11 @@ DynamicLibrary TaskOptions::GetDynamicLibrary() const {
   if (it != options.end()) {
     lib.symbol = it->second;
   }
+
+  it = options.find(DynamicLibrary::KeyConventionVersion);
+  if (it != options.end()) {
+    lib.convention_version = it->second;
+  }
   return lib;
 }
 
@@ -1,8 +1,10 @@
 #include "armonik/sdk/common/TaskPayload.h"
 #include "armonik/sdk/common/ArmoniKSdkException.h"
+#include "armonik/sdk/common/DynamicLibrary.h"
+#include "armonik/sdk/common/internal/BinaryCodec.h"
 #include "armonik/sdk/common/internal/ConventionPayload.h"
+#include <algorithm>
 #include <cstdint>
-#include <iomanip>
 #include <nlohmann/json.hpp>
 #include <string>
 
@@ -17,38 +19,58 @@ namespace Common {
 typedef uint32_t field_size_t;
 
 namespace {
-template <typename T> struct TypeParseTraits;
+constexpr std::size_t hex_size_width = sizeof(field_size_t) * 2;
+constexpr absl::string_view task_payload_magic("AKTP", 4);
+constexpr std::uint32_t task_payload_binary_version = 2;
 
-#define REGISTER_PARSE_TYPE(X)                                                                                         \
-  template <> struct TypeParseTraits<X> {                                                                              \
-    static const char *name;                                                                                           \
-  };                                                                                                                   \
-  const char *TypeParseTraits<X>::name = #X
-
-REGISTER_PARSE_TYPE(uint32_t);
+void put_hex_size(char *&out, std::size_t size) {
+  static constexpr char digits[] = "0123456789abcdef";
+  if (size > UINT32_MAX) {
+    throw ArmoniKSdkException("Field too large to be encoded: " + std::to_string(size) + " bytes");
+  }
+  for (std::size_t i = 0; i < hex_size_width; ++i) {
+    out[hex_size_width - 1 - i] = digits[(size >> (4 * i)) & 0xF];
+  }
+  out += hex_size_width;
+}
 
-template <typename T> std::string int_to_hex(T i) {
-  std::stringstream stream;
-  stream << std::setfill('0') << std::setw(sizeof(T) * 2) << std::hex << i;
-  return stream.str();
+void put_hex_field(char *&out, absl::string_view field) {
+  put_hex_size(out, field.size());
+  out = std::copy(field.begin(), field.end(), out);
 }
 
-template <typename T> T hex_to_int(absl::string_view str) {
-  char *endPos;
-  std::string null_terminated(str.data(), str.size());
-  T result = std::strtol(null_terminated.data(), &endPos, 16);
-  if (errno == ERANGE) {
-    throw std::runtime_error(null_terminated + " is too large for " + TypeParseTraits<T>::name);
+field_size_t get_hex_size(absl::string_view &in) {
+  if (in.empty()) {
+    // An empty payload used to decode as empty fields
+    return 0;
   }
-  if (endPos != null_terminated.data() + null_terminated.size()) {
-    throw std::runtime_error(null_terminated + " is not convertible to " + TypeParseTraits<T>::name);
+  if (in.size() < hex_size_width) {
+    throw std::runtime_error(std::string(in) + " is not convertible to uint32_t");
   }
+  field_size_t result = 0;
+  for (std::size_t i = 0; i < hex_size_width; ++i) {
+    char c = in[i];
+    field_size_t digit;
+    if (c >= '0' && c <= '9') {
+      digit = c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+      digit = c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+      digit = c - 'A' + 10;
+    } else {
+      throw std::runtime_error(std::string(in.substr(0, hex_size_width)) + " is not convertible to uint32_t");
+    }
+    result = (result << 4) | digit;
+  }
+  in.remove_prefix(hex_size_width);
   return result;
 }
 
-absl::string_view advance_sv(absl::string_view &sv, size_t offset) {
-  absl::string_view extracted = sv.substr(0, offset);
-  sv = sv.substr(offset);
+absl::string_view get_hex_field(absl::string_view &in) {
+  auto size = get_hex_size(in);
+  // Same lenient behavior as the original decoder: a truncated field ends at the end of the payload
+  auto extracted = in.substr(0, size);
+  in.remove_prefix(extracted.size());
   return extracted;
 }
 } // namespace
@@ -57,53 +79,162 @@ absl::string_view advance_sv(absl::string_view &sv, size_t offset) {
 // TaskPayload (legacy binary format)
 // ---------------------------------------------------------------------------
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+TaskPayloadView TaskPayloadView::Parse(absl::string_view serialized) {
+  TaskPayloadView view;
+  if (BinaryCodec::HasMagic(serialized, task_payload_magic)) {
+    serialized.remove_prefix(task_payload_magic.size());
+    auto version = BinaryCodec::GetU32(serialized);
+    if (version != task_payload_binary_version) {
+      throw ArmoniKSdkException("Unsupported binary task payload version: " + std::to_string(version));
+    }
+    view.method_name = BinaryCodec::GetField(serialized);
+    view.arguments = BinaryCodec::GetField(serialized);
+    auto count = BinaryCodec::GetU32(serialized);
+    if (count > serialized.size() / BinaryCodec::U32Size) {
+      throw ArmoniKSdkException("Malformed binary task payload: invalid data dependency count");
+    }
+    view.data_dependencies.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+      view.data_dependencies.push_back(BinaryCodec::GetField(serialized));
+    }
+    if (!serialized.empty()) {
+      throw ArmoniKSdkException("Malformed binary task payload: " + std::to_string(serialized.size()) +
+                                " trailing bytes");
+    }
+    return view;
+  }
 
-std::string TaskPayload::Serialize() const {
-  std::stringstream ss;
-  ss << int_to_hex((field_size_t)method_name.size()) << method_name << int_to_hex((field_size_t)arguments.size());
-  ss.write(arguments.data(), arguments.size());
-  for (auto &&dd : data_dependencies) {
-    ss << int_to_hex((field_size_t)dd.size()) << dd;
+  view.method_name = get_hex_field(serialized);
+  view.arguments = get_hex_field(serialized);
+  while (!serialized.empty()) {
+    view.data_dependencies.push_back(get_hex_field(serialized));
   }
-  return ss.str();
+  return view;
 }
 
-TaskPayload TaskPayload::Deserialize(absl::string_view serialized) {
-  constexpr size_t size_width = sizeof(field_size_t) * 2;
-  field_size_t fieldSize;
-  std::vector<std::string> data_dependencies;
+bool TaskPayloadView::IsBinary(absl::string_view serialized) {
+  return BinaryCodec::HasMagic(serialized, task_payload_magic);
+}
 
-  fieldSize = hex_to_int<field_size_t>(advance_sv(serialized, size_width));
-  std::string method_name(advance_sv(serialized, fieldSize));
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 
-  fieldSize = hex_to_int<field_size_t>(advance_sv(serialized, size_width));
-  std::string arguments(advance_sv(serialized, fieldSize));
+std::string TaskPayload::Serialize(Encoding encoding) const {
+  std::size_t size;
+  if (encoding == Encoding::Binary) {
+    size = task_payload_magic.size() + 2 * BinaryCodec::U32Size + BinaryCodec::FieldSize(method_name) +
+           BinaryCodec::FieldSize(arguments);
+    for (auto &&dd : data_dependencies) {
+      size += BinaryCodec::FieldSize(dd);
+    }
+  } else {
+    size = 2 * hex_size_width + method_name.size() + arguments.size();
+    for (auto &&dd : data_dependencies) {
+      size += hex_size_width + dd.size();
+    }
+  }
 
-  while (!serialized.empty()) {
-    fieldSize = hex_to_int<field_size_t>(advance_sv(serialized, size_width));
-    data_dependencies.emplace_back(advance_sv(serialized, fieldSize));
+  // Everything is written in place into a buffer of the final size
+  std::string serialized(size, '\0');
+  char *out = &serialized[0];
+  if (encoding == Encoding::Binary) {
+    out = std::copy(task_payload_magic.begin(), task_payload_magic.end(), out);
+    BinaryCodec::PutU32(out, task_payload_binary_version);
+    BinaryCodec::PutField(out, method_name);
+    BinaryCodec::PutField(out, arguments);
+    BinaryCodec::PutU32(out, static_cast<std::uint32_t>(data_dependencies.size()));
+    for (auto &&dd : data_dependencies) {
+      BinaryCodec::PutField(out, dd);
+    }
+  } else {
+    put_hex_field(out, method_name);
+    put_hex_field(out, arguments);
+    for (auto &&dd : data_dependencies) {
+      put_hex_field(out, dd);
+    }
   }
+  return serialized;
+}
 
-  return {std::move(method_name), std::move(arguments), std::move(data_dependencies)};
+TaskPayload TaskPayload::Deserialize(absl::string_view serialized) {
+  auto view = TaskPayloadView::Parse(serialized);
+  std::vector<std::string> data_dependencies(view.data_dependencies.begin(), view.data_dependencies.end());
+  return {std::string(view.method_name), std::string(view.arguments), std::move(data_dependencies)};
 }
 
 #pragma GCC diagnostic pop
 
 // ---------------------------------------------------------------------------
-// ConventionPayload (JSON wire format for the convention path)
+// ConventionPayload (JSON and binary wire formats for the convention path)
 // ---------------------------------------------------------------------------
 
-std::string ConventionPayload::Serialize() const {
-  nlohmann::json j;
-  j["method"] = method_name;
-  j["inputs"] = inputs;
-  j["outputs"] = outputs;
-  return j.dump();
+namespace {
+constexpr absl::string_view convention_magic("AKCP", 4);
+constexpr std::uint32_t convention_binary_version = 2;
+
+std::size_t entries_size(const std::map<std::string, std::string> &entries) {
+  std::size_t size = BinaryCodec::U32Size;
+  for (auto &&entry : entries) {
+    size += BinaryCodec::FieldSize(entry.first) + 1 + BinaryCodec::FieldSize(entry.second);
+  }
+  return size;
+}
+
+void put_entries(char *&out, const std::map<std::string, std::string> &entries) {
+  BinaryCodec::PutU32(out, static_cast<std::uint32_t>(entries.size()));
+  for (auto &&entry : entries) {
+    BinaryCodec::PutField(out, entry.first);
+    *out++ = '\0';
+    BinaryCodec::PutField(out, entry.second);
+  }
+}
+
+std::pair<absl::string_view, absl::string_view> get_entry(absl::string_view &in) {
+  auto name = BinaryCodec::GetField(in);
+  if (BinaryCodec::GetBytes(in, 1)[0] != '\0') {
+    throw ArmoniKSdkException("Malformed binary convention payload: entry name is not null terminated");
+  }
+  auto value = BinaryCodec::GetField(in);
+  return {name, value};
+}
+
+} // namespace
+
+std::string ConventionPayload::Serialize(Encoding encoding) const {
+  if (encoding == Encoding::Json) {
+    nlohmann::json j;
+    j["method"] = method_name;
+    j["inputs"] = inputs;
+    j["outputs"] = outputs;
+    return j.dump();
+  }
+
+  std::string serialized(convention_magic.size() + BinaryCodec::U32Size + BinaryCodec::FieldSize(method_name) +
+                             entries_size(inputs) + entries_size(outputs),
+                         '\0');
+  char *out = &serialized[0];
+  out = std::copy(convention_magic.begin(), convention_magic.end(), out);
+  BinaryCodec::PutU32(out, convention_binary_version);
+  BinaryCodec::PutField(out, method_name);
+  put_entries(out, inputs);
+  put_entries(out, outputs);
+  return serialized;
 }
 
 ConventionPayload ConventionPayload::Deserialize(absl::string_view serialized) {
+  if (IsBinary(serialized)) {
+    auto view = ConventionPayloadView::Parse(serialized);
+    ConventionPayload payload;
+    payload.method_name = std::string(view.method_name);
+    for (auto &&entry : view.inputs) {
+      payload.inputs.emplace(std::string(entry.first), std::string(entry.second));
+    }
+    for (auto &&entry : view.outputs) {
+      payload.outputs.emplace(std::string(entry.first), std::string(entry.second));
+    }
+    return payload;
+  }
+
   try {
     auto j = nlohmann::json::parse(serialized.begin(), serialized.end());
     ConventionPayload payload;
@@ -116,6 +247,53 @@ ConventionPayload ConventionPayload::Deserialize(absl::string_view serialized) {
   }
 }
 
+bool ConventionPayload::IsBinary(absl::string_view serialized) {
+  return BinaryCodec::HasMagic(serialized, convention_magic);
+}
+
+ConventionPayload::Encoding ConventionPayload::EncodingFromVersion(absl::string_view convention_version) {
+  if (convention_version == DynamicLibrary::ConventionVersion) {
+    return Encoding::Json;
+  }
+  if (convention_version == DynamicLibrary::ConventionVersionBinary) {
+    return Encoding::Binary;
+  }
+  throw ArmoniKSdkException("Unsupported convention version: " + std::string(convention_version));
+}
+
+void ConventionPayloadView::Entries::iterator::decode() {
+  if (index < count) {
+    current = get_entry(remaining);
+  }
+}
+
+ConventionPayloadView ConventionPayloadView::Parse(absl::string_view serialized) {
+  if (!ConventionPayload::IsBinary(serialized)) {
+    throw ArmoniKSdkException("Not a binary convention payload");
+  }
+  serialized.remove_prefix(convention_magic.size());
+  auto version = BinaryCodec::GetU32(serialized);
+  if (version != convention_binary_version) {
+    throw ArmoniKSdkException("Unsupported binary convention payload version: " + std::to_string(version));
+  }
+
+  ConventionPayloadView view;
+  view.method_name = BinaryCodec::GetField(serialized);
+  for (auto *entries : {&view.inputs, &view.outputs}) {
+    auto count = BinaryCodec::GetU32(serialized);
+    auto begin = serialized;
+    for (std::uint32_t i = 0; i < count; ++i) {
+      get_entry(serialized);
+    }
+    *entries = Entries(begin.substr(0, begin.size() - serialized.size()), count);
+  }
+  if (!serialized.empty()) {
+    throw ArmoniKSdkException("Malformed binary convention payload: " + std::to_string(serialized.size()) +
+                              " trailing bytes");
+  }
+  return view;
+}
+
 } // namespace Common
 } // namespace Sdk
 } // namespace ArmoniK
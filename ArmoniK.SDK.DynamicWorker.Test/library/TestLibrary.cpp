@@ -0,0 +1,50 @@
+#include <armonik/sdk/worker/ArmoniKSDKInterface.h>
+#include <armonik/sdk/worker/ServiceBase.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+
+/** \file TestLibrary.cpp
+ * Library loaded by the DynamicWorker tests. It relies on the ArmoniK.SDK.Worker defaults, except for armonik_call.
+ * Built with ARMONIK_TEST_THREAD_SAFE, it also declares its services thread safe.
+ */
+
+namespace {
+/**
+ * @brief Number of calls of the "concurrency" method in progress
+ */
+std::atomic<int> calls_in_progress{0};
+} // namespace
+
+extern "C" void *armonik_create_service(const char *, const char *) {
+  return new ArmoniK::Sdk::Worker::ServiceBase();
+}
+
+/**
+ * @brief Executes the test methods
+ * @details The "concurrency" method lasts long enough for concurrent calls to overlap, and returns the service
+ * context and the number of calls in progress when it started. Any other method returns the payload it receives,
+ * prefixed with "armonik_call:" to tell that this function was called.
+ */
+extern "C" armonik_status_t armonik_call(void *armonik_context, void *service_context, void *,
+                                         const char *function_name, const char *input, size_t input_size,
+                                         armonik_callback_t callback) {
+  std::string output;
+  if (std::strcmp(function_name, "concurrency") == 0) {
+    const auto in_progress = ++calls_in_progress;
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    --calls_in_progress;
+    output = std::to_string(reinterpret_cast<std::uintptr_t>(service_context)) + " " + std::to_string(in_progress);
+  } else {
+    output = "armonik_call:" + std::string(input, input_size);
+  }
+  callback(armonik_context, ARMONIK_STATUS_OK, output.data(), output.size());
+  return ARMONIK_STATUS_OK;
+}
+
+#ifdef ARMONIK_TEST_THREAD_SAFE
+extern "C" int armonik_thread_safe() { return 1; }
+#endif
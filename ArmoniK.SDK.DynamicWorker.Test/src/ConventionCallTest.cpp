@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include "DynamicLib.h"
+#include <ArmoniKSDKInterface.h>
+#include <armonik/sdk/common/internal/ConventionPayload.h>
+#include <map>
+#include <string>
+#include <vector>
+
+using ArmoniK::Sdk::Common::ConventionPayload;
+using ArmoniK::Sdk::DynamicWorker::DynamicLib;
+
+namespace {
+/**
+ * @brief Service of a loaded library, entered in a session
+ */
+class LoadedService {
+public:
+  LoadedService(const char *path, const char *service_name) : lib(path) {
+    service = lib.get<armonik_create_service_t>("armonik_create_service")("", service_name);
+    session = lib.get<armonik_enter_session_t>("armonik_enter_session")(service, "session");
+  }
+
+  ~LoadedService() {
+    lib.get<armonik_leave_session_t>("armonik_leave_session")(service, session);
+    lib.get<armonik_destroy_service_t>("armonik_destroy_service")(service);
+  }
+
+  /**
+   * @brief Calls a method through armonik_call_inputs
+   * @return Output of the method
+   */
+  std::string CallInputs(const std::string &method, const std::map<std::string, std::string> &inputs,
+                         const std::map<std::string, std::string> &outputs) {
+    auto to_views = [](const std::map<std::string, std::string> &named) {
+      std::vector<armonik_input_t> views;
+      for (auto &&entry : named) {
+        views.push_back({entry.first.c_str(), entry.second.data(), entry.second.size()});
+      }
+      return views;
+    };
+    const auto input_views = to_views(inputs);
+    const auto output_views = to_views(outputs);
+
+    std::string output;
+    auto status = lib.get<armonik_call_inputs_t>("armonik_call_inputs")(
+        &output, service, session, method.c_str(), input_views.data(), input_views.size(), output_views.data(),
+        output_views.size(), [](void *context, armonik_status_t, const char *data, size_t size) {
+          static_cast<std::string *>(context)->assign(data, size);
+        });
+    EXPECT_EQ(status, ARMONIK_STATUS_OK) << output;
+    return output;
+  }
+
+private:
+  DynamicLib lib;
+  void *service = nullptr;
+  void *session = nullptr;
+};
+} // namespace
+
+TEST(ConventionCall, DefaultCallsServiceWithOutputs) {
+  // EchoService only overrides the raw payload overload, which receives the serialized inputs and outputs
+  LoadedService service(WORKER_TEST_LIBRARY, "EchoService");
+  auto payload = ConventionPayload::Deserialize(service.CallInputs("echo", {{"x", "42"}}, {{"result", "result-id"}}));
+
+  EXPECT_EQ(payload.method_name, "echo");
+  EXPECT_EQ(payload.inputs, (std::map<std::string, std::string>{{"x", "42"}}));
+  EXPECT_EQ(payload.outputs, (std::map<std::string, std::string>{{"result", "result-id"}}));
+}
+
+TEST(ConventionCall, DefaultForwardsToLibraryCall) {
+  // The library provides its own armonik_call, which must receive the payload instead of ServiceBase
+  LoadedService service(TEST_LIBRARY, "Service");
+  auto output = service.CallInputs("echo", {{"x", "42"}}, {{"result", "result-id"}});
+
+  const std::string prefix = "armonik_call:";
+  ASSERT_EQ(output.compare(0, prefix.size(), prefix), 0) << output;
+  auto payload = ConventionPayload::Deserialize(output.substr(prefix.size()));
+  EXPECT_EQ(payload.method_name, "echo");
+  EXPECT_EQ(payload.inputs, (std::map<std::string, std::string>{{"x", "42"}}));
+  EXPECT_EQ(payload.outputs, (std::map<std::string, std::string>{{"result", "result-id"}}));
+}
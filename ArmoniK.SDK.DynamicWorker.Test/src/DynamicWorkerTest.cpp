@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+
+#include "DynamicWorker.h"
+#include <algorithm>
+#include <armonik/common/logger/formatter.h>
+#include <armonik/common/logger/logger.h>
+#include <armonik/common/logger/writer.h>
+#include <armonik/sdk/common/Configuration.h>
+#include <armonik/sdk/common/DynamicLibrary.h>
+#include <armonik/sdk/common/TaskOptions.h>
+#include <armonik/sdk/common/internal/ConventionPayload.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+using armonik::api::grpc::v1::agent::Agent;
+
+/**
+ * @brief Agent accepting every result notification
+ */
+class FakeAgent final : public Agent::Service {
+public:
+  grpc::Status NotifyResultData(grpc::ServerContext *,
+                                const armonik::api::grpc::v1::agent::NotifyResultDataRequest *request,
+                                armonik::api::grpc::v1::agent::NotifyResultDataResponse *response) override {
+    for (auto &&id : request->ids()) {
+      response->add_result_ids(id.result_id());
+    }
+    return grpc::Status::OK;
+  }
+};
+
+/**
+ * @brief DynamicWorker connected to a fake agent, the data of its tasks being stored in a temporary folder
+ */
+class TestWorker {
+public:
+  explicit TestWorker(int parallelism)
+      : logger(armonik::api::common::logger::writer_console(), armonik::api::common::logger::formatter_plain(true),
+               armonik::api::common::logger::Level::Warning) {
+    char folder[] = "/tmp/armonik-dynamic-worker-test-XXXXXX";
+    data_folder = ::mkdtemp(folder);
+
+    int port = 0;
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &port);
+    builder.RegisterService(&agent);
+    server = builder.BuildAndStart();
+
+    ArmoniK::Sdk::Common::Configuration config;
+    config.set("Worker__Parallelism", std::to_string(parallelism));
+    worker = std::make_unique<ArmoniK::Sdk::DynamicWorker::DynamicWorker>(
+        Agent::NewStub(grpc::CreateChannel("127.0.0.1:" + std::to_string(port), grpc::InsecureChannelCredentials())),
+        config, logger);
+  }
+
+  ~TestWorker() {
+    worker.reset();
+    server->Shutdown();
+    for (auto &&file : files) {
+      std::remove(file.c_str());
+    }
+    ::rmdir(data_folder.c_str());
+  }
+
+  /**
+   * @brief Processes a convention task calling a method of a library
+   * @param library_path Path of the library
+   * @param method Name of the method
+   * @param task_id Id of the task, used to name its payload and result
+   * @return Output of the method
+   */
+  std::string Process(const std::string &library_path, const std::string &method, const std::string &task_id) {
+    ArmoniK::Sdk::Common::DynamicLibrary lib;
+    lib.library_path = library_path;
+    lib.symbol = method;
+    ArmoniK::Sdk::Common::TaskOptions options("", "", "DynamicWorkerTest", "Service");
+    options.SetDynamicLibrary(lib);
+
+    ArmoniK::Sdk::Common::ConventionPayload payload;
+    payload.method_name = method;
+    payload.outputs["result"] = task_id + "-result";
+
+    armonik::api::grpc::v1::worker::ProcessRequest request;
+    request.set_session_id("session");
+    request.set_task_id(task_id);
+    *request.mutable_task_options() = static_cast<armonik::api::grpc::v1::TaskOptions>(options);
+    request.add_expected_output_keys(payload.outputs["result"]);
+    request.set_payload_id(task_id + "-payload");
+    request.set_data_folder(data_folder);
+    WriteFile(request.payload_id(), payload.Serialize());
+    AddFile(payload.outputs["result"]);
+
+    armonik::api::grpc::v1::worker::ProcessReply reply;
+    grpc::ServerContext context;
+    auto status = worker->Process(&context, &request, &reply);
+    EXPECT_TRUE(status.ok()) << status.error_message();
+    EXPECT_TRUE(reply.output().has_ok()) << reply.output().error().details();
+
+    std::ifstream result(data_folder + "/" + payload.outputs["result"], std::ios::binary);
+    std::ostringstream output;
+    output << result.rdbuf();
+    return output.str();
+  }
+
+private:
+  void AddFile(const std::string &name) {
+    std::lock_guard<std::mutex> _(files_mutex);
+    files.push_back(data_folder + "/" + name);
+  }
+
+  void WriteFile(const std::string &name, const std::string &content) {
+    AddFile(name);
+    std::ofstream(data_folder + "/" + name, std::ios::binary) << content;
+  }
+
+  armonik::api::common::logger::Logger logger;
+  std::string data_folder;
+  FakeAgent agent;
+  std::unique_ptr<grpc::Server> server;
+  std::unique_ptr<ArmoniK::Sdk::DynamicWorker::DynamicWorker> worker;
+  std::mutex files_mutex;
+  std::vector<std::string> files;
+};
+
+/**
+ * @brief Services and concurrency observed by calls of the "concurrency" method of the test library
+ */
+struct Concurrency {
+  std::set<std::string> services;
+  int max_in_progress = 0;
+};
+
+/**
+ * @brief Processes tasks calling the "concurrency" method of a library, all at once
+ */
+Concurrency ProcessConcurrently(TestWorker &worker, const std::string &library_path, int task_count) {
+  std::vector<std::string> outputs(task_count);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < task_count; ++i) {
+    threads.emplace_back(
+        [&, i]() { outputs[i] = worker.Process(library_path, "concurrency", "task" + std::to_string(i)); });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  Concurrency concurrency;
+  for (auto &&output : outputs) {
+    std::istringstream fields(output);
+    std::string service;
+    int in_progress = 0;
+    EXPECT_TRUE(fields >> service >> in_progress) << output;
+    concurrency.services.insert(service);
+    concurrency.max_in_progress = std::max(concurrency.max_in_progress, in_progress);
+  }
+  return concurrency;
+}
+} // namespace
+
+TEST(DynamicWorker, ParallelismBoundsConcurrentTasks) {
+  TestWorker worker(2);
+  auto concurrency = ProcessConcurrently(worker, TEST_LIBRARY, 6);
+
+  EXPECT_EQ(concurrency.max_in_progress, 2);
+  // The library is not thread safe: each slot has its own service
+  EXPECT_EQ(concurrency.services.size(), 2u);
+}
+
+TEST(DynamicWorker, ThreadSafeLibrarySharesItsService) {
+  TestWorker worker(2);
+  auto concurrency = ProcessConcurrently(worker, THREAD_SAFE_TEST_LIBRARY, 6);
+
+  EXPECT_EQ(concurrency.max_in_progress, 2);
+  EXPECT_EQ(concurrency.services.size(), 1u);
+}
+
+TEST(DynamicWorker, ForwardsOutputIds) {
+  TestWorker worker(1);
+  auto output = worker.Process(TEST_LIBRARY, "echo", "task");
+
+  const std::string prefix = "armonik_call:";
+  ASSERT_EQ(output.compare(0, prefix.size(), prefix), 0) << output;
+  auto payload = ArmoniK::Sdk::Common::ConventionPayload::Deserialize(output.substr(prefix.size()));
+  EXPECT_EQ(payload.outputs, (std::map<std::string, std::string>{{"result", "task-result"}}));
+}
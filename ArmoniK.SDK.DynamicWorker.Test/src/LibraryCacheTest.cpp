@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include "LibraryCache.h"
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using ArmoniK::Sdk::DynamicWorker::LibraryCache;
+
+namespace {
+/**
+ * @brief Temporary directory, removed with its files on destruction
+ */
+class TempDirectory {
+public:
+  TempDirectory() {
+    char folder[] = "/tmp/armonik-library-cache-test-XXXXXX";
+    path = ::mkdtemp(folder);
+  }
+
+  ~TempDirectory() {
+    for (auto &&name : Files()) {
+      std::remove((path + "/" + name).c_str());
+    }
+    ::rmdir(path.c_str());
+  }
+
+  /**
+   * @brief Names of the files of the directory
+   */
+  std::set<std::string> Files() const {
+    std::set<std::string> names;
+    DIR *dir = ::opendir(path.c_str());
+    while (auto entry = ::readdir(dir)) {
+      std::string name = entry->d_name;
+      if (name != "." && name != "..") {
+        names.insert(name);
+      }
+    }
+    ::closedir(dir);
+    return names;
+  }
+
+  std::string path;
+};
+
+std::string ReadFile(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  std::ostringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+void WriteFile(const std::string &path, const std::string &content) {
+  std::ofstream(path, std::ios::binary) << content;
+}
+
+/**
+ * @brief Sets the modification time of a file to a number of seconds in the past
+ */
+void Age(const std::string &path, std::time_t seconds) {
+  const timespec times[2] = {{std::time(nullptr) - seconds, 0}, {std::time(nullptr) - seconds, 0}};
+  ASSERT_EQ(::utimensat(AT_FDCWD, path.c_str(), times, 0), 0) << path;
+}
+
+bool Exists(const std::string &path) {
+  struct stat st {};
+  return ::stat(path.c_str(), &st) == 0;
+}
+
+ino_t Inode(const std::string &path) {
+  struct stat st {};
+  ::stat(path.c_str(), &st);
+  return st.st_ino;
+}
+} // namespace
+
+TEST(LibraryCache, HitReusesTheCachedLibrary) {
+  TempDirectory directory;
+  LibraryCache cache(directory.path, 0);
+  const auto path = cache.Get("blob", "library");
+  EXPECT_EQ(ReadFile(path), "library");
+  const auto inode = Inode(path);
+
+  EXPECT_EQ(cache.Get("blob", "library"), path);
+  // Another process sharing the directory finds the library written by the first one
+  LibraryCache other(directory.path, 0);
+  EXPECT_EQ(other.Get("blob", "library"), path);
+  EXPECT_EQ(Inode(path), inode);
+  EXPECT_EQ(directory.Files().size(), 1u);
+}
+
+TEST(LibraryCache, ConcurrentWritersShareACompleteLibrary) {
+  TempDirectory directory;
+  const std::string content(1 << 20, 'x');
+  // One cache per thread, as if each thread were a worker process
+  std::vector<std::unique_ptr<LibraryCache>> caches;
+  std::vector<std::string> paths(8);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < paths.size(); ++i) {
+    caches.push_back(std::make_unique<LibraryCache>(directory.path, 0));
+    threads.emplace_back([&, i]() { paths[i] = caches[i]->Get("blob", content); });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  for (auto &&path : paths) {
+    EXPECT_EQ(path, paths.front());
+  }
+  EXPECT_EQ(ReadFile(paths.front()), content);
+  // No temporary file is left behind
+  EXPECT_EQ(directory.Files().size(), 1u);
+}
+
+TEST(LibraryCache, EvictsTheLeastRecentlyUsedLibraries) {
+  TempDirectory directory;
+  const std::string content(1000, 'x');
+  LibraryCache cache(directory.path, 2500);
+  const auto oldest = cache.Get("oldest", content);
+  const auto older = cache.Get("older", content);
+  EXPECT_TRUE(Exists(oldest));
+  // Libraries used within the grace period are never evicted
+  Age(oldest, 3600);
+  Age(older, 1800);
+
+  const auto newest = cache.Get("newest", content);
+  EXPECT_FALSE(Exists(oldest));
+  EXPECT_TRUE(Exists(older));
+  EXPECT_TRUE(Exists(newest));
+}
+
+TEST(LibraryCache, KeepsLibrariesUnderTheLimit) {
+  TempDirectory directory;
+  const std::string content(1000, 'x');
+  LibraryCache cache(directory.path, 3000);
+  const auto first = cache.Get("first", content);
+  const auto second = cache.Get("second", content);
+  Age(first, 3600);
+  Age(second, 3600);
+
+  const auto third = cache.Get("third", content);
+  EXPECT_TRUE(Exists(first));
+  EXPECT_TRUE(Exists(second));
+  EXPECT_TRUE(Exists(third));
+}
+
+TEST(LibraryCache, RemovesStaleTemporaryFiles) {
+  TempDirectory directory;
+  const auto stale = directory.path + "/armonik-lib-blob-0123456789abcdef.so.42.0.tmp";
+  const auto in_progress = directory.path + "/armonik-lib-blob-0123456789abcdef.so.43.0.tmp";
+  WriteFile(stale, "partial");
+  WriteFile(in_progress, "partial");
+  Age(stale, 3600);
+
+  LibraryCache cache(directory.path, 0);
+  EXPECT_FALSE(Exists(stale));
+  // Another process may still be writing a recent temporary file
+  EXPECT_TRUE(Exists(in_progress));
+
+  WriteFile(stale, "partial");
+  Age(stale, 3600);
+  cache.Get("other", "library");
+  EXPECT_FALSE(Exists(stale));
+}
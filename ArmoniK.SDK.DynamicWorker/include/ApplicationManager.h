@@ -2,13 +2,19 @@
 
 #include "ContextIds.h"
 #include "DynamicLib.h"
+#include "LibraryRegistry.h"
 #include "ServiceManager.h"
 #include <Worker/ProcessStatus.h>
+#include <absl/strings/string_view.h>
 #include <armonik/common/logger/logger.h>
 #include <armonik/sdk/common/DynamicLibrary.h>
 #include <armonik/worker/Worker/TaskHandler.h>
+#include <cstddef>
+#include <list>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace ArmoniK {
 namespace Sdk {
@@ -23,6 +29,12 @@ namespace Sdk {
 namespace DynamicWorker {
 /**
  * @brief Application manager to load and unload applications
+ *
+ * @details
+ * Up to Worker__MaxLoadedServices services (4 by default) are kept alive, each one with up to
+ * Worker__MaxSessionsPerService entered sessions (4 by default), so that interleaved tasks of different applications,
+ * services or sessions do not reload libraries or recreate contexts. The least recently used service is destroyed
+ * when another one has to be created, and its library is unloaded once no service uses it anymore.
  */
 class ApplicationManager {
 
@@ -30,16 +42,19 @@ public:
   /**
    * @brief Creates an application manager
    * @param config Configuration
+   * @param logger Logger
+   * @param registry Registry of the loaded libraries, shared with the other managers of the process. A private one is
+   * created if null
    */
   explicit ApplicationManager(const ArmoniK::Sdk::Common::Configuration &config,
-                              const armonik::api::common::logger::Logger &logger);
+                              const armonik::api::common::logger::Logger &logger,
+                              std::shared_ptr<LibraryRegistry> registry = nullptr);
 
   /**
    * @brief Configures the application manager to use the given application
    * @param appId Application Id
    * @return this ApplicationHandler
-   * @note If the appId is different to the current one, the currently loaded service will be destroyed and the
-   * application will be unloaded before loading the new one
+   * @note The services of the previous application are kept, and destroyed only when evicted from the pool
    * @note If the appId is identical to the current one, this call does nothing
    */
   ApplicationManager &UseApplication(const AppId &appId) &;
@@ -52,7 +67,7 @@ public:
    * @param service_namespace Namespace passed to armonik_create_service (empty for single-service workers)
    * @param service_name Name passed to armonik_create_service (empty for single-service workers)
    * @return this ApplicationManager
-   * @note Caches by library_path + service_name; a repeated call with the same values is a no-op.
+   * @note The service is kept in the pool: a repeated call with the same values does not reload the library.
    */
   ApplicationManager &UseLibrary(const ArmoniK::Sdk::Common::DynamicLibrary &lib,
                                  const std::string &service_namespace = "", const std::string &service_name = "") &;
@@ -61,9 +76,8 @@ public:
    * @brief Configures the application manager to use the given service
    * @param serviceId Service id
    * @return this Application manager
-   * @note If the current service matches the requested service id, then this does nothing
-   * @note If the current service is different from the requested service, then this will destroy the current service
-   * before creating the new one
+   * @note If the requested service is in the pool, it becomes the current one. Otherwise it is created from the current
+   * application, and the least recently used service is destroyed if the pool is full
    */
   ApplicationManager &UseService(const ServiceId &serviceId) &;
 
@@ -83,7 +97,7 @@ public:
    * @return ProcessStatus telling whether the call was successful or not
    */
   armonik::api::worker::ProcessStatus Execute(armonik::api::worker::TaskHandler &taskHandler,
-                                              const std::string &method_name, const std::string &method_arguments);
+                                              const std::string &method_name, absl::string_view method_arguments);
 
   /**
    * @brief Executes the task given by the task handler using named blob maps (convention mode).
@@ -99,6 +113,21 @@ public:
                                               const std::map<std::string, std::string> &inputs,
                                               const std::map<std::string, std::string> &outputs);
 
+  /**
+   * @brief Executes the task given by the task handler using views on the named inputs (convention mode).
+   * The inputs are passed without copy through armonik_call_inputs() when the library exports it, otherwise they are
+   * copied and serialized to JSON as in Execute(taskHandler, method_name, inputs, outputs).
+   * @param taskHandler Task handler
+   * @param method_name Name of the method to execute
+   * @param inputs Named inputs, pointing to memory that outlives the call
+   * @param outputs Named output blob IDs
+   * @return ProcessStatus telling whether the call was successful or not
+   */
+  armonik::api::worker::ProcessStatus Execute(armonik::api::worker::TaskHandler &taskHandler,
+                                              const std::string &method_name,
+                                              const std::vector<armonik_input_t> &inputs,
+                                              const std::map<std::string, std::string> &outputs);
+
 private:
   /**
    * @brief Loaded application's function pointers
@@ -110,34 +139,79 @@ private:
   AppId currentId;
 
   /**
-   * @brief Current service manager
+   * @brief Registry of the loaded libraries
    */
-  ServiceManager service_manager;
+  std::shared_ptr<LibraryRegistry> registry;
 
   /**
    * @brief Currently loaded library
+   * @note Declared before the service manager so that the library outlives the service
    */
-  DynamicLib currentLibrary;
+  std::shared_ptr<DynamicLib> currentLibrary;
 
   /**
-   * @brief Base path in which to look for the library to load (legacy mode)
+   * @brief Whether the current library declared its services thread safe
    */
-  std::string applicationsBasePath;
+  bool currentLibraryThreadSafe = false;
+
+  /**
+   * @brief Live services, the current one first
+   */
+  std::list<ServiceManager> services;
 
   /**
-   * @brief Path of the currently loaded library (convention mode); empty when in legacy mode
+   * @brief Maximum number of live services
    */
-  std::string currentLibraryPath;
+  std::size_t max_services = 4;
 
   /**
-   * @brief Service name used when the current library was loaded (convention mode)
+   * @brief Maximum number of entered sessions per service
+   */
+  std::size_t max_sessions = 4;
+
+  /**
+   * @brief Base path in which to look for the library to load (legacy mode)
    */
-  std::string currentLibraryServiceName;
+  std::string applicationsBasePath;
 
   /**
    * @brief Local Logger
    */
   armonik::api::common::logger::LocalLogger logger;
+
+  /**
+   * @brief Loads a library through the registry and resolves its symbols
+   * @param path Path to the library
+   */
+  void LoadLibrary(const std::string &path);
+
+  /**
+   * @brief Makes the given service the current one if it is in the pool
+   * @param serviceId Service id
+   * @return true if the service was found
+   */
+  bool SelectService(const ServiceId &serviceId);
+
+  /**
+   * @brief Adds a service of the current library to the pool as the current one, evicting the least recently used
+   * service if needed
+   * @param serviceId Service id
+   */
+  void AddService(const ServiceId &serviceId);
+
+  /**
+   * @brief Gets the current service
+   * @return Current service manager
+   * @throws ArmoniKSdkException if no service is in use
+   */
+  ServiceManager &CurrentService();
+
+  /**
+   * @brief Creates the manager of a service of the current library
+   * @param serviceId Service id
+   * @return Service manager, sharing its service context with the other slots if the library is thread safe
+   */
+  ServiceManager CreateServiceManager(const ServiceId &serviceId);
 };
 } // namespace DynamicWorker
 } // namespace Sdk
@@ -147,6 +147,11 @@ struct ArmoniKFunctionPointers {
    * @brief Function to call a method. See armonik_call()
    */
   armonik_call_t call;
+  /**
+   * @brief Function to call a method with input views. See armonik_call_inputs()
+   * @note Optional, nullptr if the library does not export it
+   */
+  armonik_call_inputs_t call_inputs;
 
   /**
    * @brief Clears the function pointers
@@ -157,6 +162,7 @@ struct ArmoniKFunctionPointers {
     enter_session = nullptr;
     leave_session = nullptr;
     call = nullptr;
+    call_inputs = nullptr;
   }
 };
 } // namespace DynamicWorker
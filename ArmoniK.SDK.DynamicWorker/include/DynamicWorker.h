@@ -1,15 +1,29 @@
 #pragma once
 
 #include "ApplicationManager.h"
+#include "LibraryCache.h"
+#include "LibraryRegistry.h"
 #include <armonik/common/logger/local_logger.h>
 #include <armonik/sdk/common/Configuration.h>
 #include <armonik/worker/Worker/ArmoniKWorker.h>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace ArmoniK {
 namespace Sdk {
 namespace DynamicWorker {
 /**
  * @brief ArmoniK Worker that loads a dynamic library and executes method within it
+ *
+ * @details
+ * The worker owns Worker__Parallelism execution slots (1 by default). Each slot has its own ApplicationManager, and
+ * thus its own service and session contexts, so that up to that many tasks can be executed concurrently by a single
+ * process. Loaded libraries are shared by all the slots.
+ *
+ * Libraries uploaded as blobs are stored in a LibraryCache, configured by Worker__LibraryCacheDirectory (/tmp by
+ * default) and Worker__LibraryCacheMaxSize (in bytes, 4 GiB by default, 0 for no limit).
  */
 class DynamicWorker : public armonik::api::worker::ArmoniKWorker {
 public:
@@ -30,15 +44,49 @@ public:
   armonik::api::worker::ProcessStatus Execute(armonik::api::worker::TaskHandler &taskHandler) override;
 
 private:
+  /**
+   * @brief Executes the task given by the task handler in the given slot
+   * @param taskHandler Task handler
+   * @param manager Application manager of the slot
+   * @return Whether the task executed successfully or not
+   */
+  armonik::api::worker::ProcessStatus Execute(armonik::api::worker::TaskHandler &taskHandler,
+                                              ApplicationManager &manager);
+
   /**
    * @brief Local logger
    */
   armonik::api::common::logger::LocalLogger logger;
 
   /**
-   * @brief Application manager
+   * @brief Libraries shared by the slots
+   */
+  std::shared_ptr<LibraryRegistry> registry;
+
+  /**
+   * @brief Application managers of the execution slots
+   */
+  std::vector<std::unique_ptr<ApplicationManager>> slots;
+
+  /**
+   * @brief Slots not currently executing a task
+   */
+  std::vector<ApplicationManager *> free_slots;
+
+  /**
+   * @brief Mutex protecting the free slots
+   */
+  std::mutex slots_mutex;
+
+  /**
+   * @brief Notified when a slot is released
+   */
+  std::condition_variable slot_released;
+
+  /**
+   * @brief On-disk cache of the libraries uploaded as blobs
    */
-  ArmoniK::Sdk::DynamicWorker::ApplicationManager manager;
+  LibraryCache library_cache;
 };
 } // namespace DynamicWorker
 } // namespace Sdk
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <absl/strings/string_view.h>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace ArmoniK {
+namespace Sdk {
+namespace DynamicWorker {
+/**
+ * @brief On-disk cache of the libraries uploaded as blobs
+ *
+ * @details
+ * Libraries are stored as <directory>/armonik-lib-<blob id>-<content hash>.so. A library already present on disk is
+ * neither rewritten nor reloaded, so the cost of an upload is paid once per node and not once per task. The directory
+ * can be shared by several worker processes: files are written to a private temporary file then renamed, so that a
+ * cached library is always complete.
+ *
+ * The total size of the cached libraries is bounded. When it is exceeded, the least recently used libraries are
+ * removed, based on their modification time, which is refreshed on every use. Recently used libraries are never
+ * removed, as another process may be about to load them. Temporary files left by a process that failed while writing
+ * a library are removed as well, when the cache is created and after each write.
+ */
+class LibraryCache {
+public:
+  /**
+   * @brief Creates a library cache
+   * @param directory Directory of the cache
+   * @param max_size Maximum total size of the cached libraries in bytes, 0 for no limit
+   */
+  LibraryCache(std::string directory, std::uintmax_t max_size);
+
+  /**
+   * @brief Gets the path of a library, writing it to the cache if needed
+   * @param blob_id Id of the blob containing the library
+   * @param content Content of the library
+   * @return Path to the cached library
+   * @throws ArmoniKSdkException if the library cannot be written
+   */
+  std::string Get(const std::string &blob_id, absl::string_view content);
+
+private:
+  /**
+   * @brief Removes the stale temporary files, then the least recently used libraries until the cache fits its maximum
+   * size
+   * @param keep Path of a library that must not be removed
+   */
+  void Evict(const std::string &keep);
+
+  /**
+   * @brief Directory of the cache
+   */
+  std::string directory;
+
+  /**
+   * @brief Maximum total size of the cached libraries, 0 for no limit
+   */
+  std::uintmax_t max_size;
+
+  /**
+   * @brief Mutex protecting the cache
+   */
+  std::mutex mutex;
+
+  /**
+   * @brief Path of the libraries already cached by this process, by blob id
+   */
+  std::map<std::string, std::string> paths;
+};
+} // namespace DynamicWorker
+} // namespace Sdk
+} // namespace ArmoniK
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "DynamicLib.h"
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace ArmoniK {
+namespace Sdk {
+namespace DynamicWorker {
+/**
+ * @brief Registry of the libraries and shared service contexts of a worker process
+ *
+ * Shared between the execution slots of the DynamicWorker so that a library is only loaded once, whatever the number
+ * of slots using it. Entries are weak: a library is unloaded as soon as no slot uses it anymore.
+ */
+class LibraryRegistry {
+public:
+  /**
+   * @brief Loads a library, or returns the already loaded one
+   * @param path Path to the library
+   * @return Loaded library
+   */
+  std::shared_ptr<DynamicLib> Load(const std::string &path);
+
+  /**
+   * @brief Gets a service context shared by all the slots, creating it if needed
+   * @param library Library of the service
+   * @param service_namespace Namespace of the service
+   * @param service_name Name of the service
+   * @param create Function creating the service context, called only if no slot currently uses it
+   * @return Shared service context
+   */
+  std::shared_ptr<void> SharedService(const DynamicLib *library, const std::string &service_namespace,
+                                      const std::string &service_name,
+                                      const std::function<std::shared_ptr<void>()> &create);
+
+private:
+  /**
+   * @brief Mutex protecting the registry
+   */
+  std::mutex mutex;
+
+  /**
+   * @brief Loaded libraries, by path
+   */
+  std::map<std::string, std::weak_ptr<DynamicLib>> libraries;
+
+  /**
+   * @brief Shared service contexts, by library, namespace and name
+   */
+  std::map<std::tuple<const DynamicLib *, std::string, std::string>, std::weak_ptr<void>> services;
+};
+} // namespace DynamicWorker
+} // namespace Sdk
+} // namespace ArmoniK
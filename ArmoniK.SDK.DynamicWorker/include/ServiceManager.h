@@ -1,14 +1,25 @@
 #pragma once
 
 #include "ContextIds.h"
+#include <absl/strings/string_view.h>
 #include <armonik/worker/Worker/ProcessStatus.h>
 #include <armonik/worker/Worker/TaskHandler.h>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace ArmoniK {
 namespace Sdk {
 namespace DynamicWorker {
 /**
  * @brief Manager of service for ArmoniK Worker
+ *
+ * @details
+ * The manager keeps up to max_sessions session contexts entered, so that tasks of interleaved sessions do not leave
+ * and enter their sessions every time. The least recently used session is left when another one has to be entered.
  */
 class ServiceManager {
 public:
@@ -20,8 +31,19 @@ public:
    * @brief Manager for the given service
    * @param functionsPointers Dynamic library function pointers
    * @param serviceId Service Id
+   * @param max_sessions Maximum number of sessions kept entered at the same time
    */
-  ServiceManager(ArmoniKFunctionPointers functionsPointers, ServiceId serviceId);
+  ServiceManager(ArmoniKFunctionPointers functionsPointers, ServiceId serviceId, std::size_t max_sessions = 1);
+  /**
+   * @brief Manager for the given service, using an already created service context
+   * @param functionsPointers Dynamic library function pointers
+   * @param serviceId Service Id
+   * @param service Service context, destroyed when its last owner releases it
+   * @param max_sessions Maximum number of sessions kept entered at the same time
+   * @note Used to share a service context between the execution slots of thread-safe libraries
+   */
+  ServiceManager(ArmoniKFunctionPointers functionsPointers, ServiceId serviceId, std::shared_ptr<void> service,
+                 std::size_t max_sessions = 1);
   ~ServiceManager();
 
   ServiceManager(const ServiceManager &) = delete;
@@ -32,11 +54,11 @@ public:
    * @param other Other ServiceManager
    */
   ServiceManager(ServiceManager &&other) noexcept
-      : serviceId(std::move(other.serviceId)), current_session(std::move(other.current_session)),
-        service_context(other.service_context), session_context(other.session_context),
+      : serviceId(std::move(other.serviceId)), sessions(std::move(other.sessions)), max_sessions(other.max_sessions),
+        service(std::move(other.service)), service_context(other.service_context),
         functionPointers(other.functionPointers) {
     other.service_context = nullptr;
-    other.session_context = nullptr;
+    other.sessions.clear();
     other.serviceId.clear();
   }
 
@@ -48,9 +70,10 @@ public:
   ServiceManager &operator=(ServiceManager &&other) noexcept {
     using std::swap;
     swap(serviceId, other.serviceId);
-    swap(current_session, other.current_session);
+    swap(sessions, other.sessions);
+    swap(max_sessions, other.max_sessions);
+    swap(service, other.service);
     swap(service_context, other.service_context);
-    swap(session_context, other.session_context);
     swap(functionPointers, other.functionPointers);
     return *this;
   }
@@ -59,8 +82,8 @@ public:
    * @brief Configure the service to use the given session
    * @param sessionId Session id
    * @return the service manager itself
-   * If a different session is in use in the service, it will leave the session before entering the new one.
-   * If the current session is the same as the requested session, this call does nothing.
+   * If the session is already entered, it becomes the current one without calling the library.
+   * Otherwise it is entered, after leaving the least recently used session if max_sessions are already entered.
    */
   ServiceManager &UseSession(const std::string &sessionId) &;
 
@@ -72,7 +95,27 @@ public:
    * @return Task execution status
    */
   armonik::api::worker::ProcessStatus Execute(armonik::api::worker::TaskHandler &taskHandler,
-                                              const std::string &method_name, const std::string &method_arguments);
+                                              const std::string &method_name, absl::string_view method_arguments);
+
+  /**
+   * @brief Executes a method from the current service, in the current session, with views on its named inputs
+   * @param taskHandler ArmoniK task handler
+   * @param method_name Name of the method to call
+   * @param inputs Named inputs, pointing to memory that outlives the call
+   * @param outputs Named output blob IDs, pointing to memory that outlives the call
+   * @return Task execution status
+   * @note Requires the library to export armonik_call_inputs(), see supports_input_views()
+   */
+  armonik::api::worker::ProcessStatus Execute(armonik::api::worker::TaskHandler &taskHandler,
+                                              const std::string &method_name,
+                                              const std::vector<armonik_input_t> &inputs,
+                                              const std::vector<armonik_input_t> &outputs);
+
+  /**
+   * @brief Checks if the current service can be called with input views
+   * @return true if the library exports armonik_call_inputs()
+   */
+  bool supports_input_views() const noexcept { return functionPointers.call_inputs != nullptr; }
 
   /**
    * @brief Checks if the current service matches the given service id
@@ -92,17 +135,21 @@ private:
    */
   ServiceId serviceId;
   /**
-   * @brief Current session id
+   * @brief Entered sessions, as (session id, session context), the current one first
    */
-  std::string current_session;
+  std::list<std::pair<std::string, void *>> sessions;
   /**
-   * @brief Current service context
+   * @brief Maximum number of entered sessions
    */
-  void *service_context{};
+  std::size_t max_sessions = 1;
   /**
-   * @brief Current session context
+   * @brief Owner of the service context, possibly shared with other managers
+   */
+  std::shared_ptr<void> service;
+  /**
+   * @brief Current service context
    */
-  void *session_context{};
+  void *service_context{};
   /**
    * @brief Library function pointers
    */
@@ -116,6 +163,15 @@ private:
    * @param data_size Output size
    */
   static void UploadResult(void *opaque_context, armonik_status_t status, const char *data, size_t data_size);
+
+  /**
+   * @brief Calls a library entry point and converts its outcome into a ProcessStatus
+   * @param taskHandler ArmoniK task handler
+   * @param call Function calling the library with the ArmoniK context
+   * @return Task execution status
+   */
+  template <class Call>
+  armonik::api::worker::ProcessStatus Invoke(armonik::api::worker::TaskHandler &taskHandler, Call &&call);
 };
 } // namespace DynamicWorker
 } // namespace Sdk
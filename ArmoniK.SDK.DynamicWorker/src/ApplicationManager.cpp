@@ -3,6 +3,7 @@
 #include <armonik/sdk/common/Configuration.h>
 #include <armonik/sdk/common/TaskPayload.h>
 #include <armonik/sdk/common/internal/ConventionPayload.h>
+#include <algorithm>
 #include <sstream>
 
 namespace ArmoniK {
@@ -13,36 +14,28 @@ ApplicationManager &ApplicationManager::UseApplication(const AppId &appId) & {
   if (appId == currentId) {
     return *this;
   }
-  service_manager.clear();
-  currentLibraryPath.clear();
   std::string filename(applicationsBasePath + '/' + appId.application_name +
                        (appId.application_version.empty() ? "" : "." + appId.application_version));
-  currentLibrary = DynamicLib(filename.c_str());
-
-  functionPointers = ArmoniKFunctionPointers{currentLibrary.get<armonik_create_service_t>("armonik_create_service"),
-                                             currentLibrary.get<armonik_destroy_service_t>("armonik_destroy_service"),
-                                             currentLibrary.get<armonik_enter_session_t>("armonik_enter_session"),
-                                             currentLibrary.get<armonik_leave_session_t>("armonik_leave_session"),
-                                             currentLibrary.get<armonik_call_t>("armonik_call")};
+  LoadLibrary(filename);
   currentId = appId;
   logger.info("Successfully loaded application " + appId.application_name + " ( " + appId.application_version + " )");
   return *this;
 }
 ApplicationManager &ApplicationManager::UseService(const ServiceId &serviceId) & {
-  if (!service_manager.matches(serviceId)) {
-    service_manager = ServiceManager(functionPointers, serviceId);
+  if (!SelectService(serviceId)) {
+    AddService(serviceId);
   }
 
   return *this;
 }
 ApplicationManager &ApplicationManager::UseSession(const std::string &sessionId) & {
-  service_manager.UseSession(sessionId);
+  CurrentService().UseSession(sessionId);
   return *this;
 }
 armonik::api::worker::ProcessStatus ApplicationManager::Execute(armonik::api::worker::TaskHandler &taskHandler,
                                                                 const std::string &method_name,
-                                                                const std::string &method_arguments) {
-  return service_manager.Execute(taskHandler, method_name, method_arguments);
+                                                                absl::string_view method_arguments) {
+  return CurrentService().Execute(taskHandler, method_name, method_arguments);
 }
 
 armonik::api::worker::ProcessStatus ApplicationManager::Execute(armonik::api::worker::TaskHandler &taskHandler,
@@ -56,38 +49,113 @@ armonik::api::worker::ProcessStatus ApplicationManager::Execute(armonik::api::wo
   return Execute(taskHandler, method_name, payload.Serialize());
 }
 
+armonik::api::worker::ProcessStatus ApplicationManager::Execute(armonik::api::worker::TaskHandler &taskHandler,
+                                                                const std::string &method_name,
+                                                                const std::vector<armonik_input_t> &inputs,
+                                                                const std::map<std::string, std::string> &outputs) {
+  if (CurrentService().supports_input_views()) {
+    std::vector<armonik_input_t> output_ids;
+    output_ids.reserve(outputs.size());
+    for (auto &&output : outputs) {
+      output_ids.push_back({output.first.c_str(), output.second.data(), output.second.size()});
+    }
+    return CurrentService().Execute(taskHandler, method_name, inputs, output_ids);
+  }
+
+  // Library built against an older SDK: fall back to the JSON payload
+  std::map<std::string, std::string> copied_inputs;
+  for (auto &&input : inputs) {
+    copied_inputs.emplace(input.name, std::string(input.data, input.data_size));
+  }
+  return Execute(taskHandler, method_name, copied_inputs, outputs);
+}
+
 ApplicationManager &ApplicationManager::UseLibrary(const ArmoniK::Sdk::Common::DynamicLibrary &lib,
                                                    const std::string &service_namespace,
                                                    const std::string &service_name) & {
-  if (lib.library_path == currentLibraryPath && service_name == currentLibraryServiceName) {
+  ServiceId serviceId({lib.library_path, ""}, service_namespace, service_name);
+  if (SelectService(serviceId)) {
     return *this;
   }
-  service_manager.clear();
   currentId.clear();
-  currentLibrary = DynamicLib(lib.library_path.c_str());
-
-  const std::string prefix = "armonik";
-  functionPointers =
-      ArmoniKFunctionPointers{currentLibrary.get<armonik_create_service_t>((prefix + "_create_service").c_str()),
-                              currentLibrary.get<armonik_destroy_service_t>((prefix + "_destroy_service").c_str()),
-                              currentLibrary.get<armonik_enter_session_t>((prefix + "_enter_session").c_str()),
-                              currentLibrary.get<armonik_leave_session_t>((prefix + "_leave_session").c_str()),
-                              currentLibrary.get<armonik_call_t>((prefix + "_call").c_str())};
-
-  currentLibraryPath = lib.library_path;
-  currentLibraryServiceName = service_name;
-  service_manager =
-      ServiceManager(functionPointers, ServiceId({lib.library_path, ""}, service_namespace, service_name));
+  LoadLibrary(lib.library_path);
+  AddService(serviceId);
   logger.info("Successfully loaded library " + lib.library_path);
   return *this;
 }
+bool ApplicationManager::SelectService(const ServiceId &serviceId) {
+  for (auto it = services.begin(); it != services.end(); ++it) {
+    if (it->matches(serviceId)) {
+      services.splice(services.begin(), services, it);
+      return true;
+    }
+  }
+  return false;
+}
+void ApplicationManager::AddService(const ServiceId &serviceId) {
+  if (services.size() >= max_services) {
+    // Leaves its sessions and destroys its context, then unloads its library if no other service uses it
+    services.pop_back();
+  }
+  services.push_front(CreateServiceManager(serviceId));
+}
+ServiceManager &ApplicationManager::CurrentService() {
+  if (services.empty()) {
+    throw ArmoniK::Sdk::Common::ArmoniKSdkException("No service is in use");
+  }
+  return services.front();
+}
+void ApplicationManager::LoadLibrary(const std::string &path) {
+  currentLibrary = registry->Load(path);
+
+  functionPointers = ArmoniKFunctionPointers{currentLibrary->get<armonik_create_service_t>("armonik_create_service"),
+                                             currentLibrary->get<armonik_destroy_service_t>("armonik_destroy_service"),
+                                             currentLibrary->get<armonik_enter_session_t>("armonik_enter_session"),
+                                             currentLibrary->get<armonik_leave_session_t>("armonik_leave_session"),
+                                             currentLibrary->get<armonik_call_t>("armonik_call"),
+                                             currentLibrary->try_get<armonik_call_inputs_t>("armonik_call_inputs")};
+
+  auto thread_safe = currentLibrary->try_get<armonik_thread_safe_t>("armonik_thread_safe");
+  currentLibraryThreadSafe = thread_safe && thread_safe() != 0;
+}
+
+ServiceManager ApplicationManager::CreateServiceManager(const ServiceId &serviceId) {
+  // The service context keeps the library loaded until it is destroyed
+  auto library = currentLibrary;
+  auto pointers = functionPointers;
+  auto create = [library, pointers, &serviceId]() {
+    auto context = pointers.create_service(serviceId.service_namespace.c_str(), serviceId.service_name.c_str());
+    return std::shared_ptr<void>(context, [library, pointers](void *ctx) { pointers.destroy_service(ctx); });
+  };
+
+  if (currentLibraryThreadSafe) {
+    return ServiceManager(functionPointers, serviceId,
+                          registry->SharedService(currentLibrary.get(), serviceId.service_namespace,
+                                                  serviceId.service_name, create),
+                          max_sessions);
+  }
+  return ServiceManager(functionPointers, serviceId, create(), max_sessions);
+}
+
 ApplicationManager::ApplicationManager(const ArmoniK::Sdk::Common::Configuration &config,
-                                       const armonik::api::common::logger::Logger &logger)
-    : functionPointers(), logger(logger.local()) {
+                                       const armonik::api::common::logger::Logger &logger,
+                                       std::shared_ptr<LibraryRegistry> registry)
+    : functionPointers(),
+      registry(registry ? std::move(registry) : std::make_shared<LibraryRegistry>()), logger(logger.local()) {
   applicationsBasePath = config.get("Worker__ApplicationBasePath");
   if (applicationsBasePath.empty()) {
     applicationsBasePath = "/data";
   }
+  try {
+    max_services = std::max(std::stoul(config.get("Worker__MaxLoadedServices")), 1UL);
+  } catch (...) {
+    // Ignore invalid value and keep default
+  }
+  try {
+    max_sessions = std::max(std::stoul(config.get("Worker__MaxSessionsPerService")), 1UL);
+  } catch (...) {
+    // Ignore invalid value and keep default
+  }
 }
 } // namespace DynamicWorker
 } // namespace Sdk
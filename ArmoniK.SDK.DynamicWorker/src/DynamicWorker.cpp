@@ -5,30 +5,92 @@
 #include <armonik/sdk/common/TaskOptions.h>
 #include <armonik/sdk/common/TaskPayload.h>
 #include <armonik/sdk/common/internal/ConventionPayload.h>
+#include <algorithm>
+#include <cstdint>
 #include <exception>
-#include <fstream>
+#include <string>
 
 namespace ArmoniK {
 namespace Sdk {
 namespace DynamicWorker {
 
+namespace {
+std::string LibraryCacheDirectory(const ArmoniK::Sdk::Common::Configuration &config) {
+  auto directory = config.get("Worker__LibraryCacheDirectory");
+  return directory.empty() ? "/tmp" : directory;
+}
+
+std::uintmax_t LibraryCacheMaxSize(const ArmoniK::Sdk::Common::Configuration &config) {
+  // 4 GiB by default
+  std::uintmax_t max_size = 4ULL << 30;
+  try {
+    max_size = std::stoull(config.get("Worker__LibraryCacheMaxSize"));
+  } catch (...) {
+    // Ignore invalid value and keep default
+  }
+  return max_size;
+}
+} // namespace
+
 DynamicWorker::DynamicWorker(std::unique_ptr<armonik::api::grpc::v1::agent::Agent::Stub> agent,
                              const ArmoniK::Sdk::Common::Configuration &config,
                              const armonik::api::common::logger::Logger &logger)
     : ArmoniKWorker(std::move(agent)), logger(logger.local({{"WorkerName", "DynamicWorker"}})),
-      manager(config, logger) {}
+      registry(std::make_shared<LibraryRegistry>()),
+      library_cache(LibraryCacheDirectory(config), LibraryCacheMaxSize(config)) {
+  int parallelism = 1;
+  try {
+    parallelism = std::max(std::stoi(config.get("Worker__Parallelism")), 1);
+  } catch (...) {
+    // Ignore invalid value and keep default
+  }
+
+  slots.reserve(parallelism);
+  free_slots.reserve(parallelism);
+  for (int i = 0; i < parallelism; ++i) {
+    slots.push_back(std::make_unique<ApplicationManager>(config, logger, registry));
+    free_slots.push_back(slots.back().get());
+  }
+  this->logger.info("DynamicWorker started", {{"parallelism", std::to_string(parallelism)}});
+}
 
 armonik::api::worker::ProcessStatus DynamicWorker::Execute(armonik::api::worker::TaskHandler &taskHandler) {
+  ApplicationManager *manager;
+  {
+    std::unique_lock<std::mutex> lock(slots_mutex);
+    slot_released.wait(lock, [this]() { return !free_slots.empty(); });
+    manager = free_slots.back();
+    free_slots.pop_back();
+  }
+  auto release = [&]() {
+    {
+      std::lock_guard<std::mutex> _(slots_mutex);
+      free_slots.push_back(manager);
+    }
+    slot_released.notify_one();
+  };
+
+  try {
+    auto status = Execute(taskHandler, *manager);
+    release();
+    return status;
+  } catch (...) {
+    // Retryable errors are thrown to the API, the slot must still be released
+    release();
+    throw;
+  }
+}
+
+armonik::api::worker::ProcessStatus DynamicWorker::Execute(armonik::api::worker::TaskHandler &taskHandler,
+                                                           ApplicationManager &manager) {
   try {
     const auto &rawOptions = taskHandler.getTaskOptions();
 
     // Convention path: ConventionVersion key present in task options
     if (rawOptions.options().count(ArmoniK::Sdk::Common::DynamicLibrary::KeyConventionVersion)) {
       ArmoniK::Sdk::Common::TaskOptions opts(rawOptions);
-      const auto version = opts.GetConventionVersion();
-      if (version != ArmoniK::Sdk::Common::DynamicLibrary::ConventionVersion) {
-        throw ArmoniK::Sdk::Common::ArmoniKSdkException("Unsupported convention version: " + version);
-      }
+      // Throws for unsupported versions; the payload encoding itself is detected from its content
+      ArmoniK::Sdk::Common::ConventionPayload::EncodingFromVersion(opts.GetConventionVersion());
       auto lib = opts.GetDynamicLibrary();
       const auto &deps = taskHandler.getDataDependencies();
 
@@ -41,49 +103,65 @@ armonik::api::worker::ProcessStatus DynamicWorker::Execute(armonik::api::worker:
           throw ArmoniK::Sdk::Common::ArmoniKSdkException("Library blob '" + lib.library_blob_id +
                                                           "' not found in data dependencies");
         }
-        // Write to a deterministic temp path so identical blobs are only written once per worker process
-        lib.library_path = "/tmp/armonik-lib-" + lib.library_blob_id + ".so";
-        std::ofstream tmp(lib.library_path, std::ios::binary | std::ios::trunc);
-        if (!tmp) {
-          throw ArmoniK::Sdk::Common::ArmoniKSdkException("Failed to write library to temp file: " + lib.library_path);
-        }
-        tmp.write(blob_it->second.data(), static_cast<std::streamsize>(blob_it->second.size()));
+        // The cached path is stable for a given blob, so a library already loaded is not reloaded either
+        lib.library_path = library_cache.Get(lib.library_blob_id, blob_it->second);
       }
 
-      const auto payload = ArmoniK::Sdk::Common::ConventionPayload::Deserialize(taskHandler.getPayload());
-
       if (lib.symbol.empty()) {
         throw ArmoniK::Sdk::Common::ArmoniKSdkException(
             "Convention task has no method name: set the 'Symbol' task option");
       }
       const std::string &method_name = lib.symbol;
 
-      // Resolve inputs: if a value matches a data dependency key (blob ID), substitute its downloaded content.
+      // Resolve inputs: if a value matches a data dependency key (blob ID), point to its downloaded content.
       // This handles both inline values (C++ native payloads) and blob ID references (cross-SDK interoperability).
-      std::map<std::string, std::string> resolved_inputs;
-      for (const auto &pair : payload.inputs) {
-        const std::string &name = pair.first;
-        const std::string &value = pair.second;
-        const auto dep_it = deps.find(value);
-        resolved_inputs[name] = (dep_it != deps.end()) ? dep_it->second : value;
+      // The views refer to the task handler's buffers and to the payload, which both outlive the call.
+      // Names are null terminated in both encodings.
+      std::vector<armonik_input_t> resolved_inputs;
+      std::map<std::string, std::string> outputs;
+      auto resolve = [&](absl::string_view name, absl::string_view value) {
+        const auto dep_it = deps.find(std::string(value));
+        if (dep_it != deps.end()) {
+          value = dep_it->second;
+        }
+        resolved_inputs.push_back({name.data(), value.data(), value.size()});
+      };
+
+      const auto &raw_payload = taskHandler.getPayload();
+      ArmoniK::Sdk::Common::ConventionPayload payload;
+      if (ArmoniK::Sdk::Common::ConventionPayload::IsBinary(raw_payload)) {
+        // Binary payload: decoded in place, without building the input maps
+        const auto view = ArmoniK::Sdk::Common::ConventionPayloadView::Parse(raw_payload);
+        resolved_inputs.reserve(view.inputs.size());
+        for (auto &&entry : view.inputs) {
+          resolve(entry.first, entry.second);
+        }
+        for (auto &&entry : view.outputs) {
+          outputs.emplace(std::string(entry.first), std::string(entry.second));
+        }
+      } else {
+        payload = ArmoniK::Sdk::Common::ConventionPayload::Deserialize(raw_payload);
+        resolved_inputs.reserve(payload.inputs.size());
+        for (const auto &pair : payload.inputs) {
+          resolve(pair.first, pair.second);
+        }
+        outputs = std::move(payload.outputs);
       }
 
       return manager.UseLibrary(lib, rawOptions.application_namespace(), rawOptions.application_service())
           .UseSession(taskHandler.getSessionId())
-          .Execute(taskHandler, method_name, resolved_inputs, payload.outputs);
+          .Execute(taskHandler, method_name, resolved_inputs, outputs);
     }
 
     // Legacy path: use application_name / application_version based loading
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-    auto legacyPayload = ArmoniK::Sdk::Common::TaskPayload::Deserialize(taskHandler.getPayload());
-#pragma GCC diagnostic pop
+    // The view points into the task handler's payload, which outlives the call
+    const auto legacyPayload = ArmoniK::Sdk::Common::TaskPayloadView::Parse(taskHandler.getPayload());
     AppId appId{rawOptions.application_name(), rawOptions.application_version()};
     ServiceId serviceId(appId, rawOptions.application_namespace(), rawOptions.application_service());
     return manager.UseApplication(appId)
         .UseService(serviceId)
         .UseSession(taskHandler.getSessionId())
-        .Execute(taskHandler, legacyPayload.method_name, legacyPayload.arguments);
+        .Execute(taskHandler, std::string(legacyPayload.method_name), legacyPayload.arguments);
   } catch (const ArmoniK::Sdk::Common::ArmoniKSdkException &e) {
     return armonik::api::worker::ProcessStatus(e.what());
   }
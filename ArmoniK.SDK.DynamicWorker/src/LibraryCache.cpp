@@ -0,0 +1,163 @@
+#include "LibraryCache.h"
+#include <algorithm>
+#include <armonik/sdk/common/ArmoniKSdkException.h>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/stat.h>
+#include <tuple>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace ArmoniK {
+namespace Sdk {
+namespace DynamicWorker {
+
+namespace {
+constexpr char LibraryPrefix[] = "armonik-lib-";
+constexpr char LibrarySuffix[] = ".so";
+constexpr char TemporarySuffix[] = ".tmp";
+
+/**
+ * @brief Libraries used more recently than this number of seconds are never evicted
+ */
+constexpr std::time_t EvictionGracePeriod = 60;
+
+/**
+ * @brief Counter used to name the temporary files, shared by all the caches of the process
+ */
+std::atomic<std::uint64_t> tmp_counter{0};
+
+/**
+ * @brief Computes the 64 bits FNV-1a hash of the content, as an hexadecimal string
+ */
+std::string ContentHash(absl::string_view content) {
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (auto c : content) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  char hex[17];
+  std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+  return hex;
+}
+
+bool EndsWith(const std::string &str, absl::string_view suffix) {
+  return str.size() >= suffix.size() && absl::string_view(str).substr(str.size() - suffix.size()) == suffix;
+}
+} // namespace
+
+LibraryCache::LibraryCache(std::string directory, std::uintmax_t max_size)
+    : directory(std::move(directory)), max_size(max_size) {
+  // Cleans up what a previous worker may have left behind, the temporary files of a crash included
+  std::lock_guard<std::mutex> _(mutex);
+  Evict("");
+}
+
+std::string LibraryCache::Get(const std::string &blob_id, absl::string_view content) {
+  std::lock_guard<std::mutex> _(mutex);
+  struct stat st {};
+
+  auto known = paths.find(blob_id);
+  if (known != paths.end()) {
+    // Blobs are immutable: the path is still valid as long as no process has evicted it
+    if (::stat(known->second.c_str(), &st) == 0) {
+      ::utimensat(AT_FDCWD, known->second.c_str(), nullptr, 0);
+      return known->second;
+    }
+    paths.erase(known);
+  }
+
+  auto path = directory + "/" + LibraryPrefix + blob_id + "-" + ContentHash(content) + LibrarySuffix;
+  if (::stat(path.c_str(), &st) == 0 && static_cast<std::uintmax_t>(st.st_size) == content.size()) {
+    // Already written by this or another worker process
+    ::utimensat(AT_FDCWD, path.c_str(), nullptr, 0);
+    paths[blob_id] = path;
+    return path;
+  }
+
+  // The temporary name is unique among the processes sharing the directory, the rename makes the library visible
+  // only once complete
+  const auto tmp_path = path + "." + std::to_string(getpid()) + "." + std::to_string(tmp_counter++) + ".tmp";
+  {
+    std::ofstream tmp(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!tmp) {
+      throw ArmoniK::Sdk::Common::ArmoniKSdkException("Failed to write library to temp file: " + tmp_path);
+    }
+    tmp.write(content.data(), static_cast<std::streamsize>(content.size()));
+    if (!tmp.flush()) {
+      std::remove(tmp_path.c_str());
+      throw ArmoniK::Sdk::Common::ArmoniKSdkException("Failed to write library to temp file: " + tmp_path);
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    throw ArmoniK::Sdk::Common::ArmoniKSdkException("Failed to move library to " + path + ": " +
+                                                    std::strerror(errno));
+  }
+  paths[blob_id] = path;
+
+  Evict(path);
+  return path;
+}
+
+void LibraryCache::Evict(const std::string &keep) {
+  DIR *dir = ::opendir(directory.c_str());
+  if (dir == nullptr) {
+    return;
+  }
+  const auto recent = std::time(nullptr) - EvictionGracePeriod;
+  // (modification time, size, path) of the cached libraries
+  std::vector<std::tuple<std::time_t, std::uintmax_t, std::string>> libraries;
+  std::uintmax_t total = 0;
+  while (auto entry = ::readdir(dir)) {
+    std::string name = entry->d_name;
+    if (name.compare(0, sizeof(LibraryPrefix) - 1, LibraryPrefix) != 0) {
+      continue;
+    }
+    const bool temporary = EndsWith(name, TemporarySuffix);
+    if (!temporary && !EndsWith(name, LibrarySuffix)) {
+      continue;
+    }
+    auto path = directory + "/" + name;
+    struct stat st {};
+    if (::stat(path.c_str(), &st) != 0) {
+      continue;
+    }
+    if (temporary) {
+      // A temporary file not modified for a while was left by a process that failed while writing it
+      if (st.st_mtime < recent) {
+        std::remove(path.c_str());
+      }
+      continue;
+    }
+    total += st.st_size;
+    libraries.emplace_back(st.st_mtime, st.st_size, std::move(path));
+  }
+  ::closedir(dir);
+
+  if (max_size == 0 || total <= max_size) {
+    return;
+  }
+  std::sort(libraries.begin(), libraries.end());
+  for (const auto &library : libraries) {
+    if (total <= max_size || std::get<0>(library) >= recent) {
+      break;
+    }
+    const auto &path = std::get<2>(library);
+    // Unlinking a library does not affect the processes that have already loaded it
+    if (path != keep && std::remove(path.c_str()) == 0) {
+      total -= std::get<1>(library);
+    }
+  }
+}
+
+} // namespace DynamicWorker
+} // namespace Sdk
+} // namespace ArmoniK
@@ -0,0 +1,33 @@
+#include "LibraryRegistry.h"
+
+namespace ArmoniK {
+namespace Sdk {
+namespace DynamicWorker {
+
+std::shared_ptr<DynamicLib> LibraryRegistry::Load(const std::string &path) {
+  std::lock_guard<std::mutex> _(mutex);
+  auto &entry = libraries[path];
+  auto library = entry.lock();
+  if (!library) {
+    library = std::make_shared<DynamicLib>(path.c_str());
+    entry = library;
+  }
+  return library;
+}
+
+std::shared_ptr<void> LibraryRegistry::SharedService(const DynamicLib *library, const std::string &service_namespace,
+                                                     const std::string &service_name,
+                                                     const std::function<std::shared_ptr<void>()> &create) {
+  std::lock_guard<std::mutex> _(mutex);
+  auto &entry = services[std::make_tuple(library, service_namespace, service_name)];
+  auto service = entry.lock();
+  if (!service) {
+    service = create();
+    entry = service;
+  }
+  return service;
+}
+
+} // namespace DynamicWorker
+} // namespace Sdk
+} // namespace ArmoniK
@@ -2,6 +2,7 @@
 #include "ContextIds.h"
 #include <armonik/sdk/common/ArmoniKSdkException.h>
 #include <armonik/worker/Worker/ProcessStatus.h>
+#include <algorithm>
 #include <stdexcept>
 #include <utility>
 
@@ -19,31 +20,47 @@ struct ArmonikContext {
 };
 } // namespace
 
-ServiceManager::ServiceManager(ArmoniKFunctionPointers functionsPointers, ServiceId serviceId)
-    : serviceId(std::move(serviceId)), functionPointers(functionsPointers) {
+ServiceManager::ServiceManager(ArmoniKFunctionPointers functionsPointers, ServiceId serviceId,
+                               std::size_t max_sessions)
+    : serviceId(std::move(serviceId)), max_sessions(std::max<std::size_t>(max_sessions, 1)),
+      functionPointers(functionsPointers) {
   service_context = this->functionPointers.create_service(this->serviceId.service_namespace.c_str(),
                                                           this->serviceId.service_name.c_str());
+  auto destroy_service = this->functionPointers.destroy_service;
+  service = std::shared_ptr<void>(service_context, [destroy_service](void *context) { destroy_service(context); });
+}
+ServiceManager::ServiceManager(ArmoniKFunctionPointers functionsPointers, ServiceId serviceId,
+                               std::shared_ptr<void> service, std::size_t max_sessions)
+    : serviceId(std::move(serviceId)), max_sessions(std::max<std::size_t>(max_sessions, 1)),
+      service(std::move(service)), functionPointers(functionsPointers) {
+  service_context = this->service.get();
 }
 ServiceManager::~ServiceManager() { clear(); }
 ServiceManager &ServiceManager::UseSession(const std::string &sessionId) & {
-  if (sessionId != current_session) {
-    if (!current_session.empty()) {
-      functionPointers.leave_session(service_context, session_context);
+  if (!sessions.empty() && sessions.front().first == sessionId) {
+    return *this;
+  }
+  for (auto it = sessions.begin(); it != sessions.end(); ++it) {
+    if (it->first == sessionId) {
+      sessions.splice(sessions.begin(), sessions, it);
+      return *this;
     }
-    current_session = sessionId;
-    session_context = functionPointers.enter_session(service_context, sessionId.c_str());
   }
+  if (sessions.size() >= max_sessions) {
+    functionPointers.leave_session(service_context, sessions.back().second);
+    sessions.pop_back();
+  }
+  sessions.emplace_front(sessionId, functionPointers.enter_session(service_context, sessionId.c_str()));
   return *this;
 }
-armonik::api::worker::ProcessStatus ServiceManager::Execute(armonik::api::worker::TaskHandler &taskHandler,
-                                                            const std::string &method_name,
-                                                            const std::string &method_arguments) {
+template <class Call>
+armonik::api::worker::ProcessStatus ServiceManager::Invoke(armonik::api::worker::TaskHandler &taskHandler,
+                                                           Call &&call) {
   ArmonikContext callContext(taskHandler);
-  if (current_session.empty()) {
+  if (sessions.empty()) {
     throw ArmoniK::Sdk::Common::ArmoniKSdkException("Session is not initialized");
   }
-  auto status = functionPointers.call(&callContext, service_context, session_context, method_name.c_str(),
-                                      method_arguments.data(), method_arguments.size(), ServiceManager::UploadResult);
+  auto status = call(&callContext);
   if (callContext.retry_requested) {
     throw std::runtime_error(callContext.retry_message);
   }
@@ -57,6 +74,29 @@ armonik::api::worker::ProcessStatus ServiceManager::Execute(armonik::api::worker
   return callContext.output;
 }
 
+armonik::api::worker::ProcessStatus ServiceManager::Execute(armonik::api::worker::TaskHandler &taskHandler,
+                                                            const std::string &method_name,
+                                                            absl::string_view method_arguments) {
+  return Invoke(taskHandler, [&](void *callContext) {
+    return functionPointers.call(callContext, service_context, sessions.front().second, method_name.c_str(),
+                                 method_arguments.data(), method_arguments.size(), ServiceManager::UploadResult);
+  });
+}
+
+armonik::api::worker::ProcessStatus ServiceManager::Execute(armonik::api::worker::TaskHandler &taskHandler,
+                                                            const std::string &method_name,
+                                                            const std::vector<armonik_input_t> &inputs,
+                                                            const std::vector<armonik_input_t> &outputs) {
+  if (!supports_input_views()) {
+    throw ArmoniK::Sdk::Common::ArmoniKSdkException("Library does not export armonik_call_inputs");
+  }
+  return Invoke(taskHandler, [&](void *callContext) {
+    return functionPointers.call_inputs(callContext, service_context, sessions.front().second, method_name.c_str(),
+                                        inputs.data(), inputs.size(), outputs.data(), outputs.size(),
+                                        ServiceManager::UploadResult);
+  });
+}
+
 void ServiceManager::UploadResult(void *opaque_context, armonik_status_t status, const char *data, size_t data_size) {
   auto context = static_cast<ArmonikContext *>(opaque_context);
   if (status == ARMONIK_STATUS_RETRY) {
@@ -76,11 +116,13 @@ void ServiceManager::clear() {
   if (serviceId.empty()) {
     return;
   }
-  if (!current_session.empty()) {
-    functionPointers.leave_session(service_context, session_context);
-    current_session.clear();
+  for (auto &&session : sessions) {
+    functionPointers.leave_session(service_context, session.second);
   }
-  functionPointers.destroy_service(service_context);
+  sessions.clear();
+  // Destroys the service context if no other manager shares it
+  service.reset();
+  service_context = nullptr;
   serviceId.clear();
 }
 } // namespace DynamicWorker
@@ -128,6 +128,71 @@ armonik_status_t armonik_call(void *armonik_context, void *service_context, void
 typedef armonik_status_t (*armonik_call_t)(void *armonik_context, void *service_context, void *session_context,
                                            const char *function_name, const char *input, size_t input_size,
                                            armonik_callback_t callback);
+/**
+ * @brief Named input or output of a method, viewing memory owned by the caller
+ * @note The memory pointed to is only valid during the call
+ */
+typedef struct armonik_input_t {
+  /**
+   * @brief Null terminated name of the input or output
+   */
+  const char *name;
+  /**
+   * @brief Content of the input, or id of the output, not null terminated
+   */
+  const char *data;
+  /**
+   * @brief Size of the content
+   */
+  size_t data_size;
+} armonik_input_t;
+
+/**
+ * @brief Function called when requesting the execution of a method with named inputs (convention mode)
+ * @param armonik_context Opaque ArmoniK context, should be passed to the callback as-is without modification
+ * @param service_context User defined service context
+ * @param session_context User defined session context
+ * @param function_name Name of the function to call
+ * @param inputs Array of named inputs, pointing directly to the data downloaded by ArmoniK
+ * @param input_count Number of inputs
+ * @param outputs Array of named outputs, whose content is the id of the result expected for the output
+ * @param output_count Number of outputs
+ * @param callback Callback provided by ArmoniK to send the result of the execution or details on a failure
+ * @return Status of the call. See /ref armonik_status_t for more details
+ * @note This function is optional. If the library does not export it, the inputs and outputs are serialized and
+ * armonik_call is used instead.
+ * @note When using the ArmoniK.SDK.Worker library, this function is already implemented and calls the
+ * ServiceBase::call() overload taking input views. If the library provides its own armonik_call, it serializes the
+ * inputs and outputs and forwards them to armonik_call instead.
+ */
+armonik_status_t armonik_call_inputs(void *armonik_context, void *service_context, void *session_context,
+                                     const char *function_name, const armonik_input_t *inputs, size_t input_count,
+                                     const armonik_input_t *outputs, size_t output_count, armonik_callback_t callback);
+
+/**
+ * @brief armonik_call_inputs function typedef
+ */
+typedef armonik_status_t (*armonik_call_inputs_t)(void *armonik_context, void *service_context, void *session_context,
+                                                  const char *function_name, const armonik_input_t *inputs,
+                                                  size_t input_count, const armonik_input_t *outputs,
+                                                  size_t output_count, armonik_callback_t callback);
+
+/**
+ * @brief Optional function telling whether the services of the library are thread safe
+ * @return Non-zero if a service context can be shared between concurrent calls
+ * @note When the DynamicWorker runs several tasks concurrently (Worker__Parallelism > 1) and this function returns
+ * non-zero, a single service context is created per service and shared by all concurrent executions. The functions
+ * armonik_enter_session, armonik_leave_session, armonik_call and armonik_call_inputs may then be called concurrently
+ * on the same service context, each execution keeping its own session context. When this function is not exported
+ * or returns zero, every concurrent execution creates its own service context.
+ */
+int armonik_thread_safe(void);
+
+/**
+ * @brief armonik_thread_safe function typedef
+ */
+typedef int (*armonik_thread_safe_t)(void);
+
 #ifdef __cplusplus
 }
 #endif
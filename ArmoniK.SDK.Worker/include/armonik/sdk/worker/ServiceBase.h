@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <map>
 #include <string>
 
@@ -7,6 +8,38 @@ namespace ArmoniK {
 namespace Sdk {
 namespace Worker {
 
+/**
+ * @brief Read-only view of a method input, pointing to memory owned by ArmoniK
+ * @warning The view is only valid during the call
+ */
+struct InputView {
+  /**
+   * @brief Content of the input, not null terminated
+   */
+  const char *data = nullptr;
+  /**
+   * @brief Size of the content
+   */
+  std::size_t size = 0;
+
+  /**
+   * @brief Copies the content of the input
+   * @return Copy of the content
+   */
+  std::string str() const { return {data, size}; }
+};
+
+/**
+ * @brief Serializes named inputs and outputs as the convention JSON payload received by the raw payload overload of
+ * ServiceBase::call()
+ * @param name Name of the called method
+ * @param inputs Named input views
+ * @param outputs Named output blob IDs
+ * @return Convention JSON payload
+ */
+std::string serialize_convention_payload(const std::string &name, const std::map<std::string, InputView> &inputs,
+                                         const std::map<std::string, std::string> &outputs);
+
 /**
  * @brief Base class to implement a worker in ArmoniK
  * @note This class is useful for use with the ArmoniK.SDK.Worker library which uses the \link ArmoniKSDKInterface.h
@@ -42,6 +75,20 @@ public:
   virtual std::string call(void *session_ctx, const std::string &name,
                            const std::map<std::string, std::string> &inputs);
 
+  /**
+   * @brief Zero-copy convention-path entry point: called with views on the named inputs.
+   * Override this to access large inputs without copying them.
+   * The default implementation serializes the inputs and outputs as convention JSON and delegates to the raw payload
+   * overload, so services overriding one of the other overloads keep working unchanged.
+   * @param session_ctx User provided session context
+   * @param name Name of the called method
+   * @param inputs Named input views, only valid during the call
+   * @param outputs Named output blob IDs
+   * @return Result string stored as a blob
+   */
+  virtual std::string call(void *session_ctx, const std::string &name, const std::map<std::string, InputView> &inputs,
+                           const std::map<std::string, std::string> &outputs);
+
   /**
    * @brief Legacy entry point: called with the raw serialized payload.
    * Override this when using the legacy execution path (application_name / application_version).
@@ -2,6 +2,45 @@
 #include "armonik/sdk/common/ArmoniKSdkException.h"
 #include "armonik/sdk/worker/ServiceBase.h"
 #include <cstring>
+#include <map>
+
+namespace {
+/**
+ * @brief Runs a call and forwards its error to the callback
+ * @param armonik_context Opaque ArmoniK context
+ * @param callback ArmoniK callback
+ * @param call Function making the call and returning its status
+ * @return Status of the call
+ */
+template <class Call> armonik_status_t report_errors(void *armonik_context, armonik_callback_t callback, Call &&call) {
+  try {
+    return call();
+  } catch (const ArmoniK::Sdk::Common::ArmoniKSdkException &e) {
+    auto msg = e.what();
+    callback(armonik_context, ARMONIK_STATUS_ERROR, msg, std::strlen(msg));
+    return ARMONIK_STATUS_ERROR;
+  } catch (const std::exception &e) {
+    auto msg = e.what();
+    callback(armonik_context, ARMONIK_STATUS_RETRY, msg, std::strlen(msg));
+    return ARMONIK_STATUS_RETRY;
+  }
+}
+
+/**
+ * @brief Calls the service and forwards its output or error to the callback
+ * @param armonik_context Opaque ArmoniK context
+ * @param callback ArmoniK callback
+ * @param call Function calling the service and returning its output
+ * @return Status of the call
+ */
+template <class Call> armonik_status_t invoke_service(void *armonik_context, armonik_callback_t callback, Call &&call) {
+  return report_errors(armonik_context, callback, [&]() {
+    auto output = call();
+    callback(armonik_context, ARMONIK_STATUS_OK, output.data(), output.size());
+    return ARMONIK_STATUS_OK;
+  });
+}
+} // namespace
 
 extern "C" {
 
@@ -42,20 +81,10 @@ __attribute__((weak, alias("armonik_leave_session_default")))
 armonik_status_t armonik_call_default(void *armonik_context, void *service_context, void *session_context,
                                       const char *function_name, const char *input, size_t input_size,
                                       armonik_callback_t callback) {
-  try {
-    auto output = static_cast<ArmoniK::Sdk::Worker::ServiceBase *>(service_context)
-                      ->call(session_context, std::string(function_name), std::string(input, input_size));
-    callback(armonik_context, ARMONIK_STATUS_OK, output.data(), output.size());
-    return ARMONIK_STATUS_OK;
-  } catch (const ArmoniK::Sdk::Common::ArmoniKSdkException &e) {
-    auto msg = e.what();
-    callback(armonik_context, ARMONIK_STATUS_ERROR, msg, std::strlen(msg));
-    return ARMONIK_STATUS_ERROR;
-  } catch (const std::exception &e) {
-    auto msg = e.what();
-    callback(armonik_context, ARMONIK_STATUS_RETRY, msg, std::strlen(msg));
-    return ARMONIK_STATUS_RETRY;
-  }
+  return invoke_service(armonik_context, callback, [&]() {
+    return static_cast<ArmoniK::Sdk::Worker::ServiceBase *>(service_context)
+        ->call(session_context, std::string(function_name), std::string(input, input_size));
+  });
 }
 
 #ifdef __linux__
@@ -64,4 +93,44 @@ __attribute__((weak, alias("armonik_call_default")))
 armonik_status_t
 armonik_call(void *armonik_context, void *service_context, void *session_context, const char *function_name,
              const char *input, size_t input_size, armonik_callback_t callback);
+
+/**
+ * \inherit armonik_call_inputs
+ */
+armonik_status_t armonik_call_inputs_default(void *armonik_context, void *service_context, void *session_context,
+                                             const char *function_name, const armonik_input_t *inputs,
+                                             size_t input_count, const armonik_input_t *outputs, size_t output_count,
+                                             armonik_callback_t callback) {
+  return report_errors(armonik_context, callback, [&]() {
+    std::map<std::string, ArmoniK::Sdk::Worker::InputView> views;
+    for (size_t i = 0; i < input_count; ++i) {
+      views[inputs[i].name] = {inputs[i].data, inputs[i].data_size};
+    }
+    std::map<std::string, std::string> output_ids;
+    for (size_t i = 0; i < output_count; ++i) {
+      output_ids[outputs[i].name] = std::string(outputs[i].data, outputs[i].data_size);
+    }
+
+    if (armonik_call != armonik_call_default) {
+      // The library provides its own armonik_call, whose services may not derive from ServiceBase: it receives the
+      // payload it would have received if this function were not exported
+      const auto payload = ArmoniK::Sdk::Worker::serialize_convention_payload(function_name, views, output_ids);
+      return armonik_call(armonik_context, service_context, session_context, function_name, payload.data(),
+                          payload.size(), callback);
+    }
+
+    auto output = static_cast<ArmoniK::Sdk::Worker::ServiceBase *>(service_context)
+                      ->call(session_context, std::string(function_name), views, output_ids);
+    callback(armonik_context, ARMONIK_STATUS_OK, output.data(), output.size());
+    return ARMONIK_STATUS_OK;
+  });
+}
+
+#ifdef __linux__
+__attribute__((weak, alias("armonik_call_inputs_default")))
+#endif
+armonik_status_t
+armonik_call_inputs(void *armonik_context, void *service_context, void *session_context, const char *function_name,
+                    const armonik_input_t *inputs, size_t input_count, const armonik_input_t *outputs,
+                    size_t output_count, armonik_callback_t callback);
 }
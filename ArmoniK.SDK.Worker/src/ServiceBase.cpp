@@ -15,6 +15,24 @@ std::string ServiceBase::call(void *session_ctx, const std::string &name, const
   }
 }
 
+std::string serialize_convention_payload(const std::string &name, const std::map<std::string, InputView> &inputs,
+                                         const std::map<std::string, std::string> &outputs) {
+  nlohmann::json payload;
+  payload["method"] = name;
+  auto &json_inputs = payload["inputs"] = nlohmann::json::object();
+  for (auto &&input : inputs) {
+    json_inputs[input.first] = input.second.str();
+  }
+  payload["outputs"] = outputs;
+  return payload.dump();
+}
+
+std::string ServiceBase::call(void *session_ctx, const std::string &name,
+                              const std::map<std::string, InputView> &inputs,
+                              const std::map<std::string, std::string> &outputs) {
+  return call(session_ctx, name, serialize_convention_payload(name, inputs, outputs));
+}
+
 std::string ServiceBase::call(void *session_ctx, const std::string &name,
                               const std::map<std::string, std::string> &inputs) {
   (void)session_ctx;